@@ -14,6 +14,7 @@
 
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -35,7 +36,10 @@ AliExternalBDT::AliExternalBDT(std::string name) :
   fModelPath{""},
   fModelName{""},
   fCompiler{},
-  fPredictor{}
+  fPredictor{},
+  fNThreads{1},
+  fBatchFeatures{},
+  fBatchScores{}
 {
 }
 
@@ -119,7 +123,7 @@ bool AliExternalBDT::LoadLightGBMModel(std::string path) {
 }
 
 bool AliExternalBDT::LoadModelLibrary(std::string path) {
-  const int status = TreelitePredictorLoad(path.data(), 1, 1, &fPredictor);
+  const int status = TreelitePredictorLoad(path.data(), fNThreads, 1, &fPredictor);
   if (status != 0) {
     std::cerr << "Library loading failed" << std::endl;
     return false;
@@ -141,3 +145,38 @@ double AliExternalBDT::Predict(double *features, int size, bool useRawScore) {
       &out_size);
   return output;
 }
+
+bool AliExternalBDT::Predict(const double *features, int nCandidates, int nFeatures,
+    std::vector<double> &scores, bool useRawScore) {
+  // features: row-major matrix nCandidates x nFeatures. All the candidates are
+  // scored with a single call to the predictor, which splits the batch among
+  // its worker threads (see SetNumberOfThreads, to be called before loading)
+  scores.resize(nCandidates);
+  if (nCandidates <= 0) return true;
+  const size_t nValues = static_cast<size_t>(nCandidates) * nFeatures;
+  fBatchFeatures.resize(nValues);
+  for (size_t iValue = 0; iValue < nValues; ++iValue) {
+    fBatchFeatures[iValue] = static_cast<float>(features[iValue]);
+  }
+  DenseBatchHandle batch;
+  if (TreeliteAssembleDenseBatch(fBatchFeatures.data(), std::numeric_limits<float>::quiet_NaN(),
+        nCandidates, nFeatures, &batch) != 0) {
+    std::cerr << "Batch creation failed" << std::endl;
+    return false;
+  }
+  size_t out_size{0u};
+  TreelitePredictorQueryResultSize(fPredictor, batch, 0, &out_size);
+  assert(out_size == static_cast<size_t>(nCandidates));
+  fBatchScores.resize(out_size);
+  const int status = TreelitePredictorPredictBatch(fPredictor, batch, 0, 0,
+      static_cast<int>(useRawScore), fBatchScores.data(), &out_size);
+  TreeliteDeleteDenseBatch(batch);
+  if (status != 0) {
+    std::cerr << "Batch prediction failed" << std::endl;
+    return false;
+  }
+  for (int iCand = 0; iCand < nCandidates; ++iCand) {
+    scores[iCand] = fBatchScores[iCand];
+  }
+  return true;
+}
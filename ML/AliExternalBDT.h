@@ -30,6 +30,11 @@ public:
   bool LoadXGBoostModel(std::string path);
 
   double Predict(double *features, int size, bool useRaw = false);
+  bool Predict(const double *features, int nCandidates, int nFeatures,
+               std::vector<double> &scores, bool useRaw = false);
+
+  void SetNumberOfThreads(int nThreads) { fNThreads = nThreads; }
+  int GetNumberOfThreads() const { return fNThreads; }
 
 private:
   bool CompileAndLoadModelLibrary();
@@ -43,6 +48,9 @@ private:
   std::string fModelName;
   CompilerHandle fCompiler;
   PredictorHandle fPredictor;
+  int fNThreads;                      /// Number of worker threads of the predictor (used for batches)
+  std::vector<float> fBatchFeatures;  /// Feature buffer for batch predictions
+  std::vector<float> fBatchScores;    /// Score buffer for batch predictions
 };
 
 #endif
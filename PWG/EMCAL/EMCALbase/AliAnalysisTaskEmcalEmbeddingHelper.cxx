@@ -26,6 +26,7 @@
 #include <TMath.h>
 #include <TRandom.h>
 #include <TChain.h>
+#include <TTreeCache.h>
 #include <TGrid.h>
 #include <TGridResult.h>
 #include <TSystem.h>
@@ -169,7 +170,11 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fReadAhead(false),
+  fReadAheadCacheSize(50),
+  fNextFileOpenHandle(nullptr),
+  fNextXSecFileOpenHandle(nullptr)
 {
   if (fgInstance != nullptr) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -243,7 +248,11 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fPythiaCrossSectionFromFile(0.),
   fPythiaPtHard(0.),
   fPrintTimingInfoToLog(false),
-  fTimer()
+  fTimer(),
+  fReadAhead(false),
+  fReadAheadCacheSize(50),
+  fNextFileOpenHandle(nullptr),
+  fNextXSecFileOpenHandle(nullptr)
 {
   if (fgInstance != 0) {
     AliError("An instance of AliAnalysisTaskEmcalEmbeddingHelper already exists: it will be deleted!!!");
@@ -328,6 +337,8 @@ void AliAnalysisTaskEmcalEmbeddingHelper::RetrieveTaskPropertiesFromYAMLConfig()
   res = fYAMLConfig.GetProperty("randomFileAccess", fRandomFileAccess, false);
   res = fYAMLConfig.GetProperty("createHisto", fCreateHisto, false);
   res = fYAMLConfig.GetProperty("printTimingInfoInLog", fPrintTimingInfoToLog, false);
+  res = fYAMLConfig.GetProperty("readAhead", fReadAhead, false);
+  res = fYAMLConfig.GetProperty("readAheadCacheSize", fReadAheadCacheSize, false);
   // More general embedding helper properties
   res = fYAMLConfig.GetProperty("filePattern", fFilePattern, false);
   res = fYAMLConfig.GetProperty("inputFilename", fInputFilename, false);
@@ -1246,6 +1257,25 @@ void AliAnalysisTaskEmcalEmbeddingHelper::UserCreateOutputObjects()
     fHistManager.CreateTH1(histName, histTitle, 200, 0, 2000);
   }
 
+  // Read-ahead of the embedded input
+  if (fReadAhead) {
+    // A file which is not yet open when it is needed means that the embedding had to wait for it
+    histName = "fHistReadAheadFileStatus";
+    histTitle = "Status of the asynchronous open of the next file when it is needed";
+    binLabels = {"ready", "notReady", "failed", "notAsync"};
+    auto histReadAheadFileStatus = fHistManager.CreateTH1(histName, histTitle, binLabels.size(), 0, binLabels.size());
+    // Set label names
+    for (unsigned int i = 1; i <= binLabels.size(); i++) {
+      histReadAheadFileStatus->GetXaxis()->SetBinLabel(i, binLabels.at(i-1).c_str());
+    }
+    histReadAheadFileStatus->GetYaxis()->SetTitle("Number of files");
+
+    // Reads which were not served by the prefetched baskets had to wait for the input
+    histName = "fHistReadAheadCacheEfficiency";
+    histTitle = "Fraction of reads served by the read-ahead cache per file";
+    fHistManager.CreateTH1(histName, histTitle, 50, 0, 1);
+  }
+
   // Add all histograms to output list
   TIter next(fHistManager.GetListOfHistograms());
   TObject* obj = 0;
@@ -1319,6 +1349,12 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
   // Keep track of the total number of files in the TChain to ensure that we don't start repeating within the chain
   fMaxNumberOfFiles = fChain->GetListOfFiles()->GetEntries();
 
+  // Prefetch and unzip the baskets of the upcoming entries in the background
+  if (fReadAhead) {
+    fChain->SetCacheSize(static_cast<Long64_t>(fReadAheadCacheSize) * 1024 * 1024);
+    fChain->SetParallelUnzip(kTRUE);
+  }
+
   if (fFilenames.size() > fMaxNumberOfFiles) {
     AliErrorStream() << "Number of input files (" << fFilenames.size() << ") is larger than the number of available files (" << fMaxNumberOfFiles << "). Something went wrong when adding some of those files to the TChain!\n";
   }
@@ -1440,6 +1476,9 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   // (it is inaccessible otherwise).
   // Since fUpperEntry is the total number of entries, loading it will retrieve the
   // next tree (in the next file) since entries are indexed starting from 0.
+  if (fReadAhead) {
+    RecordReadAheadOfCurrentFile();
+  }
   fChain->GetEntry(fUpperEntry);
 
   // Determine tree size and current entry
@@ -1494,6 +1533,11 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   //       invalid filenames may be included in the fFilenames count!
   //AliDebug(2, TString::Format("Will start embedding file %i as the %ith file beginning from entry %i.", (fFilenameIndex + fFileNumber) % fMaxNumberOfFiles, fFileNumber, fCurrentEntry));
 
+  // Start opening the next file while this one is embedded
+  if (fReadAhead) {
+    RequestReadAheadOfNextFile();
+  }
+
   // (re)set whether we have wrapped the tree
   fWrappedAroundTree = false;
 
@@ -1510,6 +1554,81 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
 
 }
 
+/**
+ * Request the asynchronous open of the file following the current file in the chain, as well as of
+ * its pythia cross section file. When the file is later opened by the TChain (or in
+ * PythiaInfoFromCrossSectionFile()), TFile::Open() picks up the pending request instead of opening
+ * the file again. The order of the files, and thus the random access and pt hard bin selection,
+ * is not changed.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::RequestReadAheadOfNextFile()
+{
+  // fFileNumber corresponds to the index of the current file in the chain
+  UInt_t nextFileNumber = fFileNumber + 1;
+  if (nextFileNumber < fMaxNumberOfFiles) {
+    const char * nextFilename = fChain->GetListOfFiles()->At(nextFileNumber)->GetTitle();
+    AliDebugStream(3) << "Requesting asynchronous open of the next file \"" << nextFilename << "\".\n";
+    fNextFileOpenHandle = TFile::AsyncOpen(nextFilename);
+  }
+  if (nextFileNumber < fPythiaCrossSectionFilenames.size()) {
+    fNextXSecFileOpenHandle = TFile::AsyncOpen(fPythiaCrossSectionFilenames.at(nextFileNumber).c_str());
+  }
+}
+
+/**
+ * Record how well the read-ahead performed for the file that is about to be left: the efficiency of the
+ * tree cache, and whether the asynchronous open of the next file has already finished. Must be called
+ * before the next file is loaded, as the pending open requests are consumed when the file is opened.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::RecordReadAheadOfCurrentFile()
+{
+  if (fCreateHisto && fUpperEntry > 0) {
+    TFile * currentFile = fChain->GetCurrentFile();
+    TTreeCache * cache = currentFile ? dynamic_cast<TTreeCache *>(currentFile->GetCacheRead(fChain->GetTree())) : nullptr;
+    if (cache) {
+      fHistManager.FillTH1("fHistReadAheadCacheEfficiency", cache->GetEfficiency());
+    }
+  }
+
+  RecordAsyncOpenStatus(fNextFileOpenHandle);
+  RecordAsyncOpenStatus(fNextXSecFileOpenHandle);
+}
+
+/**
+ * Record the status of a pending asynchronous open request and release it. A request which failed is consumed
+ * here so that the file is opened again synchronously when it is needed.
+ *
+ * @param[in,out] handle Pending asynchronous open request. Set to nullptr afterwards.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::RecordAsyncOpenStatus(TFileOpenHandle *& handle)
+{
+  if (!handle) {
+    return;
+  }
+
+  std::string status = "notAsync";
+  switch (TFile::GetAsyncOpenStatus(handle)) {
+    case TFile::kAOSSuccess:
+      status = "ready";
+      break;
+    case TFile::kAOSInProgress:
+      status = "notReady";
+      break;
+    case TFile::kAOSFailure:
+      status = "failed";
+      AliWarningStream() << "Asynchronous open of the next file failed. It will be opened again when it is needed.\n";
+      delete TFile::Open(handle);
+      break;
+    default:
+      break;
+  }
+  if (fCreateHisto) {
+    fHistManager.FillTH1("fHistReadAheadFileStatus", status.c_str());
+  }
+
+  handle = nullptr;
+}
+
 /**
  * Extract pythia information from a cross section file. Modified from AliAnalysisTaskEmcal::PythiaInfoFromFile().
  *
@@ -1889,6 +2008,10 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "File list filename: \"" << fFileListFilename << "\"\n";
   tempSS << "Tree name: " << fTreeName << "\n";
   tempSS << "Print timing info to log: " << fPrintTimingInfoToLog << "\n";
+  tempSS << "Read ahead: " << fReadAhead << "\n";
+  if (fReadAhead) {
+    tempSS << "Read-ahead cache size: " << fReadAheadCacheSize << " MB\n";
+  }
   tempSS << "Random event number access: " << fRandomEventNumberAccess << "\n";
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
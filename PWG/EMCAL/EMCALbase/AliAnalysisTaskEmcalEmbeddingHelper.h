@@ -19,6 +19,7 @@
 class TString;
 class TChain;
 class TFile;
+class TFileOpenHandle;
 class AliVEvent;
 class AliVHeader;
 class AliGenPythiaEventHeader;
@@ -116,6 +117,8 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Int_t GetStartingFileIndex()                              const { return fFilenameIndex; }
   TString GetFileListFilename()                             const { return fFileListFilename; }
   bool GetCreateHistos()                                    const { return fCreateHisto; }
+  bool GetReadAhead()                                       const { return fReadAhead; }
+  int GetReadAheadCacheSize()                               const { return fReadAheadCacheSize; }
 
   // Set
   /// Set the pt hard bin which will be added into the file pattern. Can also be omitted and set directly in the pattern.
@@ -128,6 +131,14 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetAOD(const char * treeName = "aodTree")                  { fTreeName     = treeName; }
   /// Set whether to print and plot execution time of InitTree()
   void SetPrintTimingInfoToLog(bool b)                            { fPrintTimingInfoToLog = b;}
+  /**
+   * Enable read-ahead of the embedded input. The next file in the chain (and its pythia cross section file)
+   * is opened asynchronously while the current file is embedded, and the baskets of the upcoming entries are
+   * prefetched and unzipped in the background through a tree cache of the given size.
+   */
+  void SetReadAhead(bool b = true)                                { fReadAhead = b; }
+  /// Set the size of the read-ahead tree cache in MB
+  void SetReadAheadCacheSize(int sizeMB)                          { fReadAheadCacheSize = sizeMB; }
   /**
    * Enable to begin embedding at a random entry in each embedded file. Will then loop around in order
    * so that all entries are made available.
@@ -300,6 +311,10 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
+  // Read-ahead
+  void            RequestReadAheadOfNextFile();
+  void            RecordReadAheadOfCurrentFile();
+  void            RecordAsyncOpenStatus(TFileOpenHandle *& handle);
   // Validation helper
   void            ValidatePhysicsSelectionForInternalEventSelection();
   // Helper functions
@@ -375,6 +390,11 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   bool                                          fPrintTimingInfoToLog; ///< Flag to print time to execute InitTree(), for logging purposes
   TStopwatch                                    fTimer            ;    //!<! Timer for the InitTree() function
 
+  bool                                          fReadAhead        ; ///<  If true, open the next file asynchronously and prefetch entries through a tree cache
+  int                                           fReadAheadCacheSize; ///<  Size of the read-ahead tree cache (MB)
+  TFileOpenHandle                              *fNextFileOpenHandle; //!<! Pending asynchronous open of the next file in the chain
+  TFileOpenHandle                              *fNextXSecFileOpenHandle; //!<! Pending asynchronous open of the pythia cross section file of the next file
+
   static AliAnalysisTaskEmcalEmbeddingHelper   *fgInstance        ; //!<! Global instance of this class
 
  private:
@@ -382,7 +402,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 12);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 13);
   /// \endcond
 };
 #endif
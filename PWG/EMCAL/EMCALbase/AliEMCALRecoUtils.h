@@ -172,6 +172,7 @@ public:
   void     SwitchOnRecalibration()                       { fRecalibration = kTRUE  ; 
                                                            if(!fEMCALRecalibrationFactors)InitEMCALRecalibrationFactors() ; }
   void     SetUse1DRecalibration(Bool_t use)             { fUse1Drecalib = use; }
+  Bool_t   IsUse1DRecalibration()                  const { return fUse1Drecalib ; }
   void     InitEMCALRecalibrationFactors() ;
   void     InitEMCALRecalibrationFactors1D() ;
   TObjArray* GetEMCALRecalibrationFactorsArray()   const { return fEMCALRecalibrationFactors ; }
@@ -204,6 +205,7 @@ public:
   // Time Recalibration
   void     SetUseOneHistForAllBCs(Bool_t useOneHist)     { fDoUseMergedBC = useOneHist ; }
   void     SetConstantTimeShift(Float_t shift)           { fConstantTimeShift = shift  ; }
+  Float_t  GetConstantTimeShift()                  const { return fConstantTimeShift   ; }
 
   void     RecalibrateCellTime(Int_t absId, Int_t bc, Double_t & time,Bool_t isLGon = kFALSE) const;
   
@@ -298,6 +300,7 @@ public:
   void     SwitchOnBadChannelsRemoval ()                 { fRemoveBadChannels = kTRUE ; 
                                                            if(!fEMCALBadChannelMap)InitEMCALBadChannelStatusMap() ; }
   void     SetUse1DBadChannelMap(Bool_t use)             { fUse1Dmap = use;}
+  Bool_t   IsUse1DBadChannelMap()                  const { return fUse1Dmap ; }
   Bool_t   IsDistanceToBadChannelRecalculated()    const { return fRecalDistToBadChannels   ; }
   void     SwitchOffDistToBadChannelRecalculation()      { fRecalDistToBadChannels = kFALSE ; }
   void     SwitchOnDistToBadChannelRecalculation()       { fRecalDistToBadChannels = kTRUE  ; 
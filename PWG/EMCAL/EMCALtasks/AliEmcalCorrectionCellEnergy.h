@@ -32,6 +32,7 @@ class AliEmcalCorrectionCellEnergy : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+  Bool_t SupportsFusedCellPass() const { return kTRUE; }
   
 protected:
   TH1F* fCellEnergyDistBefore;        //!<! cell energy distribution, before energy calibration
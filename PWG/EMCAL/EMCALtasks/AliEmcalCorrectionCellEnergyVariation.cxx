@@ -90,6 +90,19 @@ Bool_t AliEmcalCorrectionCellEnergyVariation::Run()
 {
   AliEmcalCorrectionComponent::Run();
   
+  // Fused cell pass: scale the cell arrays, they are written back by the correction task
+  if (fFusedCells) {
+    if (!fEnergyScaleFunction) return kTRUE;
+    for (Int_t iCell = 0; iCell < fFusedCells->GetNumberOfCells(); iCell++) {
+      Double_t ecell = fFusedCells->fEnergy[iCell];
+      if (ecell > fMinCellE && ecell < fMaxCellE) {
+        ecell *= fEnergyScaleFunction->Eval(ecell);
+        if (ecell > 0.) fFusedCells->fEnergy[iCell] = ecell;
+      }
+    }
+    return kTRUE;
+  }
+  
   Short_t  absId  =-1;
   Double_t ecell = 0;
   Double_t tcell = 0;
@@ -30,6 +30,7 @@ class AliEmcalCorrectionCellEnergyVariation : public AliEmcalCorrectionComponent
   void UserCreateOutputObjects();
   void ExecOnce();
   Bool_t Run();
+  Bool_t SupportsFusedCellPass() const { return kTRUE; }
   
 protected:
   
@@ -8,6 +8,7 @@
 
 #include <AliAnalysisManager.h>
 #include <AliVEvent.h>
+#include <AliVCaloCells.h>
 #include <AliEMCALRecoUtils.h>
 #include <AliOADBContainer.h>
 #include "AliEmcalList.h"
@@ -52,7 +53,14 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent() :
   fRecoUtils(0),
   fOutput(0),
   fBasePath(""),
-  fCustomBadChannelFilePath("")
+  fCustomBadChannelFilePath(""),
+  fFusedCells(0),
+  fFlatCellAccepted(),
+  fFlatCellEnergyFactor(),
+  fFlatCellTimeFactor(),
+  fFlatCellSM(),
+  fFlatCellRun(-1),
+  fFlatCellSwitches(0)
 
 {
   fVertex[0] = 0;
@@ -88,7 +96,14 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
   fRecoUtils(0),
   fOutput(0),
   fBasePath(""),
-  fCustomBadChannelFilePath("")
+  fCustomBadChannelFilePath(""),
+  fFusedCells(0),
+  fFlatCellAccepted(),
+  fFlatCellEnergyFactor(),
+  fFlatCellTimeFactor(),
+  fFlatCellSM(),
+  fFlatCellRun(-1),
+  fFlatCellSwitches(0)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -222,9 +237,120 @@ void AliEmcalCorrectionComponent::UpdateCells()
     }
     //end of PAR run settings
 
-    fRecoUtils->RecalibrateCells(fCaloCells, bunchCrossNo);
+    if (fFusedCells)
+      RecalibrateFusedCells(bunchCrossNo);
+    else
+      fRecoUtils->RecalibrateCells(fCaloCells, bunchCrossNo);
   }
-  fCaloCells->Sort();
+  // In the fused cell pass the cells are sorted once they are written back
+  if (fFusedCells)
+    fFusedCells->fSort = kTRUE;
+  else
+    fCaloCells->Sort();
+}
+
+/**
+ * Fused cell pass version of AliEMCALRecoUtils::RecalibrateCells(): removes bad channels and
+ * recalibrates the energy and time of the cell arrays. The calibration is taken from flat
+ * arrays indexed by absId, built once per run, instead of looking up each cell in the cells
+ * object and in the calibration histograms. The result is the same, including the high gain
+ * flag being reset by AliVCaloCells::SetCell().
+ *
+ * @param bunchCrossNo Bunch crossing number of the event
+ */
+void AliEmcalCorrectionComponent::RecalibrateFusedCells(Int_t bunchCrossNo)
+{
+  if (!fRecoUtils->IsRecalibrationOn() && !fRecoUtils->IsTimeRecalibrationOn() && !fRecoUtils->IsBadChannelsRemovalSwitchedOn())
+    return;
+
+  UInt_t switches = fRecoUtils->IsRecalibrationOn() | fRecoUtils->IsTimeRecalibrationOn() << 1 |
+                    fRecoUtils->IsBadChannelsRemovalSwitchedOn() << 2 | fRecoUtils->IsLGOn() << 3;
+  if (fFlatCellRun != fRun || fFlatCellSwitches != switches)
+    BuildFlatCellCalibration(switches);
+
+  const Int_t nAbsIds = fFlatCellAccepted.size();
+  const Bool_t recalibrateEnergy = fRecoUtils->IsRecalibrationOn();
+  const Bool_t recalibrateTime = fRecoUtils->IsTimeRecalibrationOn() && bunchCrossNo >= 0;
+  const Bool_t recalibrateL1Phase = fRecoUtils->IsL1PhaseInTimeRecalibrationOn() && bunchCrossNo >= 0;
+  const Bool_t lowGain = fRecoUtils->IsLGOn();
+  const Float_t * timeFactors = recalibrateTime ? &fFlatCellTimeFactor[2 * (bunchCrossNo % 4) * nAbsIds] : 0;
+  const Double_t constantTimeShift = fRecoUtils->GetConstantTimeShift() * 1e-9;
+  const Short_t parNumber = fRecoUtils->GetCurrentParNumber();
+
+  for (Int_t iCell = 0; iCell < fFusedCells->GetNumberOfCells(); iCell++) {
+    Short_t absId = fFusedCells->fAbsId[iCell];
+    if (absId < 0 || absId >= nAbsIds || !fFlatCellAccepted[absId]) {
+      fFusedCells->fEnergy[iCell] = 0;
+      fFusedCells->fTime[iCell] = -1;
+      fFusedCells->fHighGain[iCell] = kFALSE;
+      continue;
+    }
+
+    Float_t amp = fFusedCells->fEnergy[iCell];
+    if (recalibrateEnergy)
+      amp *= fFlatCellEnergyFactor[absId];
+
+    Double_t time = fFusedCells->fTime[iCell];
+    time -= constantTimeShift;
+    if (recalibrateTime)
+      time -= timeFactors[(lowGain && !fFusedCells->fHighGain[iCell]) * nAbsIds + absId] * 1.e-9;
+    if (recalibrateL1Phase)
+      fRecoUtils->RecalibrateCellTimeL1Phase(fFlatCellSM[absId], bunchCrossNo, time, parNumber);
+
+    fFusedCells->fEnergy[iCell] = amp;
+    fFusedCells->fTime[iCell] = time;
+    fFusedCells->fHighGain[iCell] = kFALSE;
+  }
+}
+
+/**
+ * Flatten the bad channel map and the energy and time calibration of the reco utils into
+ * arrays indexed by absId. Called for each new run, or if the reco utils switches changed.
+ *
+ * @param switches Reco utils switches the calibration is built with
+ */
+void AliEmcalCorrectionComponent::BuildFlatCellCalibration(UInt_t switches)
+{
+  AliEMCALGeometry * geom = AliEMCALGeometry::GetInstance();
+  const Int_t nAbsIds = geom ? 24*48*geom->GetNumberOfSuperModules() : 0;
+  const Bool_t timeRecalibration = fRecoUtils->IsTimeRecalibrationOn();
+
+  fFlatCellAccepted.assign(nAbsIds, 0);
+  fFlatCellEnergyFactor.assign(nAbsIds, 1.);
+  fFlatCellSM.assign(nAbsIds, -1);
+  fFlatCellTimeFactor.assign(timeRecalibration ? 8 * nAbsIds : 0, 0.);
+
+  for (Int_t absId = 0; absId < nAbsIds; absId++) {
+    Int_t imod = -1, iphi =-1, ieta=-1,iTower = -1, iIphi = -1, iIeta = -1, status = 0;
+    if (!geom->GetCellIndex(absId,imod,iTower,iIphi,iIeta))
+      continue;
+    geom->GetCellPhiEtaIndexInSModule(imod,iTower,iIphi, iIeta,iphi,ieta);
+    fFlatCellSM[absId] = imod;
+
+    if (fRecoUtils->IsBadChannelsRemovalSwitchedOn()) {
+      Bool_t bad = fRecoUtils->IsUse1DBadChannelMap() ? fRecoUtils->GetEMCALChannelStatus1D(absId, status) :
+                                                        fRecoUtils->GetEMCALChannelStatus(imod, ieta, iphi, status);
+      if (bad)
+        continue;
+    }
+    fFlatCellAccepted[absId] = 1;
+
+    if (fRecoUtils->IsRecalibrationOn()) {
+      fFlatCellEnergyFactor[absId] = fRecoUtils->IsUse1DRecalibration() ? fRecoUtils->GetEMCALChannelRecalibrationFactor1D(absId) :
+                                                                          fRecoUtils->GetEMCALChannelRecalibrationFactor(imod, ieta, iphi);
+    }
+
+    if (timeRecalibration) {
+      for (Int_t bc = 0; bc < 4; bc++) {
+        Float_t highGainFactor = fRecoUtils->GetEMCALChannelTimeRecalibrationFactor(bc, absId, kFALSE);
+        fFlatCellTimeFactor[2 * bc * nAbsIds + absId] = highGainFactor;
+        fFlatCellTimeFactor[(2 * bc + 1) * nAbsIds + absId] = fRecoUtils->IsLGOn() ? fRecoUtils->GetEMCALChannelTimeRecalibrationFactor(bc, absId, kTRUE) : highGainFactor;
+      }
+    }
+  }
+
+  fFlatCellRun = fRun;
+  fFlatCellSwitches = switches;
 }
 
 /**
@@ -303,6 +429,15 @@ void AliEmcalCorrectionComponent::GetPass()
 void AliEmcalCorrectionComponent::FillCellQA(TH1F* h){
   TString name = h->GetName();
   
+  if (fFusedCells) {
+    const std::vector<Double_t> & values = name.Contains("Energy") ? fFusedCells->fEnergy : fFusedCells->fTime;
+    if (name.Contains("Energy") || name.Contains("Time")) {
+      for (Int_t iCell = 0; iCell < fFusedCells->GetNumberOfCells(); iCell++)
+        h->Fill(values[iCell]);
+    }
+    return;
+  }
+
   Short_t  absId  =-1;
   Double_t ecell = 0;
   Double_t tcell = 0;
@@ -427,3 +562,39 @@ Int_t AliEmcalCorrectionComponent::InitBadChannels()
   return 1;
 }
 
+/**
+ * Copy the cells into the arrays.
+ *
+ * @param cells Cells to copy
+ */
+void AliEmcalCorrectionCellArrays::Load(AliVCaloCells * cells)
+{
+  Int_t nCells = cells->GetNumberOfCells();
+  fAbsId.resize(nCells);
+  fEnergy.resize(nCells);
+  fTime.resize(nCells);
+  fMCLabel.resize(nCells);
+  fEFrac.resize(nCells);
+  fHighGain.resize(nCells);
+  fSort = kFALSE;
+
+  for (Int_t iCell = 0; iCell < nCells; iCell++) {
+    cells->GetCell(iCell, fAbsId[iCell], fEnergy[iCell], fTime[iCell], fMCLabel[iCell], fEFrac[iCell]);
+    fHighGain[iCell] = cells->GetHighGain(iCell);
+  }
+}
+
+/**
+ * Write the arrays back into the cells they were loaded from.
+ *
+ * @param cells Cells to update
+ */
+void AliEmcalCorrectionCellArrays::Store(AliVCaloCells * cells) const
+{
+  for (Int_t iCell = 0; iCell < GetNumberOfCells(); iCell++) {
+    cells->SetCell(iCell, fAbsId[iCell], fEnergy[iCell], fTime[iCell], fMCLabel[iCell], fEFrac[iCell], fHighGain[iCell]);
+  }
+
+  if (fSort)
+    cells->Sort();
+}
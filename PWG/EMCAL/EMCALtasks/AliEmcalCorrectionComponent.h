@@ -3,6 +3,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 class TH1F;
 #include <TNamed.h>
@@ -23,6 +24,29 @@ class AliVEvent;
 #include "AliClusterContainer.h"
 #include "AliEmcalCorrectionEventManager.h"
 
+/**
+ * @struct AliEmcalCorrectionCellArrays
+ * @ingroup EMCALCORRECTIONFW
+ * @brief Structure-of-arrays copy of the cells for the fused cell pass
+ *
+ * Entries follow the cell positions of the AliVCaloCells object they are loaded from.
+ * Consecutive cell components modify the arrays in place and the cells are written back
+ * once, see AliEmcalCorrectionTask::SetUseFusedCellPass().
+ */
+struct AliEmcalCorrectionCellArrays {
+  std::vector<Short_t>    fAbsId;                         ///< Cell absolute ID
+  std::vector<Double_t>   fEnergy;                        ///< Cell energy
+  std::vector<Double_t>   fTime;                          ///< Cell time
+  std::vector<Int_t>      fMCLabel;                       ///< Cell MC label
+  std::vector<Double_t>   fEFrac;                         ///< Cell embedded energy fraction
+  std::vector<Char_t>     fHighGain;                      ///< Cell high gain flag
+  Bool_t                  fSort;                          ///< Sort the cells after writing them back
+
+  Int_t GetNumberOfCells() const { return fAbsId.size(); }
+  void Load(AliVCaloCells * cells);
+  void Store(AliVCaloCells * cells) const;
+};
+
 /**
  * @class AliEmcalCorrectionComponent
  * @ingroup EMCALCORRECTIONFW
@@ -58,6 +82,11 @@ class AliEmcalCorrectionComponent : public TNamed {
   void UpdateCells();
   void GetPass();
   void FillCellQA(TH1F* h);
+
+  /// True if Run() can be applied to the cell arrays of the fused cell pass
+  virtual Bool_t SupportsFusedCellPass() const { return kFALSE; }
+  /// Set the cell arrays Run() acts on instead of the cells (0 outside of the fused cell pass)
+  void SetFusedCells(AliEmcalCorrectionCellArrays * cells) { fFusedCells = cells; }
   Int_t InitBadChannels();
 
   // Containers and cells
@@ -137,12 +166,23 @@ class AliEmcalCorrectionComponent : public TNamed {
   TString                fBasePath;                       ///< Base folder path to get root files
   TString                fCustomBadChannelFilePath;       ///< Custom path to bad channel map OADB file
 
+  AliEmcalCorrectionCellArrays *fFusedCells;              //!<! Cell arrays of the fused cell pass, if running in it
+  std::vector<Char_t>     fFlatCellAccepted;              //!<! Per absId: cell exists and is not removed as bad channel
+  std::vector<Float_t>    fFlatCellEnergyFactor;          //!<! Per absId: energy recalibration factor
+  std::vector<Float_t>    fFlatCellTimeFactor;            //!<! Per (bc%4, low gain, absId): time recalibration factor (ns)
+  std::vector<Short_t>    fFlatCellSM;                    //!<! Per absId: supermodule
+  Int_t                   fFlatCellRun;                   //!<! Run for which the flat cell calibration was built
+  UInt_t                  fFlatCellSwitches;              //!<! Reco utils switches the flat cell calibration was built with
+
+  void BuildFlatCellCalibration(UInt_t switches);
+  void RecalibrateFusedCells(Int_t bunchCrossNo);
+
  private:
   AliEmcalCorrectionComponent(const AliEmcalCorrectionComponent &);               // Not implemented
   AliEmcalCorrectionComponent &operator=(const AliEmcalCorrectionComponent &);    // Not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionComponent, 9); // EMCal correction component
+  ClassDef(AliEmcalCorrectionComponent, 10); // EMCal correction component
   /// \endcond
 };
 
@@ -60,6 +60,8 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fBeamType(kNA),
   fForceBeamType(kNA),
   fNeedEmcalGeom(kTRUE),
+  fUseFusedCellPass(kFALSE),
+  fFusedCells(0),
   fGeom(0),
   fParticleCollArray(),
   fClusterCollArray(),
@@ -105,6 +107,8 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fBeamType(kNA),
   fForceBeamType(kNA),
   fNeedEmcalGeom(kTRUE),
+  fUseFusedCellPass(kFALSE),
+  fFusedCells(0),
   fGeom(0),
   fParticleCollArray(),
   fClusterCollArray(),
@@ -150,6 +154,8 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fBeamType(task.fBeamType),
   fForceBeamType(task.fForceBeamType),
   fNeedEmcalGeom(task.fNeedEmcalGeom),
+  fUseFusedCellPass(task.fUseFusedCellPass),
+  fFusedCells(0),                                 // Created when needed
   fGeom(task.fGeom),
   fParticleCollArray(*(static_cast<TObjArray *>(task.fParticleCollArray.Clone()))),
   fClusterCollArray(*(static_cast<TObjArray *>(task.fClusterCollArray.Clone()))),
@@ -213,6 +219,8 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fBeamType, second.fBeamType);
   swap(first.fForceBeamType, second.fForceBeamType);
   swap(first.fNeedEmcalGeom, second.fNeedEmcalGeom);
+  swap(first.fUseFusedCellPass, second.fUseFusedCellPass);
+  swap(first.fFusedCells, second.fFusedCells);
   swap(first.fGeom, second.fGeom);
   swap(first.fParticleCollArray, second.fParticleCollArray);
   swap(first.fClusterCollArray, second.fClusterCollArray);
@@ -227,6 +235,7 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
 AliEmcalCorrectionTask::~AliEmcalCorrectionTask()
 {
   // Destructor
+  delete fFusedCells;
 }
 
 void AliEmcalCorrectionTask::Initialize(bool removeDummyTask)
@@ -1296,15 +1305,27 @@ Bool_t AliEmcalCorrectionTask::RetrieveEventObjects()
  */
 Bool_t AliEmcalCorrectionTask::Run()
 {
-  // Run the initialization for all derived classes.
-  for (auto component : fCorrectionComponents)
+  for (std::size_t iComponent = 0; iComponent < fCorrectionComponents.size(); iComponent++)
   {
-    component->SetInputEvent(InputEvent());
-    component->SetMCEvent(MCEvent());
-    component->SetCentralityBin(fCentBin);
-    component->SetCentrality(fCent);
-    component->SetVertex(fVertex);
+    AliEmcalCorrectionComponent * component = fCorrectionComponents.at(iComponent);
+
+    // Find the consecutive cell components acting on the same cells, which can be fused
+    std::size_t lastFused = iComponent;
+    if (fUseFusedCellPass && component->SupportsFusedCellPass() && component->GetCaloCells()) {
+      while (lastFused + 1 < fCorrectionComponents.size() &&
+             fCorrectionComponents.at(lastFused + 1)->SupportsFusedCellPass() &&
+             fCorrectionComponents.at(lastFused + 1)->GetCaloCells() == component->GetCaloCells()) {
+        lastFused++;
+      }
+    }
+
+    if (lastFused > iComponent) {
+      RunFusedCellPass(iComponent, lastFused);
+      iComponent = lastFused;
+      continue;
+    }
 
+    SetComponentEventProperties(component);
     component->Run();
   }
 
@@ -1313,6 +1334,49 @@ Bool_t AliEmcalCorrectionTask::Run()
   return kTRUE;
 }
 
+/**
+ * Sets the event properties in a correction component before it is run.
+ *
+ * @param component Correction component to be run
+ */
+void AliEmcalCorrectionTask::SetComponentEventProperties(AliEmcalCorrectionComponent * component)
+{
+  component->SetInputEvent(InputEvent());
+  component->SetMCEvent(MCEvent());
+  component->SetCentralityBin(fCentBin);
+  component->SetCentrality(fCent);
+  component->SetVertex(fVertex);
+}
+
+/**
+ * Runs the cell components firstComponent to lastComponent, which act on the same cells, in one pass:
+ * the cells are copied once into a structure of arrays, each component applies its correction to the
+ * arrays, and the cells are written back once at the end. The resulting cells are the same as when
+ * running the components one after the other.
+ *
+ * @param firstComponent Index of the first component of the pass
+ * @param lastComponent Index of the last component of the pass
+ */
+void AliEmcalCorrectionTask::RunFusedCellPass(std::size_t firstComponent, std::size_t lastComponent)
+{
+  AliVCaloCells * cells = fCorrectionComponents.at(firstComponent)->GetCaloCells();
+  if (!fFusedCells) {
+    fFusedCells = new AliEmcalCorrectionCellArrays;
+  }
+  fFusedCells->Load(cells);
+
+  for (std::size_t iComponent = firstComponent; iComponent <= lastComponent; iComponent++)
+  {
+    AliEmcalCorrectionComponent * component = fCorrectionComponents.at(iComponent);
+    SetComponentEventProperties(component);
+    component->SetFusedCells(fFusedCells);
+    component->Run();
+    component->SetFusedCells(0);
+  }
+
+  fFusedCells->Store(cells);
+}
+
 /**
  * Executed when the file is changed. Also calls UserNotify() for each component.
  */
@@ -3,6 +3,7 @@
 
 class AliEmcalCorrectionCellContainer;
 class AliEmcalCorrectionComponent;
+struct AliEmcalCorrectionCellArrays;
 class AliEMCALGeometry;
 class AliVEvent;
 
@@ -100,6 +101,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Set
   void                        SetForceBeamType(BeamType f)                          { fForceBeamType     = f                              ; }
   void                        SetNeedEmcalGeometry(Bool_t b)                        { fNeedEmcalGeom     = b                              ; }
+  /// Apply consecutive cell components which act on the same cells in one pass over a copy of the cells
+  void                        SetUseFusedCellPass(Bool_t b = kTRUE)                 { fUseFusedCellPass  = b                              ; }
   // Centrality options
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   void                        SetCentralityEstimator(const char * c)                { fCentEst           = c                              ; }
@@ -191,6 +194,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Execute component functions
   void UserCreateOutputObjectsComponents();
   void ExecOnceComponents();
+  void SetComponentEventProperties(AliEmcalCorrectionComponent * component);
+  void RunFusedCellPass(std::size_t firstComponent, std::size_t lastComponent);
 
   // Initialization functions
   void InitializeConfiguration();
@@ -240,6 +245,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   BeamType                    fBeamType;                   //!<! Event beam type
   BeamType                    fForceBeamType;              ///< forced beam type
   Bool_t                      fNeedEmcalGeom;              ///< whether or not the task needs the emcal geometry
+  Bool_t                      fUseFusedCellPass;           ///< Apply consecutive cell components in one pass over a copy of the cells
+  AliEmcalCorrectionCellArrays *fFusedCells;               //!<! Cell arrays of the fused cell pass
   AliEMCALGeometry           *fGeom;                       //!<! Emcal geometry
 
   TObjArray                   fParticleCollArray;          ///< Particle/track collection array
@@ -249,7 +256,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   TList *                     fOutput;                     //!<! Output for histograms
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 9); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 10); // EMCal correction task
   /// \endcond
 };
 
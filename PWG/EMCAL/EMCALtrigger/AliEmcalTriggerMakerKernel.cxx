@@ -67,6 +67,9 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fSmearThreshold(0.1),
   fScaleShift(0.),
   fDoBackgroundSubtraction(false),
+  fUseSummedAreaTables(kFALSE),
+  fL1AlgorithmSettings(),
+  fL0AlgorithmSettings(),
   fGeometry(nullptr),
   fPatchAmplitudes(nullptr),
   fPatchADCSimple(nullptr),
@@ -74,7 +77,13 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fPatchEnergySimpleSmeared(nullptr),
   fLevel0TimeMap(nullptr),
   fTriggerBitMap(nullptr),
-  fADCtoGeV(1.)
+  fADCtoGeV(1.),
+  fBadChannelMask(),
+  fOfflineBadChannelMask(),
+  fSATAmplitudes(),
+  fSATADC(),
+  fSATADCSimple(),
+  fSATEnergySmeared()
 {
   memset(fThresholdConstants, 0, sizeof(Int_t) * 12);
   memset(fL1ThresholdsOffline, 0, sizeof(ULong64_t) * 4);
@@ -122,6 +131,9 @@ void AliEmcalTriggerMakerKernel::Init(){
     fPatchEnergySimpleSmeared = new AliEMCALTriggerDataGrid<double>;
     fPatchEnergySimpleSmeared->Allocate(48, nrows);
   }
+
+  // Bad channel lists might have been filled before the kernel was streamed
+  BuildBadChannelMasks();
 }
 
 void AliEmcalTriggerMakerKernel::AddL1TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize)
@@ -131,6 +143,9 @@ void AliEmcalTriggerMakerKernel::AddL1TriggerAlgorithm(Int_t rowmin, Int_t rowma
   trigger->SetPatchSize(patchSize);
   trigger->SetSubregionSize(subregionSize);
   fPatchFinder->AddTriggerAlgorithm(trigger);
+
+  Int_t settings[kNAlgorithmSettings] = {rowmin, rowmax, static_cast<Int_t>(bitmask), patchSize, subregionSize};
+  fL1AlgorithmSettings.insert(fL1AlgorithmSettings.end(), settings, settings + kNAlgorithmSettings);
 }
 
 void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize)
@@ -139,6 +154,9 @@ void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowma
   fLevel0PatchFinder = new AliEMCALTriggerAlgorithm<double>(rowmin, rowmax, bitmask);
   fLevel0PatchFinder->SetPatchSize(patchSize);
   fLevel0PatchFinder->SetSubregionSize(subregionSize);
+
+  Int_t settings[kNAlgorithmSettings] = {rowmin, rowmax, static_cast<Int_t>(bitmask), patchSize, subregionSize};
+  fL0AlgorithmSettings.assign(settings, settings + kNAlgorithmSettings);
 }
 
 void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
@@ -149,6 +167,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -167,6 +186,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -184,6 +204,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP20158x8()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -201,6 +222,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPPb2013()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -216,6 +238,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2012()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -231,6 +254,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -246,6 +270,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fL1AlgorithmSettings.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   fConfigured = true;
@@ -362,7 +387,7 @@ void AliEmcalTriggerMakerKernel::ReadTriggerData(AliVCaloTrigger *trigger){
     }
 
     // exclude channel completely if it is masked as hot channel
-    if (fBadChannels.find(absId) != fBadChannels.end()){
+    if (IsChannelInMask(fBadChannelMask, absId)){
       AliDebugStream(1) << "Found ADC for masked fastor " << absId << ", rejecting" << std::endl;
       continue;
     }
@@ -419,7 +444,7 @@ void AliEmcalTriggerMakerKernel::ReadCellData(AliVCaloCells *cells){
     Short_t cellId = cells->GetCellNumber(iCell);
 
     // Check bad channel map
-    if (fOfflineBadChannels.find(cellId) != fOfflineBadChannels.end()) {
+    if (IsChannelInMask(fOfflineBadChannelMask, cellId)) {
       AliDebugStream(1) << "Cell " << cellId << " masked as bad channel, rejecting." << std::endl;
       continue;
     }
@@ -437,7 +462,7 @@ void AliEmcalTriggerMakerKernel::ReadCellData(AliVCaloCells *cells){
       // Exclude FEE amplitudes from cells which are within a TRU which is masked at
       // online level. Using this the online acceptance can be applied to offline
       // patches as well.
-      if(fBadChannels.find(absId) != fBadChannels.end()){
+      if(IsChannelInMask(fBadChannelMask, absId)){
         AliDebugStream(1) << "Cell " << cellId << " corresponding to masked fastor " << absId << ", rejecting." << std::endl;
         continue;
       }
@@ -517,8 +542,19 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
   bkgPatchMask = 1 << fTriggerBitConfig->GetBkgBit();
       //l0PatchMask = 1 << fTriggerBitConfig->GetLevel0Bit();
 
+  // Summed area tables are built once per grid and shared between all patch sizes
+  if (fUseSummedAreaTables) {
+    fSATAmplitudes.Build(*fPatchAmplitudes);
+    if (!useL0amp) fSATADC.Build(*fPatchADC);
+    fSATADCSimple.Build(*fPatchADCSimple);
+    if (fPatchEnergySimpleSmeared) fSATEnergySmeared.Build(*fPatchEnergySimpleSmeared);
+  }
+
   std::vector<AliEMCALTriggerRawPatch> patches;
-  if (fPatchFinder) {
+  if (fUseSummedAreaTables) {
+    if (fPatchFinder) FindPatchesSummedArea(fL1AlgorithmSettings, useL0amp ? fSATAmplitudes : fSATADC, fSATADCSimple, patches);
+  }
+  else if (fPatchFinder) {
     if (useL0amp) {
       patches = fPatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
     }
@@ -567,9 +603,15 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
       double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+      if (fUseSummedAreaTables) {
+        energysmear = fSATEnergySmeared.GetSum(fullpatch.GetColStart(), fullpatch.GetRowStart(),
+            fullpatch.GetColStart() + fullpatch.GetPatchSize(), fullpatch.GetRowStart() + fullpatch.GetPatchSize());
+      }
+      else {
+        for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
+          for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
+            energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+          }
         }
       }
       AliDebugStream(1) << "Patch size(" << fullpatch.GetPatchSize() <<") energy " << fullpatch.GetPatchE() << " smeared " << energysmear << std::endl;
@@ -580,7 +622,10 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
 
   // Find Level0 patches
   std::vector<AliEMCALTriggerRawPatch> l0patches;
-  if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+  if (fLevel0PatchFinder) {
+    if (fUseSummedAreaTables) FindPatchesSummedArea(fL0AlgorithmSettings, fSATAmplitudes, fSATADCSimple, l0patches);
+    else l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+  }
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = l0patches.begin(); patchit != l0patches.end(); ++patchit){
     Int_t offlinebits = 0, onlinebits = 0;
     if(HasPHOSOverlap(*patchit)) continue;
@@ -598,9 +643,15 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
       double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+      if (fUseSummedAreaTables) {
+        energysmear = fSATEnergySmeared.GetSum(fullpatch.GetColStart(), fullpatch.GetRowStart(),
+            fullpatch.GetColStart() + fullpatch.GetPatchSize(), fullpatch.GetRowStart() + fullpatch.GetPatchSize());
+      }
+      else {
+        for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
+          for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
+            energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+          }
         }
       }
       fullpatch.SetSmearedEnergy(energysmear);
@@ -712,10 +763,71 @@ AliEmcalTriggerMakerKernel::ELevel0TriggerStatus_t AliEmcalTriggerMakerKernel::C
 
 void AliEmcalTriggerMakerKernel::ClearFastORBadChannels(){
   fBadChannels.clear();
+  fBadChannelMask.clear();
 }
 
 void AliEmcalTriggerMakerKernel::ClearOfflineBadChannels() {
   fOfflineBadChannels.clear();
+  fOfflineBadChannelMask.clear();
+}
+
+void AliEmcalTriggerMakerKernel::BuildBadChannelMasks(){
+  fBadChannelMask.clear();
+  for(std::set<Short_t>::const_iterator channelit = fBadChannels.begin(); channelit != fBadChannels.end(); ++channelit) SetChannelInMask(fBadChannelMask, *channelit);
+  fOfflineBadChannelMask.clear();
+  for(std::set<Short_t>::const_iterator channelit = fOfflineBadChannels.begin(); channelit != fOfflineBadChannels.end(); ++channelit) SetChannelInMask(fOfflineBadChannelMask, *channelit);
+}
+
+void AliEmcalTriggerMakerKernel::FindPatchesSummedArea(const std::vector<Int_t> &algorithms, const SummedAreaTable_t &adc, const SummedAreaTable_t &offlineadc, std::vector<AliEMCALTriggerRawPatch> &patches) const {
+  for(std::size_t ialgo = 0; ialgo + kNAlgorithmSettings <= algorithms.size(); ialgo += kNAlgorithmSettings){
+    Int_t rowmin = algorithms[ialgo], rowmax = algorithms[ialgo + 1], bitmask = algorithms[ialgo + 2],
+          patchsize = algorithms[ialgo + 3], subregionsize = algorithms[ialgo + 4];
+    // Same start positions as the sliding window in AliEMCALTriggerAlgorithm
+    Int_t rowStartMax = rowmax - (patchsize - 1), colStartMax = adc.fNCols - patchsize;
+    for(Int_t irow = rowmin; irow <= rowStartMax; irow += subregionsize){
+      for(Int_t icol = 0; icol <= colStartMax; icol += subregionsize){
+        double sumadc = adc.GetSum(icol, irow, icol + patchsize, irow + patchsize),
+               sumofflineadc = offlineadc.GetSum(icol, irow, icol + patchsize, irow + patchsize);
+        // Patch thresholds of the algorithms are 0
+        if(sumadc > 0 || sumofflineadc > 0){
+          AliEMCALTriggerRawPatch recpatch(icol, irow, patchsize, sumadc, sumofflineadc);
+          recpatch.SetBitmask(bitmask);
+          patches.push_back(recpatch);
+        }
+      }
+    }
+  }
+}
+
+void AliEmcalTriggerMakerKernel::SummedAreaTable_t::Build(const AliEMCALTriggerDataGrid<double> &grid){
+  fNCols = grid.GetNumberOfCols();
+  fNRows = grid.GetNumberOfRows();
+  Int_t stride = fNCols + 1;
+  fSums.assign(stride * (fNRows + 1), 0.);
+  fNonZero.assign(stride * (fNRows + 1), 0);
+  for(Int_t irow = 0; irow < fNRows; irow++){
+    double rowsum = 0;
+    int rownonzero = 0;
+    for(Int_t icol = 0; icol < fNCols; icol++){
+      double amp = grid(icol, irow);
+      rowsum += amp;
+      if(amp != 0) rownonzero++;
+      fSums[(irow + 1) * stride + icol + 1] = fSums[irow * stride + icol + 1] + rowsum;
+      fNonZero[(irow + 1) * stride + icol + 1] = fNonZero[irow * stride + icol + 1] + rownonzero;
+    }
+  }
+}
+
+double AliEmcalTriggerMakerKernel::SummedAreaTable_t::GetSum(Int_t col0, Int_t row0, Int_t col1, Int_t row1) const {
+  col0 = TMath::Max(col0, 0); row0 = TMath::Max(row0, 0);
+  col1 = TMath::Min(col1, fNCols); row1 = TMath::Min(row1, fNRows);
+  if(col1 <= col0 || row1 <= row0) return 0.;
+  Int_t stride = fNCols + 1,
+        i00 = row0 * stride + col0, i01 = row0 * stride + col1,
+        i10 = row1 * stride + col0, i11 = row1 * stride + col1;
+  // Areas without signal are exactly 0, independent of the rounding of the sums
+  if(!(fNonZero[i11] - fNonZero[i01] - fNonZero[i10] + fNonZero[i00])) return 0.;
+  return fSums[i11] - fSums[i01] - fSums[i10] + fSums[i00];
 }
 
 Bool_t AliEmcalTriggerMakerKernel::IsGammaPatch(const AliEMCALTriggerRawPatch &patch) const {
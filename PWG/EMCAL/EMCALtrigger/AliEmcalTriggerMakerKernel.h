@@ -217,7 +217,7 @@ public:
    * @brief Add a FastOR bad channel to the list
    * @param[in] absId Absolute ID of the bad channel
    */
-  void AddFastORBadChannel(Short_t absId) { fBadChannels.insert(absId); }
+  void AddFastORBadChannel(Short_t absId) { fBadChannels.insert(absId); SetChannelInMask(fBadChannelMask, absId); }
 
   /**
    * @brief Read the FastOR bad channel map from a standard stream
@@ -240,7 +240,7 @@ public:
    * @brief Add an offline bad channel to the set
    * @param[in] absId Absolute ID of the bad channel
    */
-  void AddOfflineBadChannel(Short_t absId) { fOfflineBadChannels.insert(absId); }
+  void AddOfflineBadChannel(Short_t absId) { fOfflineBadChannels.insert(absId); SetChannelInMask(fOfflineBadChannelMask, absId); }
 
   /**
    * @brief Read the offline bad channel map from a standard stream
@@ -399,6 +399,18 @@ public:
    */
   void SetScaleShift(Double_t scaleshift) { fScaleShift = scaleshift; }
 
+  /**
+   * @brief Find trigger patches using summed area tables
+   *
+   * Instead of summing all FastORs of a patch for every position of the sliding
+   * window, a summed area table (integral image) is built once per event for each
+   * data grid, so that the amplitude of a patch of any size is obtained with four
+   * lookups. ADC sums are identical to the sliding window, offline amplitudes agree
+   * up to the rounding of the summation.
+   * @param[in] doUse If true summed area tables are used
+   */
+  void SetUseSummedAreaTables(Bool_t doUse = kTRUE) { fUseSummedAreaTables = doUse; }
+
   /**
    * Check whether the trigger maker has been specially configured. Status has to
    * be set in the functions ConfigureForXX.
@@ -450,6 +462,40 @@ protected:
     kIndRhoDCAL = 1,
     kNIndRho = 2
   };
+  enum {
+    kNAlgorithmSettings = 5       ///< Number of settings per patch algorithm (row min, row max, bitmask, patch size, subregion size)
+  };
+
+  /**
+   * @struct SummedAreaTable_t
+   * @brief Summed area table (integral image) of a data grid
+   *
+   * Entry (col, row) of the table contains the sum of all channels with smaller
+   * column and row. Besides the sums the number of non-zero channels is stored,
+   * so that areas without signal are exactly 0.
+   */
+  struct SummedAreaTable_t {
+    SummedAreaTable_t(): fNCols(0), fNRows(0), fSums(), fNonZero() {}
+
+    /**
+     * @brief Build the table from a data grid
+     * @param[in] grid Data grid with the channel amplitudes
+     */
+    void Build(const AliEMCALTriggerDataGrid<double> &grid);
+
+    /**
+     * @brief Get the sum of the channels in the area [col0, col1) x [row0, row1)
+     *
+     * Parts of the area outside the grid do not contribute.
+     * @return Sum of the channel amplitudes in the area
+     */
+    double GetSum(Int_t col0, Int_t row0, Int_t col1, Int_t row1) const;
+
+    Int_t                 fNCols;       ///< Number of columns of the grid
+    Int_t                 fNRows;       ///< Number of rows of the grid
+    std::vector<double>   fSums;        ///< Sums, (fNCols + 1) x (fNRows + 1) entries
+    std::vector<int>      fNonZero;     ///< Number of non-zero channels, same layout as the sums
+  };
 
   /**
    * @brief Accept trigger patch as Level0 patch.
@@ -489,6 +535,44 @@ protected:
    */
   bool HasPHOSOverlap(const AliEMCALTriggerRawPatch &patch) const;
 
+  /**
+   * @brief Find patches of a set of algorithms from the summed area tables
+   *
+   * Patches are created in the same order and with the same selection as in
+   * the sliding window patch finder.
+   * @param[in] algorithms Settings of the algorithms (kNAlgorithmSettings values per algorithm)
+   * @param[in] adc Summed area table of the online amplitudes
+   * @param[in] offlineadc Summed area table of the offline amplitudes
+   * @param[out] patches Vector the patches are appended to
+   */
+  void FindPatchesSummedArea(const std::vector<Int_t> &algorithms, const SummedAreaTable_t &adc, const SummedAreaTable_t &offlineadc, std::vector<AliEMCALTriggerRawPatch> &patches) const;
+
+  /**
+   * @brief Rebuild the flat bad channel masks from the bad channel lists
+   */
+  void BuildBadChannelMasks();
+
+  /**
+   * @brief Mark channel as bad in a flat bad channel mask
+   * @param[in,out] mask Bad channel mask, extended if needed
+   * @param[in] absId Absolute ID of the channel
+   */
+  static void SetChannelInMask(std::vector<bool> &mask, Short_t absId) {
+    if (absId < 0) return;
+    if (absId >= static_cast<Int_t>(mask.size())) mask.resize(absId + 1, false);
+    mask[absId] = true;
+  }
+
+  /**
+   * @brief Check whether a channel is marked as bad in a flat bad channel mask
+   * @param[in] mask Bad channel mask
+   * @param[in] absId Absolute ID of the channel
+   * @return True if the channel is bad
+   */
+  static bool IsChannelInMask(const std::vector<bool> &mask, Int_t absId) {
+    return absId >= 0 && absId < static_cast<Int_t>(mask.size()) && mask[absId];
+  }
+
   std::set<Short_t>                         fBadChannels;                 ///< Container of bad channels
   std::set<Short_t>                         fOfflineBadChannels;          ///< Abd ID of offline bad channels
   TArrayF                                   fFastORPedestal;              ///< FastOR pedestal
@@ -516,6 +600,9 @@ protected:
   Double_t                                  fSmearThreshold;              ///< Smear threshold: Only cell energies above threshold are smeared
   Double_t                                  fScaleShift;                  ///< Scale shift simulation
   Bool_t                                    fDoBackgroundSubtraction;     ///< Swtich for background subtraction (only online ADC)
+  Bool_t                                    fUseSummedAreaTables;         ///< Find patches using summed area tables instead of sliding windows
+  std::vector<Int_t>                        fL1AlgorithmSettings;         ///< Settings of the L1 algorithms, kNAlgorithmSettings values per algorithm
+  std::vector<Int_t>                        fL0AlgorithmSettings;         ///< Settings of the L0 algorithm
 
   const AliEMCALGeometry                    *fGeometry;                   //!<! Underlying EMCAL geometry
   AliEMCALTriggerDataGrid<double>           *fPatchAmplitudes;            //!<! TRU Amplitudes (for L0)
@@ -528,8 +615,15 @@ protected:
 
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
 
+  std::vector<bool>                         fBadChannelMask;              //!<! Flat bitmap of FastOR bad channels (by abs. ID)
+  std::vector<bool>                         fOfflineBadChannelMask;       //!<! Flat bitmap of offline bad channels (by abs. ID)
+  SummedAreaTable_t                         fSATAmplitudes;               //!<! Summed area table of the TRU amplitudes (L0)
+  SummedAreaTable_t                         fSATADC;                      //!<! Summed area table of the ADC values
+  SummedAreaTable_t                         fSATADCSimple;                //!<! Summed area table of the offline amplitudes
+  SummedAreaTable_t                         fSATEnergySmeared;            //!<! Summed area table of the smeared energies
+
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
   /// \endcond
 };
 
@@ -24,6 +24,8 @@
 #define AliFlowAnalysisWithMultiparticleCorrelations_cxx
 
 #include "AliFlowAnalysisWithMultiparticleCorrelations.h"
+#include <algorithm>
+#include <vector>
 
 using std::endl;
 using std::cout;
@@ -80,6 +82,8 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fCalculateOnlyForSC(kFALSE),
  fCalculateOnlyCos(kFALSE),
  fCalculateOnlySin(kFALSE),
+ fUseMemoizedRecursion(kFALSE),
+ fRecursionCache(),
  // 4.) Event-by-event cumulants:
  fEbECumulantsList(NULL),
  fEbECumulantsFlagsPro(NULL),
@@ -1995,6 +1999,8 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
 {
  // Fill Q-vector components.
 
+ fRecursionCache.clear(); // sub-correlators of the previous Q-vectors are no longer valid
+
  Int_t nTracks = anEvent->NumberOfTracks(); // TBI shall I promote this to data member?
  Double_t dPhi = 0., wPhi = 1.; // azimuthal angle and corresponding phi weight
  Double_t dPt = 0., wPt = 1.; // transverse momentum and corresponding pT weight
@@ -3863,6 +3869,8 @@ void AliFlowAnalysisWithMultiparticleCorrelations::ResetQvector()
 {
  // Reset all Q-vector components to zero before starting a new event. 
 
+ fRecursionCache.clear();
+
  for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++) 
  {
   for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight powe
@@ -4130,7 +4138,7 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Seven(Int_t n1, Int_t n2,
 
  Int_t harmonic[7] = {n1,n2,n3,n4,n5,n6,n7};
 
- TComplex seven = Recursion(7,harmonic); 
+ TComplex seven = fUseMemoizedRecursion ? RecursionMemoized(7,harmonic) : Recursion(7,harmonic); 
 
  return seven;
 
@@ -4144,7 +4152,7 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Eight(Int_t n1, Int_t n2,
 
  Int_t harmonic[8] = {n1,n2,n3,n4,n5,n6,n7,n8};
 
- TComplex eight = Recursion(8,harmonic); 
+ TComplex eight = fUseMemoizedRecursion ? RecursionMemoized(8,harmonic) : Recursion(8,harmonic); 
 
  return eight;
 
@@ -5062,6 +5070,89 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Recursion(Int_t n, Int_t*
 
 //=======================================================================================================================
 
+TComplex AliFlowAnalysisWithMultiparticleCorrelations::RecursionMemoized(Int_t n, const Int_t* harmonic)
+{
+ // Calculate multi-particle correlators, same result as Recursion(n,harmonic). 
+
+ // The correlator is a sum over all partitions of the n particles into groups, each group contributing
+ // Q(sum of its harmonics,size of the group). The group holding the last particle is chosen first,
+ // the rest is again a correlator of the remaining particles. Correlators depend only on the multiset
+ // of harmonics, so they are cached with the sorted harmonics as key and each one is calculated only
+ // once per event, also when it appears in many different correlators (e.g. all denominators are the
+ // same). The cache is cleared whenever the Q-vectors are filled or reset.
+
+ std::string harmonics(n,'\0');
+ for(Int_t h=0;h<n;h++)
+ {
+  harmonics[h] = (char)(harmonic[h]+128); // TBI harmonics are limited to [-128,127]
+ }
+ std::sort(harmonics.begin(),harmonics.end());
+
+ return MemoizedCorrelator(harmonics);
+
+} // TComplex AliFlowAnalysisWithMultiparticleCorrelations::RecursionMemoized(Int_t n, const Int_t* harmonic)
+
+//=======================================================================================================================
+
+TComplex AliFlowAnalysisWithMultiparticleCorrelations::MemoizedCorrelator(const std::string &harmonics)
+{
+ // Correlator for the sorted harmonics, see RecursionMemoized(...). 
+
+ Int_t n = (Int_t)harmonics.size();
+ if(0 == n){return TComplex(1.,0.);}
+ std::map<std::string,TComplex>::const_iterator cached = fRecursionCache.find(harmonics);
+ if(cached != fRecursionCache.end()){return cached->second;}
+
+ // Equal harmonics among the other n-1 particles are grouped, groups joining the last particle then
+ // only differ by how many particles of each value they take:
+ std::vector<char> value;
+ std::vector<Int_t> count;
+ for(Int_t h=0;h<n-1;h++)
+ {
+  if(0 == h || harmonics[h] != harmonics[h-1]){value.push_back(harmonics[h]); count.push_back(0);}
+  count.back()++;
+ }
+ Int_t nValues = (Int_t)value.size();
+ std::vector<Int_t> taken(nValues,0);
+
+ Int_t last = (UChar_t)harmonics[n-1]-128;
+ TComplex correlator(0.,0.);
+ std::string rest;
+ while(kTRUE)
+ {
+  // Group of the last particle with taken[v] particles of each value: Q(sum,k+1) with weight
+  // (-1)^k k! (number of ways to choose the particles), times the correlator of the remaining ones:
+  Int_t k = 0;
+  Int_t sum = last;
+  Double_t weight = 1.;
+  rest.clear();
+  for(Int_t v=0;v<nValues;v++)
+  {
+   for(Int_t t=0;t<taken[v];t++){weight *= (Double_t)(k+1)*(count[v]-t)/(t+1); k++;}
+   sum += taken[v]*((UChar_t)value[v]-128);
+   rest.append(count[v]-taken[v],value[v]);
+  }
+  if(k % 2){weight = -weight;}
+  correlator += weight*Q(sum,k+1)*MemoizedCorrelator(rest);
+
+  // Next group:
+  Int_t v = 0;
+  for(;v<nValues;v++)
+  {
+   if(taken[v] < count[v]){taken[v]++; break;}
+   taken[v] = 0;
+  }
+  if(v == nValues){break;}
+ } // while(kTRUE)
+
+ fRecursionCache[harmonics] = correlator;
+
+ return correlator;
+
+} // TComplex AliFlowAnalysisWithMultiparticleCorrelations::MemoizedCorrelator(const std::string &harmonics)
+
+//=======================================================================================================================
+
 TComplex AliFlowAnalysisWithMultiparticleCorrelations::OneDiff(Int_t n1)
 {
  // Generic differential one-particle correlation <exp[i(n1*psi1)]>.
@@ -5636,9 +5727,19 @@ Double_t AliFlowAnalysisWithMultiparticleCorrelations::CorrelationPsi2nPsi1n(Int
  } // switch(k)
 
  // Calculate weight and correlators:
- Double_t dWeight = Recursion(order,harmonics0.GetArray()).Re(); // weight is 'number of combinations' by default
- TComplex cNum1 = Recursion(order,harmonics1.GetArray())/dWeight;
- TComplex cNum2 = Recursion(order,harmonics2.GetArray())/dWeight;
+ Double_t dWeight = 0.;
+ TComplex cNum1(0.,0.), cNum2(0.,0.);
+ if(fUseMemoizedRecursion)
+ {
+  dWeight = RecursionMemoized(order,harmonics0.GetArray()).Re(); // weight is 'number of combinations' by default
+  cNum1 = RecursionMemoized(order,harmonics1.GetArray())/dWeight;
+  cNum2 = RecursionMemoized(order,harmonics2.GetArray())/dWeight;
+ } else
+   {
+    dWeight = Recursion(order,harmonics0.GetArray()).Re(); // weight is 'number of combinations' by default
+    cNum1 = Recursion(order,harmonics1.GetArray())/dWeight;
+    cNum2 = Recursion(order,harmonics2.GetArray())/dWeight;
+   }
  ratio = cNum1.Re()/cNum2.Re();
 
  return ratio;
@@ -15,6 +15,8 @@
 #ifndef ALIFLOWANALYSISWITHMULTIPARTICLECORRELATIONS_H
 #define ALIFLOWANALYSISWITHMULTIPARTICLECORRELATIONS_H
 
+#include <map>
+#include <string>
 #include "TH1D.h"
 #include "TH2D.h"
 #include "TProfile.h"
@@ -188,6 +190,8 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t GetCalculateOnlyCos() const {return this->fCalculateOnlyCos;};
   void SetCalculateOnlySin(Bool_t cos) {this->fCalculateOnlySin = cos;};
   Bool_t GetCalculateOnlySin() const {return this->fCalculateOnlySin;};
+  void SetUseMemoizedRecursion(Bool_t umr) {this->fUseMemoizedRecursion = umr;};
+  Bool_t GetUseMemoizedRecursion() const {return this->fUseMemoizedRecursion;};
 
   //  5.4.) Event-by-event cumulants:
   void SetEbECumulantsList(TList* const ebecl) {this->fEbECumulantsList = ebecl;};
@@ -315,6 +319,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   virtual Double_t CastStringToCorrelation(const char *string, Bool_t numerator);
   virtual Double_t Covariance(const char *x, const char *y, TProfile2D *profile2D, Bool_t bUnbiasedEstimator = kFALSE);
   virtual TComplex Recursion(Int_t n, Int_t* harmonic, Int_t mult = 1, Int_t skip = 0); // Credits: Kristjan Gulbrandsen (gulbrand@nbi.dk) 
+  virtual TComplex RecursionMemoized(Int_t n, const Int_t* harmonic); // same as Recursion(...), sub-correlators are calculated once per event
   virtual void CalculateProductsOfCorrelations(AliFlowEventSimple *anEvent, TProfile2D *profile2D);
   static void DumpPointsForDurham(TGraphErrors *ge);
   static void DumpPointsForDurham(TH1D *h);
@@ -327,6 +332,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
  private:
   AliFlowAnalysisWithMultiparticleCorrelations(const AliFlowAnalysisWithMultiparticleCorrelations& afawQc);
   AliFlowAnalysisWithMultiparticleCorrelations& operator=(const AliFlowAnalysisWithMultiparticleCorrelations& afawQc); 
+  TComplex MemoizedCorrelator(const std::string &harmonics); // harmonics are sorted and stored as chars shifted by 128
   // Data members are grouped as:
   // 0.) Base list and internal flags;
   // 1.) Control histograms;  
@@ -403,6 +409,8 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t fCalculateOnlyForSC;         // calculate only correlations needed for 'standard candles'
   Bool_t fCalculateOnlyCos;           // calculate only 'cos' correlations
   Bool_t fCalculateOnlySin;           // calculate only 'sin' correlations
+  Bool_t fUseMemoizedRecursion;       // calculate correlators via RecursionMemoized(...) instead of Recursion(...)
+  std::map<std::string,TComplex> fRecursionCache; //! sub-correlators of the current event, keyed on sorted harmonics
 
   // 4.) Event-by-event cumulants:
   TList *fEbECumulantsList;         // list to hold all e-b-e cumulants objects
@@ -476,7 +484,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Int_t fHighestHarmonicEtaGaps;      // 2-p correlations with eta gaps will be calculated for harmonics [fLowestHarmonicEtaGaps,fHighestHarmonicEtaGaps]
   TProfile *fEtaGapsPro[6];           // [harmonic] different eta gaps are different bins
 
-  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,6);
+  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,7);
 
 };
 
@@ -28,6 +28,11 @@
 // the derivation from THnSparse is obviously against many OO rules. correct would be a common baseclass of THnSparse and THn.
 //
 // Templated version allows also the use of double as storage container
+//
+// chunked storage (SetChunkSize): the bins of a step are grouped in blocks of fChunkSize bins,
+//   a block is only allocated when one of its bins is filled. The allocated blocks are stored
+//   consecutively in fValues/fSumw2, fChunkIndex gives the position of each block.
+//   This reduces the memory consumption of large, sparsely filled containers
 // 
 // Author: Jan Fiete Grosse-Oetringhaus
 
@@ -37,6 +42,7 @@
 #include "AliLog.h"
 #include "TArrayF.h"
 #include "TArrayD.h"
+#include "TArrayI.h"
 #include "THnSparse.h"
 #include "TMath.h"
 
@@ -50,10 +56,14 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   fNSteps(0),
   fValues(0),
   fSumw2(0),
+  fChunkSize(0),
+  fChunkIndex(0),
   axisCache(0),
   fNbinsCache(0),
-  fLastVars(0),
-  fLastBins(0)
+  fBinLookup(0),
+  fAxisMin(0),
+  fAxisMax(0),
+  fAxisEdges(0)
 {
   // Constructor
 }
@@ -66,10 +76,14 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   fNSteps(nSelStep),
   fValues(0),
   fSumw2(0),
+  fChunkSize(0),
+  fChunkIndex(0),
   axisCache(0),
   fNbinsCache(0),
-  fLastVars(0),
-  fLastBins(0)
+  fBinLookup(0),
+  fAxisMin(0),
+  fAxisMax(0),
+  fAxisEdges(0)
 {
   // Constructor
 
@@ -87,39 +101,51 @@ void AliTHnT<TemplateArray, TemplateType>::AliTHnT::Init()
   
   fValues = new TemplateArray*[fNSteps];
   fSumw2 = new TemplateArray*[fNSteps];
+  fChunkIndex = new TArrayI*[fNSteps];
   
   for (Int_t i=0; i<fNSteps; i++)
   {
     fValues[i] = 0;
     fSumw2[i] = 0;
+    fChunkIndex[i] = 0;
   }
 } 
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::CopyContainers(const AliTHnT &c)
+{
+  // copies the data containers of <c>, the containers of this object have to be empty
+
+  for (Int_t i=0; i<fNSteps; i++) {
+    if (c.fValues[i]) fValues[i] = new TemplateArray(*(c.fValues[i]));
+    if (c.fSumw2[i])  fSumw2[i]  = new TemplateArray(*(c.fSumw2[i]));
+    if (c.fChunkIndex && c.fChunkIndex[i]) fChunkIndex[i] = new TArrayI(*(c.fChunkIndex[i]));
+  }
+}
+
 template <class TemplateArray, typename TemplateType>
 AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   AliTHnBase(c),
   fNBins(c.fNBins),
   fNVars(c.fNVars),
   fNSteps(c.fNSteps),
-  fValues(new TemplateArray*[c.fNSteps]),
-  fSumw2(new TemplateArray*[c.fNSteps]),
+  fValues(0),
+  fSumw2(0),
+  fChunkSize(c.fChunkSize),
+  fChunkIndex(0),
   axisCache(0),
   fNbinsCache(0),
-  fLastVars(0),
-  fLastBins(0)
+  fBinLookup(0),
+  fAxisMin(0),
+  fAxisMax(0),
+  fAxisEdges(0)
 {
   //
   // AliTHnT copy constructor
   //
 
-  memset(fValues,0,fNSteps*sizeof(TemplateArray*));
-  memset(fSumw2,0,fNSteps*sizeof(TemplateArray*));
-
-  for (Int_t i=0; i<fNSteps; i++) {
-    if (c.fValues[i]) fValues[i] = new TemplateArray(*(c.fValues[i]));
-    if (c.fSumw2[i])  fSumw2[i]  = new TemplateArray(*(c.fSumw2[i]));
-  }
-
+  Init();
+  CopyContainers(c);
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -131,10 +157,8 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   
   delete[] fValues;
   delete[] fSumw2;
-  delete[] axisCache;
-  delete[] fNbinsCache;
-  delete[] fLastVars;
-  delete[] fLastBins;
+  delete[] fChunkIndex;
+  DeleteAxisCache();
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -155,7 +179,117 @@ void AliTHnT<TemplateArray, TemplateType>::DeleteContainers()
       delete fSumw2[i];
       fSumw2[i] = 0;
     }
+
+    if (fChunkIndex && fChunkIndex[i])
+    {
+      delete fChunkIndex[i];
+      fChunkIndex[i] = 0;
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetChunkSize(Int_t chunkSize)
+{
+  // sets the number of bins per storage block, 0 for dense storage (default)
+  // can only be changed before the container is filled
+
+  for (Int_t i=0; i<fNSteps; i++)
+  {
+    if (fValues[i])
+    {
+      AliError("Storage mode cannot be changed after filling");
+      return;
+    }
+  }
+
+  fChunkSize = (chunkSize > 0) ? chunkSize : 0;
+
+  // objects read from files written before the chunked storage existed
+  if (fChunkSize > 0 && !fChunkIndex)
+  {
+    fChunkIndex = new TArrayI*[fNSteps];
+    for (Int_t i=0; i<fNSteps; i++)
+      fChunkIndex[i] = 0;
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+Long64_t AliTHnT<TemplateArray, TemplateType>::GetNAllocatedBins(Int_t step) const
+{
+  // number of bins allocated for step <step>
+
+  if (!fValues[step])
+    return 0;
+  if (fChunkSize == 0)
+    return fNBins;
+  return (Long64_t) fChunkIndex[step]->At(GetNChunks()) * fChunkSize;
+}
+
+template <class TemplateArray, typename TemplateType>
+Long64_t AliTHnT<TemplateArray, TemplateType>::GetStorageIndex(Int_t istep, Long64_t bin, Bool_t create)
+{
+  // returns the position of the global bin <bin> in the storage arrays of step <istep>
+  // if the storage (block) is not allocated, it is created if <create> is set, otherwise -1 is returned
+
+  if (fChunkSize == 0)
+  {
+    if (!fValues[istep])
+    {
+      if (!create)
+        return -1;
+      fValues[istep] = new TemplateArray(fNBins);
+      AliInfo(Form("Created values container for step %d", istep));
+    }
+    return bin;
+  }
+
+  if (!fValues[istep])
+  {
+    if (!create)
+      return -1;
+    Long64_t nChunks = GetNChunks();
+    fChunkIndex[istep] = new TArrayI(nChunks+1);
+    fChunkIndex[istep]->Reset(-1);
+    fChunkIndex[istep]->SetAt(0, nChunks);
+    fValues[istep] = new TemplateArray(0);
+    AliInfo(Form("Created values container for step %d (%lld blocks of %d bins)", istep, nChunks, fChunkSize));
+  }
+
+  Long64_t chunk = bin / fChunkSize;
+  Int_t position = fChunkIndex[istep]->At(chunk);
+  if (position < 0)
+  {
+    if (!create)
+      return -1;
+    position = AllocateChunk(istep);
+    fChunkIndex[istep]->SetAt(position, chunk);
+  }
+
+  return (Long64_t) position * fChunkSize + bin % fChunkSize;
+}
+
+template <class TemplateArray, typename TemplateType>
+Int_t AliTHnT<TemplateArray, TemplateType>::AllocateChunk(Int_t istep)
+{
+  // reserves the next free block in the storage of step <istep> and returns its position
+  // the storage grows by doubling (limited to the size of the dense storage) to keep the number of reallocations small
+
+  Long64_t nChunks = GetNChunks();
+  Int_t used = fChunkIndex[istep]->At(nChunks);
+  Long64_t needed = (Long64_t) (used + 1) * fChunkSize;
+
+  if (fValues[istep]->GetSize() < needed)
+  {
+    Long64_t newSize = TMath::Max(needed, (Long64_t) 2 * fValues[istep]->GetSize());
+    newSize = TMath::Min(newSize, nChunks * fChunkSize);
+    fValues[istep]->Set(newSize);
+    if (fSumw2[istep])
+      fSumw2[istep]->Set(newSize);
   }
+
+  fChunkIndex[istep]->SetAt(used + 1, nChunks);
+  return used;
 }
 
 //____________________________________________________________________
@@ -169,31 +303,23 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
     fNBins=c.fNBins;
     fNVars=c.fNVars;
     if(fNSteps) {
-      for(Int_t i=0; i< fNSteps; ++i) {
-	delete fValues[i];
-	delete fSumw2[i];
-      }
+      DeleteContainers();
       delete [] fValues;
       delete [] fSumw2;
+      delete [] fChunkIndex;
     }
     fNSteps=c.fNSteps;
+    fChunkSize=c.fChunkSize;
     if(fNSteps) {
-      fValues=new TemplateArray*[fNSteps];
-      fSumw2=new TemplateArray*[fNSteps];
-      memset(fValues,0,fNSteps*sizeof(TemplateArray*));
-      memset(fSumw2,0,fNSteps*sizeof(TemplateArray*));
-
-      for (Int_t i=0; i<fNSteps; i++) {
-	if (c.fValues[i]) fValues[i] = new TemplateArray(*(c.fValues[i]));
-	if (c.fSumw2[i])  fSumw2[i]  = new TemplateArray(*(c.fSumw2[i]));
-      }
+      Init();
+      CopyContainers(c);
     } else {
       fValues = 0;
       fSumw2 = 0;
+      fChunkIndex = 0;
     }
-    delete [] axisCache;
-    axisCache = new TAxis*[fNVars];
-    memcpy(axisCache, c.axisCache, fNVars*sizeof(TAxis*));
+    // the axis cache refers to the axes of this object, it is rebuilt at the next fill
+    DeleteAxisCache();
   }
   return *this;
 }
@@ -211,21 +337,10 @@ void AliTHnT<TemplateArray, TemplateType>::Copy(TObject& c) const
   target.fNSteps = fNSteps;
   target.fNBins = fNBins;
   target.fNVars = fNVars;
+  target.fChunkSize = fChunkSize;
   
   target.Init();
-
-  for (Int_t i=0; i<fNSteps; i++)
-  {
-    if (fValues[i])
-      target.fValues[i] = new TemplateArray(*(fValues[i]));
-    else
-      target.fValues[i] = 0;
-    
-    if (fSumw2[i])
-      target.fSumw2[i] = new TemplateArray(*(fSumw2[i]));
-    else
-      target.fSumw2[i] = 0;
-  }
+  target.CopyContainers(*this);
 }
 
 //____________________________________________________________________
@@ -256,22 +371,57 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 
     for (Int_t i=0; i<fNSteps; i++)
     {
-      if (entry->fValues[i])
+      if (fChunkSize == 0 && entry->fChunkSize == 0)
       {
-	if (!fValues[i])
-	  fValues[i] = new TemplateArray(fNBins);
-      
-	for (Long64_t l = 0; l<fNBins; l++)
-	  fValues[i]->GetArray()[l] += entry->fValues[i]->GetArray()[l];
+        if (entry->fValues[i])
+        {
+	  if (!fValues[i])
+	    fValues[i] = new TemplateArray(fNBins);
+        
+	  for (Long64_t l = 0; l<fNBins; l++)
+	    fValues[i]->GetArray()[l] += entry->fValues[i]->GetArray()[l];
+        }
+
+        if (entry->fSumw2[i])
+        {
+	  if (!fSumw2[i])
+	    fSumw2[i] = new TemplateArray(fNBins);
+        
+	  for (Long64_t l = 0; l<fNBins; l++)
+	    fSumw2[i]->GetArray()[l] += entry->fSumw2[i]->GetArray()[l];
+        }
+        continue;
       }
 
-      if (entry->fSumw2[i])
+      if (!entry->fValues[i])
+        continue;
+
+      // chunked storage: only the blocks allocated in <entry> are merged
+      // (bin by bin if the two objects use different storage modes)
+      Long64_t blockSize = (entry->fChunkSize > 0) ? entry->fChunkSize : fNBins;
+      Long64_t nBlocks = (fNBins + blockSize - 1) / blockSize;
+      for (Long64_t b = 0; b<nBlocks; b++)
       {
-	if (!fSumw2[i])
-	  fSumw2[i] = new TemplateArray(fNBins);
-      
-	for (Long64_t l = 0; l<fNBins; l++)
-	  fSumw2[i]->GetArray()[l] += entry->fSumw2[i]->GetArray()[l];
+        Long64_t first = b * blockSize;
+        Long64_t sourceIndex = entry->GetStorageIndex(i, first, kFALSE);
+        if (sourceIndex < 0)
+          continue;
+        Long64_t last = TMath::Min(first + blockSize, fNBins);
+
+        for (Long64_t l = first; l<last; l++)
+        {
+          const TemplateType value = entry->fValues[i]->GetArray()[sourceIndex + l - first];
+          const TemplateType sumw2 = entry->fSumw2[i] ? entry->fSumw2[i]->GetArray()[sourceIndex + l - first] : 0;
+          if (value == 0 && sumw2 == 0)
+            continue;
+
+          Long64_t targetIndex = GetStorageIndex(i, l, kTRUE);
+          if (entry->fSumw2[i] && !fSumw2[i])
+            fSumw2[i] = new TemplateArray(fValues[i]->GetSize());
+          fValues[i]->GetArray()[targetIndex] += value;
+          if (entry->fSumw2[i])
+            fSumw2[i]->GetArray()[targetIndex] += sumw2;
+        }
       }
     }
     
@@ -282,64 +432,146 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 }
 
 template <class TemplateArray, typename TemplateType>
-void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+void AliTHnT<TemplateArray, TemplateType>::InitAxisCache()
 {
-  // fills an entry
+  // caches the axes and selects the bin lookup per axis:
+  //   fixed bins: arithmetic as in TAxis::FindBin
+  //   equidistant bin edges (e.g. from SetBinLimits with an array): arithmetic guess corrected with the edges
+  //   variable bin edges: binary search without data dependent branches
 
-  // fill axis cache
-  if (!axisCache)
+  DeleteAxisCache();
+
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  fBinLookup = new Int_t[fNVars];
+  fAxisMin = new Double_t[fNVars];
+  fAxisMax = new Double_t[fNVars];
+  fAxisEdges = new const Double_t*[fNVars];
+
+  for (Int_t i=0; i<fNVars; i++)
   {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
-    
-    fLastVars = new Double_t[fNVars];
-    fLastBins = new Int_t[fNVars];
-    
-    // initial values to prevent checking for 0 below
-    for (Int_t i=0; i<fNVars; i++)
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+    fAxisMin[i] = axisCache[i]->GetXmin();
+    fAxisMax[i] = axisCache[i]->GetXmax();
+    fAxisEdges[i] = 0;
+    fBinLookup[i] = kFixedBins;
+
+    if (axisCache[i]->GetXbins()->GetSize() == 0)
+      continue;
+
+    fAxisEdges[i] = axisCache[i]->GetXbins()->GetArray();
+    fBinLookup[i] = kEquidistantEdges;
+    const Double_t width = (fAxisMax[i] - fAxisMin[i]) / fNbinsCache[i];
+    for (Int_t j=0; j<fNbinsCache[i]; j++)
     {
-      fLastBins[i] = axisCache[i]->FindBin(var[i]);
-      fLastVars[i] = var[i];
+      if (TMath::Abs(fAxisEdges[i][j+1] - fAxisEdges[i][j] - width) > 1e-6 * width)
+      {
+        fBinLookup[i] = kVariableEdges;
+        break;
+      }
     }
   }
-  
-  // calculate global bin index
-  Long64_t bin = 0;
-  for (Int_t i=0; i<fNVars; i++)
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::DeleteAxisCache()
+{
+  // deletes the axis cache, it is rebuilt at the next fill
+
+  delete[] axisCache;
+  delete[] fNbinsCache;
+  delete[] fBinLookup;
+  delete[] fAxisMin;
+  delete[] fAxisMax;
+  delete[] fAxisEdges;
+
+  axisCache = 0;
+  fNbinsCache = 0;
+  fBinLookup = 0;
+  fAxisMin = 0;
+  fAxisMax = 0;
+  fAxisEdges = 0;
+}
+
+template <class TemplateArray, typename TemplateType>
+Int_t AliTHnT<TemplateArray, TemplateType>::FindAxisBin(Int_t axis, Double_t x) const
+{
+  // returns the bin of <x> on axis <axis>, same result as TAxis::FindBin
+  // (0 for underflow, nbins+1 for overflow)
+
+  const Int_t nBins = fNbinsCache[axis];
+  const Double_t min = fAxisMin[axis];
+  const Double_t max = fAxisMax[axis];
+
+  if (x < min)
+    return 0;
+  if (!(x < max))
+    return nBins + 1;
+
+  if (fBinLookup[axis] == kFixedBins)
+    return 1 + Int_t(nBins * (x - min) / (max - min));
+
+  const Double_t* edges = fAxisEdges[axis];
+  if (fBinLookup[axis] == kEquidistantEdges)
   {
-    bin *= fNbinsCache[i];
-    
-    Int_t tmpBin = 0;
-    if (fLastVars[i] == var[i])
-      tmpBin = fLastBins[i];
-    else
-    {
-      tmpBin = axisCache[i]->FindBin(var[i]);
-      fLastBins[i] = tmpBin;
-      fLastVars[i] = var[i];
-    }
-    //Printf("%d", tmpBin);
+    // the guess is off by at most one bin, the edges decide
+    Int_t bin = Int_t(nBins * (x - min) / (max - min));
+    if (bin > nBins - 1)
+      bin = nBins - 1;
+    if (bin > 0 && edges[bin] > x)
+      bin--;
+    else if (bin < nBins - 1 && edges[bin+1] <= x)
+      bin++;
+    return bin + 1;
+  }
 
-    // under/overflow not supported
-    if (tmpBin < 1 || tmpBin > fNbinsCache[i])
-      return;
-    
-    // bins start from 0 here
-    bin += tmpBin - 1;
-//     Printf("%lld", bin);
+  // last edge <= x, the loop count only depends on the number of bins
+  const Double_t* base = edges;
+  Int_t length = nBins;
+  while (length > 1)
+  {
+    const Int_t half = length / 2;
+    base = (base[half] <= x) ? base + half : base;
+    length -= half;
   }
+  return (Int_t) (base - edges) + 1;
+}
 
-  if (!fValues[istep])
+template <class TemplateArray, typename TemplateType>
+Long64_t AliTHnT<TemplateArray, TemplateType>::FindGlobalBin(const Double_t* var) const
+{
+  // calculates the global bin index of <var>, -1 if one of the values is outside of the axis range
+  // (under/overflow not supported), bins start from 0 here
+
+  Long64_t bin = 0;
+  for (Int_t i=0; i<fNVars; i++)
   {
-    fValues[istep] = new TemplateArray(fNBins);
-    AliInfo(Form("Created values container for step %d", istep));
+    const Int_t tmpBin = FindAxisBin(i, var[i]);
+    if (tmpBin < 1 || tmpBin > fNbinsCache[i])
+      return -1;
+    bin = bin * fNbinsCache[i] + tmpBin - 1;
   }
 
+  return bin;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry
+
+  // fill axis cache
+  if (!axisCache)
+    InitAxisCache();
+  
+  // calculate global bin index
+  Long64_t bin = FindGlobalBin(var);
+  if (bin < 0)
+    return;
+
+  Long64_t index = GetStorageIndex(istep, bin, kTRUE);
+
   if (weight != 1)
   {
     // initialize with already filled entries (which have been filled with weight == 1), in this case fSumw2 := fValues
@@ -350,9 +582,9 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
     }
   }
 
-  fValues[istep]->GetArray()[bin] += weight;
+  fValues[istep]->GetArray()[index] += weight;
   if (fSumw2[istep])
-    fSumw2[istep]->GetArray()[bin] += weight * weight;
+    fSumw2[istep]->GetArray()[index] += weight * weight;
   
 //   Printf("%f", fValues[istep][bin]);
   
@@ -360,6 +592,64 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillN(Int_t nEntries, const Double_t *vars, const Double_t *weights, Int_t istep)
+{
+  // fills <nEntries> entries, the values of entry n are vars[n*nVars] ... vars[n*nVars+nVars-1]
+  // <weights> may be 0, then all entries are filled with weight 1
+  // same result as calling Fill for each entry: the global bins of a batch of entries are calculated
+  // axis by axis first, then the entries are added to the storage
+
+  if (!axisCache)
+    InitAxisCache();
+
+  const Int_t kBatchSize = 256;
+  Long64_t bins[kBatchSize];
+
+  for (Int_t first = 0; first < nEntries; first += kBatchSize)
+  {
+    const Int_t n = TMath::Min(kBatchSize, nEntries - first);
+    const Double_t* batchVars = vars + (Long64_t) first * fNVars;
+
+    for (Int_t k=0; k<n; k++)
+      bins[k] = 0;
+
+    // under/overflow entries are flagged with a negative bin
+    for (Int_t i=0; i<fNVars; i++)
+    {
+      const Int_t nBins = fNbinsCache[i];
+      for (Int_t k=0; k<n; k++)
+      {
+        const Int_t tmpBin = FindAxisBin(i, batchVars[(Long64_t) k * fNVars + i]);
+        if (tmpBin < 1 || tmpBin > nBins)
+          bins[k] = -1;
+        else if (bins[k] >= 0)
+          bins[k] = bins[k] * nBins + tmpBin - 1;
+      }
+    }
+
+    for (Int_t k=0; k<n; k++)
+    {
+      if (bins[k] < 0)
+        continue;
+
+      const Double_t weight = (weights) ? weights[first + k] : 1.;
+      Long64_t index = GetStorageIndex(istep, bins[k], kTRUE);
+
+      if (weight != 1 && !fSumw2[istep])
+      {
+        // see Fill
+        fSumw2[istep] = new TemplateArray(*fValues[istep]);
+        AliInfo(Form("Created sumw2 container for step %d", istep));
+      }
+
+      fValues[istep]->GetArray()[index] += weight;
+      if (fSumw2[istep])
+        fSumw2[istep]->GetArray()[index] += weight * weight;
+    }
+  }
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
@@ -412,11 +702,12 @@ void AliTHnT<TemplateArray, TemplateType>::FillContainer(AliCFContainer* cont)
       
       Long64_t globalBin = GetGlobalBinIndex(binIdx);
 //       Printf(" --> %lld", globalBin);
+      Long64_t index = GetStorageIndex(i, globalBin, kFALSE);
       
-      if (source[globalBin] != 0)
+      if (index >= 0 && source[index] != 0)
       {
-	target->SetBinContent(binIdx, source[globalBin]);
-	target->SetBinError(binIdx, TMath::Sqrt(sourceSumw2[globalBin]));
+	target->SetBinContent(binIdx, source[index]);
+	target->SetBinError(binIdx, TMath::Sqrt(sourceSumw2[index]));
 	
 	count++;
       }
@@ -464,11 +755,6 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
     if (!fValues[i])
       continue;
       
-    TemplateType* source = fValues[i]->GetArray();
-    TemplateType* sourceSumw2 = 0;
-    if (fSumw2[i])
-      sourceSumw2 = fSumw2[i]->GetArray();
-    
     THnSparse* target = GetGrid(i)->GetGrid();
     
     Int_t* binIdx = new Int_t[fNVars];
@@ -489,22 +775,28 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
       for (Int_t j=1; j<=nBins[axis]; j++)
       {
 	binIdx[axis] = j;
-	Long64_t globalBin = GetGlobalBinIndex(binIdx);
-	sumValues += source[globalBin];
-	source[globalBin] = 0;
+	Long64_t index = GetStorageIndex(i, GetGlobalBinIndex(binIdx), kFALSE);
+	if (index < 0)
+	  continue;
+	sumValues += fValues[i]->GetArray()[index];
+	fValues[i]->GetArray()[index] = 0;
 
-	if (sourceSumw2)
+	if (fSumw2[i])
 	{
-	  sumSumw2 += sourceSumw2[globalBin];
-	  sourceSumw2[globalBin] = 0;
+	  sumSumw2 += fSumw2[i]->GetArray()[index];
+	  fSumw2[i]->GetArray()[index] = 0;
 	}
       }
       binIdx[axis] = 1;
 	
-      Long64_t globalBin = GetGlobalBinIndex(binIdx);
-      source[globalBin] = sumValues;
-      if (sourceSumw2)
-	sourceSumw2[globalBin] = sumSumw2;
+      // (in the chunked storage this may allocate a block and reallocate the arrays)
+      Long64_t index = GetStorageIndex(i, GetGlobalBinIndex(binIdx), sumValues != 0 || sumSumw2 != 0);
+      if (index >= 0)
+      {
+	fValues[i]->GetArray()[index] = sumValues;
+	if (fSumw2[i])
+	  fSumw2[i]->GetArray()[index] = sumSumw2;
+      }
 
       count++;
 
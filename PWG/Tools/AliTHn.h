@@ -9,6 +9,9 @@
 // Use AliTHn instead of AliCFContainer and your memory consumption will be drastically reduced
 // As AliTHn derives from AliCFContainer, you can just replace your current AliCFContainer object by AliTHn
 // Once you have the merged output, call FillParent() and you can use AliCFContainer as usual
+//
+// With SetChunkSize(n) the bins are stored in blocks of n bins which are only allocated
+// when a bin inside them is filled (instead of one array of all bins per step)
 
 #include "TObject.h"
 #include "TString.h"
@@ -17,6 +20,7 @@
 class TArray;
 class TArrayF;
 class TArrayD;
+class TArrayI;
 class TCollection;
 
 class AliTHnBase : public AliCFContainer
@@ -48,11 +52,18 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  // fills nEntries entries, vars contains nEntries x nVars values, weights may be 0 (all weights 1)
+  void FillN(Int_t nEntries, const Double_t *vars, const Double_t *weights, Int_t istep);
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
+  // storage arrays, in blocks (see GetChunkSize) if chunked storage is used
   virtual TArray* GetValues(Int_t step) { return fValues[step]; }
   virtual TArray* GetSumw2(Int_t step)  { return fSumw2[step]; }
+
+  void SetChunkSize(Int_t chunkSize);
+  Int_t GetChunkSize() const { return fChunkSize; }
+  Long64_t GetNAllocatedBins(Int_t step) const;
   
   virtual void DeleteContainers();
   virtual void ReduceAxis();
@@ -66,19 +77,33 @@ class AliTHnT : public AliTHnBase
 protected:
   void Init();
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
+  void InitAxisCache();
+  void DeleteAxisCache();
+  Int_t FindAxisBin(Int_t axis, Double_t x) const;
+  Long64_t FindGlobalBin(const Double_t* var) const;
+  Long64_t GetNChunks() const { return (fNBins + fChunkSize - 1) / fChunkSize; }
+  Long64_t GetStorageIndex(Int_t istep, Long64_t bin, Bool_t create);
+  Int_t AllocateChunk(Int_t istep);
+  void CopyContainers(const AliTHnT& c);
   
   Long64_t fNBins;   // number of total bins
   Int_t    fNVars;   // number of variables
   Int_t    fNSteps;  // number of selection steps
   TemplateArray **fValues;  //[fNSteps] data container
   TemplateArray **fSumw2;   //[fNSteps] data container
+  Int_t    fChunkSize; // number of bins per storage block, 0 for dense storage
+  TArrayI **fChunkIndex; //[fNSteps] position of each block in the storage (-1 if not allocated), last element: number of allocated blocks
   
   TAxis** axisCache; //! cache axis pointers (about 50% of the time in Fill is spent in GetAxis otherwise)
   Int_t* fNbinsCache; //! cache Nbins per axis
-  Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
-  Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+  Int_t* fBinLookup; //! bin lookup per axis (see EBinLookup)
+  Double_t* fAxisMin; //! lower edge per axis
+  Double_t* fAxisMax; //! upper edge per axis
+  const Double_t** fAxisEdges; //! bin edges per axis, 0 for fixed bins
+  
+  enum EBinLookup { kFixedBins = 0, kEquidistantEdges, kVariableEdges };
   
-  ClassDef(AliTHnT, 5) // THn like container
+  ClassDef(AliTHnT, 6) // THn like container
 };
 
 typedef AliTHnT<TArrayF, Float_t> AliTHn;
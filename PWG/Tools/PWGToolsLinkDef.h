@@ -51,4 +51,6 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ function TestTHistManager::TestRunFillHandle();
+#pragma link C++ function TestTHistManager::TestRunFillNameVsHandle();
 #endif
@@ -15,7 +15,6 @@
 #include <cfloat>
 #include <cstring>
 #include <iostream>   // for unit tests
-#include <sstream>
 #include <string>
 #include <exception>
 #include <vector>
@@ -408,221 +407,90 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 	fHistos->Add(o);
 }
 
-void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
+template<typename HistType>
+HistType *THistManager::FindHistogram(const char *name, const char *method) const {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent){
-		Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-		return;
+		Fatal(method, "Parent group %s does not exist", dirname.Data());
+		return nullptr;
 	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
+	HistType *hist = dynamic_cast<HistType *>(parent->FindObject(hname));
 	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
+		Fatal(method, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		return nullptr;
 	}
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
-	  // use bin width as weight
-	  Int_t bin = hist->GetXaxis()->FindBin(x);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+	return hist;
+}
+
+UInt_t THistManager::DecodeBinWidthAxes(Option_t *opt, int ndim, bool axisnames) {
+	TString optstring(opt);
+	if(!optstring.Contains("w")) return 0;
+	if(axisnames && ndim == 1) return 1;    // 1D histograms: w is sufficient
+	const char *axisname[3] = {"x", "y", "z"};
+	UInt_t axes(0);
+	for(int iaxis = 0; iaxis < ndim && iaxis < 32; iaxis++){
+		TString weighthandler = axisnames ? Form("w%s", axisname[iaxis]) : Form("w%d", iaxis);
+		if(optstring.Contains(weighthandler)) axes |= (1u << iaxis);
 	}
-	hist->Fill(x, weight);
+	return axes;
+}
+
+void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
+	GetTH1Handle(name, opt).Fill(x, weight);
 }
 
 void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
-	  // use bin width as weight
-	  // get bin for label
-	  Int_t bin = hist->GetXaxis()->FindBin(label);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
-	}
-  hist->Fill(label, weight);
+	GetTH1Handle(name, opt).Fill(label, weight);
 }
 
 void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(x, y, myweight);
+	GetTH2Handle(name, opt).Fill(x, y, weight);
 }
 
 void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(point[0], point[1], weight);
+	GetTH2Handle(name, opt).Fill(point[0], point[1], weight);
 }
 
 void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-  if(!hist){
-    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-    return;
-  }
-  TString optstring(opt);
-  Double_t myweight = optstring.Contains("w") ? 1. : weight;
-  if(optstring.Contains("wx")){
-    Int_t binx = hist->GetXaxis()->FindBin(labelY);
-    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-  }
-  if(optstring.Contains("wy")){
-    Int_t biny = hist->GetYaxis()->FindBin(labelX);
-    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-  }
-  hist->Fill(labelX, labelY, weight);
+	GetTH2Handle(name, opt).Fill(labelX, labelY, weight);
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(z);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
-	hist->Fill(x, y, z, weight);
+	GetTH3Handle(name, opt).Fill(x, y, z, weight);
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
-	hist->Fill(point[0], point[1], point[2], weight);
+	GetTH3Handle(name, opt).Fill(point[0], point[1], point[2], weight);
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
-	  std::stringstream weighthandler;
-	  weighthandler << "w" << iaxis;
-	  if(optstring.Contains(weighthandler.str().c_str())){
-	    Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
-	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
-	  }
-	}
-
-	hist->Fill(x, weight);
+	GetTHnSparseHandle(name, opt).Fill(x, weight);
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
-  if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-  hist->Fill(x, y, weight);
+  GetTProfileHandle(name).Fill(x, y, weight);
+}
+
+THistManager::TH1Handle THistManager::GetTH1Handle(const char *name, Option_t *opt) const {
+  return TH1Handle(FindHistogram<TH1>(name, "THistManager::GetTH1Handle"), DecodeBinWidthAxes(opt, 1, true));
+}
+
+THistManager::TH2Handle THistManager::GetTH2Handle(const char *name, Option_t *opt) const {
+  return TH2Handle(FindHistogram<TH2>(name, "THistManager::GetTH2Handle"), DecodeBinWidthAxes(opt, 2, true));
+}
+
+THistManager::TH3Handle THistManager::GetTH3Handle(const char *name, Option_t *opt) const {
+  return TH3Handle(FindHistogram<TH3>(name, "THistManager::GetTH3Handle"), DecodeBinWidthAxes(opt, 3, true));
+}
+
+THistManager::THnSparseHandle THistManager::GetTHnSparseHandle(const char *name, Option_t *opt) const {
+  THnSparse *hist = FindHistogram<THnSparse>(name, "THistManager::GetTHnSparseHandle");
+  return THnSparseHandle(hist, hist ? DecodeBinWidthAxes(opt, hist->GetNdimensions(), false) : 0);
+}
+
+THistManager::TProfileHandle THistManager::GetTProfileHandle(const char *name) const {
+  return TProfileHandle(FindHistogram<TProfile>(name, "THistManager::GetTProfileHandle"));
 }
 
 TObject *THistManager::FindObject(const char *name) const {
@@ -659,6 +527,82 @@ TString THistManager::histname(const TString &path) const {
 	return TString(path(index+1, path.Length() - (index+1)));
 }
 
+//////////////////////////////////////////////////////////
+///                                                    ///
+/// Implementation of THistManager fill handles        ///
+///                                                    ///
+//////////////////////////////////////////////////////////
+
+namespace {
+  /**
+   * Get the weight correcting for the width of the bin the value falls into
+   * (1 in case the value is in the underflow or overflow bin)
+   */
+  double BinWidthCorrection(const TAxis *axis, double x) {
+    Int_t bin = axis->FindBin(x);
+    if(bin < 1 || bin > axis->GetNbins()) return 1.;
+    return 1./axis->GetBinWidth(bin);
+  }
+
+  /**
+   * Same as above for the bin with a given label
+   */
+  double BinWidthCorrection(TAxis *axis, const char *label) {
+    Int_t bin = axis->FindBin(label);
+    if(bin < 1 || bin > axis->GetNbins()) return 1.;
+    return 1./axis->GetBinWidth(bin);
+  }
+}
+
+void THistManager::TH1Handle::Fill(double x, double weight) const {
+  if(fBinWidthAxes) weight *= BinWidthCorrection(fHistogram->GetXaxis(), x);
+  fHistogram->Fill(x, weight);
+}
+
+void THistManager::TH1Handle::Fill(const char *label, double weight) const {
+  if(fBinWidthAxes) weight *= BinWidthCorrection(fHistogram->GetXaxis(), label);
+  fHistogram->Fill(label, weight);
+}
+
+void THistManager::TH2Handle::Fill(double x, double y, double weight) const {
+  if(fBinWidthAxes){
+    if(fBinWidthAxes & 1) weight *= BinWidthCorrection(fHistogram->GetXaxis(), x);
+    if(fBinWidthAxes & 2) weight *= BinWidthCorrection(fHistogram->GetYaxis(), y);
+  }
+  fHistogram->Fill(x, y, weight);
+}
+
+void THistManager::TH2Handle::Fill(const char *labelX, const char *labelY, double weight) const {
+  if(fBinWidthAxes){
+    if(fBinWidthAxes & 1) weight *= BinWidthCorrection(fHistogram->GetXaxis(), labelX);
+    if(fBinWidthAxes & 2) weight *= BinWidthCorrection(fHistogram->GetYaxis(), labelY);
+  }
+  fHistogram->Fill(labelX, labelY, weight);
+}
+
+void THistManager::TH3Handle::Fill(double x, double y, double z, double weight) const {
+  if(fBinWidthAxes){
+    if(fBinWidthAxes & 1) weight *= BinWidthCorrection(fHistogram->GetXaxis(), x);
+    if(fBinWidthAxes & 2) weight *= BinWidthCorrection(fHistogram->GetYaxis(), y);
+    if(fBinWidthAxes & 4) weight *= BinWidthCorrection(fHistogram->GetZaxis(), z);
+  }
+  fHistogram->Fill(x, y, z, weight);
+}
+
+void THistManager::THnSparseHandle::Fill(const double *x, double weight) const {
+  if(fBinWidthAxes){
+    // the bitmap covers the first 32 axes (see DecodeBinWidthAxes)
+    for(Int_t iaxis = 0; iaxis < fHistogram->GetNdimensions() && iaxis < 32; iaxis++){
+      if(fBinWidthAxes & (1u << iaxis)) weight *= BinWidthCorrection(fHistogram->GetAxis(iaxis), x[iaxis]);
+    }
+  }
+  fHistogram->Fill(x, weight);
+}
+
+void THistManager::TProfileHandle::Fill(double x, double y, double weight) const {
+  fHistogram->Fill(x, y, weight);
+}
+
 //////////////////////////////////////////////////////////
 ///                                                    ///
 /// Implementation of THistManager::iterator           ///
@@ -1030,6 +974,183 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandleHistograms(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Test1", "Test handle 1D histogram", 1, 0., 1.);
+    testmgr.CreateTH1("Group1/TestWidth", "Test handle 1D histogram with bin width correction", 1, 0., 0.5);
+    testmgr.CreateTH2("Group1/Test2", "Test handle 2D histogram", 1, 0., 1., 1, 0., 1.);
+    testmgr.CreateTH3("Group2/Subgroup1/Test3", "Test handle 3D histogram", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    testmgr.CreateTHnSparse("Group2/TestN", "Test handle THnSparse", 4, nbins, min, max);
+    testmgr.CreateTProfile("TestProfile", "Test handle Profile histogram", 1, 0., 1.);
+
+    THistManager::TH1Handle h1 = testmgr.GetTH1Handle("Test1"),
+                            hwidth = testmgr.GetTH1Handle("Group1/TestWidth", "w");
+    THistManager::TH2Handle h2 = testmgr.GetTH2Handle("Group1/Test2");
+    THistManager::TH3Handle h3 = testmgr.GetTH3Handle("Group2/Subgroup1/Test3");
+    THistManager::THnSparseHandle hN = testmgr.GetTHnSparseHandle("Group2/TestN");
+    THistManager::TProfileHandle hProfile = testmgr.GetTProfileHandle("TestProfile");
+
+    bool success(true);
+    if(!(h1.IsValid() && hwidth.IsValid() && h2.IsValid() && h3.IsValid() && hN.IsValid() && hProfile.IsValid())){
+      std::cout << "Not all handles could be resolved" << std::endl;
+      return 1;
+    }
+    if(h1.GetHistogram() != testmgr.FindObject("Test1") || h2.GetHistogram() != testmgr.FindObject("Group1/Test2")
+       || h3.GetHistogram() != testmgr.FindObject("Group2/Subgroup1/Test3") || hN.GetHistogram() != testmgr.FindObject("Group2/TestN")
+       || hProfile.GetHistogram() != testmgr.FindObject("TestProfile")){
+      std::cout << "Handle connected to wrong histogram" << std::endl;
+      return 1;
+    }
+
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 100; i++){
+      h1.Fill(0.5);
+      hwidth.Fill(0.25);
+      h2.Fill(0.5, 0.5);
+      h3.Fill(0.5, 0.5, 0.5);
+      hN.Fill(point);
+      hProfile.Fill(0.5, 1.);
+    }
+
+    if(TMath::Abs(h1.GetHistogram()->GetBinContent(1) - 100) > DBL_EPSILON){
+      std::cout << "Test1: Mismatch in values, expected 100, found " <<  h1.GetHistogram()->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hwidth.GetHistogram()->GetBinContent(1) - 200) > 1e-9){
+      std::cout << "Group1/TestWidth: Mismatch in values, expected 200, found " <<  hwidth.GetHistogram()->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h2.GetHistogram()->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test2: Mismatch in values, expected 100, found " <<  h2.GetHistogram()->GetBinContent(1, 1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h3.GetHistogram()->GetBinContent(1, 1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group2/Subgroup1/Test3: Mismatch in values, expected 100, found " <<  h3.GetHistogram()->GetBinContent(1, 1, 1) << std::endl;
+      success = false;
+    }
+    int index[4] = {1,1,1,1};
+    if(TMath::Abs(hN.GetHistogram()->GetBinContent(index) - 100) > DBL_EPSILON){
+      std::cout << "Group2/TestN: Mismatch in values, expected 100, found " <<  hN.GetHistogram()->GetBinContent(index) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hProfile.GetHistogram()->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "TestProfile: Mismatch in values, expected 1, found " <<  hProfile.GetHistogram()->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
+  int THistManagerTestSuite::TestFillNameVsHandleHistograms(){
+    THistManager testmgr("testmgr");
+
+    const char *groups[2] = {"ByName", "ByHandle"};
+    const char *labelsx[3] = {"a", "b", "c"}, *labelsy[3] = {"y0", "y1", "y2"};
+    for(int igroup = 0; igroup < 2; igroup++){
+      TString group(groups[igroup]);
+      testmgr.CreateTH1(group + "/h1", "1D histogram", 4, 0., 2.);
+      testmgr.CreateTH1(group + "/h1width", "1D histogram with bin width correction", 4, 0., 2.);
+      TH1 *labelhist1D = testmgr.CreateTH1(group + "/h1label", "1D histogram with bin labels", 3, 0., 1.5);
+      testmgr.CreateTH2(group + "/h2x", "2D histogram with bin width correction in x", 4, 0., 2., 5, 0., 10.);
+      testmgr.CreateTH2(group + "/h2xy", "2D histogram with bin width correction in x and y", 4, 0., 2., 5, 0., 10.);
+      TH2 *labelhist2D = testmgr.CreateTH2(group + "/h2label", "2D histogram with bin labels", 3, 0., 1.5, 3, 0., 6.);
+      testmgr.CreateTH3(group + "/h3", "3D histogram with bin width correction in x and z", 4, 0., 2., 5, 0., 10., 2, 0., 1.);
+      int nbins[3] = {4, 5, 2}; double min[3] = {0., 0., 0.}, max[3] = {2., 10., 1.};
+      testmgr.CreateTHnSparse(group + "/hN", "THnSparse with bin width correction on axis 0 and 2", 3, nbins, min, max);
+      testmgr.CreateTProfile(group + "/hProfile", "Profile histogram", 4, 0., 2.);
+      for(int ilabel = 0; ilabel < 3; ilabel++){
+        labelhist1D->GetXaxis()->SetBinLabel(ilabel + 1, labelsx[ilabel]);
+        labelhist2D->GetXaxis()->SetBinLabel(ilabel + 1, labelsx[ilabel]);
+        labelhist2D->GetYaxis()->SetBinLabel(ilabel + 1, labelsy[ilabel]);
+      }
+    }
+
+    THistManager::TH1Handle h1 = testmgr.GetTH1Handle("ByHandle/h1"),
+                            h1width = testmgr.GetTH1Handle("ByHandle/h1width", "w"),
+                            h1label = testmgr.GetTH1Handle("ByHandle/h1label", "w");
+    THistManager::TH2Handle h2x = testmgr.GetTH2Handle("ByHandle/h2x", "wx"),
+                            h2xy = testmgr.GetTH2Handle("ByHandle/h2xy", "wxwy"),
+                            h2label = testmgr.GetTH2Handle("ByHandle/h2label", "wy");
+    THistManager::TH3Handle h3 = testmgr.GetTH3Handle("ByHandle/h3", "wxwz");
+    THistManager::THnSparseHandle hN = testmgr.GetTHnSparseHandle("ByHandle/hN", "w0w2");
+    THistManager::TProfileHandle hProfile = testmgr.GetTProfileHandle("ByHandle/hProfile");
+
+    // Values cover underflow, all bins including the last one, and overflow
+    for(int i = 0; i < 30; i++){
+      double x = -0.25 + 0.09 * i, y = -1. + 0.45 * i, z = -0.1 + 0.045 * i, weight = 1 + i % 3;
+      double point[3] = {x, y, z};
+      const char *labelx = labelsx[i % 3], *labely = labelsy[(i / 3) % 3];
+
+      testmgr.FillTH1("ByName/h1", x, weight);
+      testmgr.FillTH1("ByName/h1width", x, weight, "w");
+      testmgr.FillTH1("ByName/h1label", labelx, weight, "w");
+      testmgr.FillTH2("ByName/h2x", x, y, weight, "wx");
+      testmgr.FillTH2("ByName/h2xy", point, weight, "wxwy");
+      testmgr.FillTH2("ByName/h2label", labelx, labely, weight, "wy");
+      testmgr.FillTH3("ByName/h3", x, y, z, weight, "wxwz");
+      testmgr.FillTH3("ByName/h3", point, weight, "wxwz");
+      testmgr.FillTHnSparse("ByName/hN", point, weight, "w0w2");
+      testmgr.FillProfile("ByName/hProfile", x, y, weight);
+
+      h1.Fill(x, weight);
+      h1width.Fill(x, weight);
+      h1label.Fill(labelx, weight);
+      h2x.Fill(x, y, weight);
+      h2xy.Fill(point[0], point[1], weight);
+      h2label.Fill(labelx, labely, weight);
+      h3.Fill(x, y, z, weight);
+      h3.Fill(point[0], point[1], point[2], weight);
+      hN.Fill(point, weight);
+      hProfile.Fill(x, y, weight);
+    }
+
+    bool success(true);
+    const char *histnames[8] = {"h1", "h1width", "h1label", "h2x", "h2xy", "h2label", "h3", "hProfile"};
+    for(int ihist = 0; ihist < 8; ihist++){
+      TH1 *byname = static_cast<TH1 *>(testmgr.FindObject(Form("ByName/%s", histnames[ihist]))),
+          *byhandle = static_cast<TH1 *>(testmgr.FindObject(Form("ByHandle/%s", histnames[ihist])));
+      for(int ibin = 0; ibin < byname->GetNcells(); ibin++){
+        if(TMath::Abs(byname->GetBinContent(ibin) - byhandle->GetBinContent(ibin)) > 1e-9){
+          std::cout << histnames[ihist] << ": Mismatch in bin " << ibin << ", by name " << byname->GetBinContent(ibin)
+                    << ", by handle " << byhandle->GetBinContent(ibin) << std::endl;
+          success = false;
+        }
+      }
+    }
+    THnSparse *sparsebyname = static_cast<THnSparse *>(testmgr.FindObject("ByName/hN")),
+              *sparsebyhandle = static_cast<THnSparse *>(testmgr.FindObject("ByHandle/hN"));
+    if(sparsebyname->GetNbins() != sparsebyhandle->GetNbins()){
+      std::cout << "hN: Mismatch in number of filled bins, by name " << sparsebyname->GetNbins()
+                << ", by handle " << sparsebyhandle->GetNbins() << std::endl;
+      success = false;
+    }
+    for(Long64_t ibin = 0; ibin < sparsebyname->GetNbins(); ibin++){
+      int coord[3];
+      double content = sparsebyname->GetBinContent(ibin, coord);
+      if(TMath::Abs(content - sparsebyhandle->GetBinContent(coord)) > 1e-9){
+        std::cout << "hN: Mismatch in bin (" << coord[0] << "," << coord[1] << "," << coord[2] << "), by name " << content
+                  << ", by handle " << sparsebyhandle->GetBinContent(coord) << std::endl;
+        success = false;
+      }
+    }
+
+    // Bin width rule: the weight is multiplied with the inverse bin width,
+    // including the last bin, while underflow and overflow are not corrected
+    testmgr.CreateTH1("hRule", "1D histogram for the bin width rule", 4, 0., 2.);
+    testmgr.FillTH1("hRule", 0.25, 3., "w");
+    testmgr.FillTH1("hRule", 1.75, 3., "w");
+    testmgr.FillTH1("hRule", 2.5, 3., "w");
+    TH1 *hRule = static_cast<TH1 *>(testmgr.FindObject("hRule"));
+    if(TMath::Abs(hRule->GetBinContent(1) - 6.) > 1e-9 || TMath::Abs(hRule->GetBinContent(4) - 6.) > 1e-9
+       || TMath::Abs(hRule->GetBinContent(5) - 3.) > 1e-9){
+      std::cout << "hRule: Mismatch in values, expected 6, 6, 3, found " << hRule->GetBinContent(1) << ", "
+                << hRule->GetBinContent(4) << ", " << hRule->GetBinContent(5) << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1171,14 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handle" << std::endl;
+    testresult += testsuite.TestFillHandleHistograms();
+    std::cout << "Result after test: " << testresult << std::endl;
+
+    std::cout << "Running test: Fill by name vs. handle" << std::endl;
+    testresult += testsuite.TestFillNameVsHandleHistograms();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1201,14 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandle(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandleHistograms();
+  }
+
+  int TestRunFillNameVsHandle(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillNameVsHandleHistograms();
+  }
 }
@@ -229,6 +229,173 @@ public:
     iterator();
   };
 
+  /**
+   * @class TH1Handle
+   * @brief Pre-resolved fill handle for a 1D histogram
+   * @ingroup Histmanager
+   *
+   * Handles are obtained once from the histogram manager (i.e. in
+   * UserCreateOutputObjects) via GetTH1Handle and can afterwards be
+   * filled without any parsing of the histogram path, hash lookup
+   * or type check. Options for the bin width correction are evaluated
+   * once when the handle is created.
+   *
+   * ~~~{.cxx}
+   * THistManager::TH1Handle hPt = mgr.GetTH1Handle("tracks/hPt");
+   * for(auto t : tracks) hPt.Fill(t->Pt());
+   * ~~~
+   */
+  class TH1Handle {
+  public:
+    TH1Handle(): fHistogram(nullptr), fBinWidthAxes(0) {}
+    TH1Handle(TH1 *hist, UInt_t binwidthaxes): fHistogram(hist), fBinWidthAxes(binwidthaxes) {}
+    ~TH1Handle() {}
+
+    Bool_t IsValid() const { return fHistogram != nullptr; }
+    TH1 *GetHistogram() const { return fHistogram; }
+
+    /**
+     * @brief Fill the histogram.
+     * @param[in] x x-coordinate
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(double x, double weight = 1.) const;
+
+    /**
+     * @brief Fill the bin with a given label.
+     * @param[in] label Label of the bin to fill
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(const char *label, double weight = 1.) const;
+
+  private:
+    TH1                         *fHistogram;          ///< Histogram connected to the handle (not owned)
+    UInt_t                      fBinWidthAxes;        ///< Axes for which the bin width correction is applied (bitmap)
+  };
+
+  /**
+   * @class TH2Handle
+   * @brief Pre-resolved fill handle for a 2D histogram
+   * @ingroup Histmanager
+   *
+   * See @ref TH1Handle for details.
+   */
+  class TH2Handle {
+  public:
+    TH2Handle(): fHistogram(nullptr), fBinWidthAxes(0) {}
+    TH2Handle(TH2 *hist, UInt_t binwidthaxes): fHistogram(hist), fBinWidthAxes(binwidthaxes) {}
+    ~TH2Handle() {}
+
+    Bool_t IsValid() const { return fHistogram != nullptr; }
+    TH2 *GetHistogram() const { return fHistogram; }
+
+    /**
+     * @brief Fill the histogram.
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(double x, double y, double weight = 1.) const;
+
+    /**
+     * @brief Fill the bin with given labels.
+     * @param[in] labelX Label of the bin on the x-axis
+     * @param[in] labelY Label of the bin on the y-axis
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(const char *labelX, const char *labelY, double weight = 1.) const;
+
+  private:
+    TH2                         *fHistogram;          ///< Histogram connected to the handle (not owned)
+    UInt_t                      fBinWidthAxes;        ///< Axes for which the bin width correction is applied (bitmap)
+  };
+
+  /**
+   * @class TH3Handle
+   * @brief Pre-resolved fill handle for a 3D histogram
+   * @ingroup Histmanager
+   *
+   * See @ref TH1Handle for details.
+   */
+  class TH3Handle {
+  public:
+    TH3Handle(): fHistogram(nullptr), fBinWidthAxes(0) {}
+    TH3Handle(TH3 *hist, UInt_t binwidthaxes): fHistogram(hist), fBinWidthAxes(binwidthaxes) {}
+    ~TH3Handle() {}
+
+    Bool_t IsValid() const { return fHistogram != nullptr; }
+    TH3 *GetHistogram() const { return fHistogram; }
+
+    /**
+     * @brief Fill the histogram.
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     * @param[in] z z-coordinate
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(double x, double y, double z, double weight = 1.) const;
+
+  private:
+    TH3                         *fHistogram;          ///< Histogram connected to the handle (not owned)
+    UInt_t                      fBinWidthAxes;        ///< Axes for which the bin width correction is applied (bitmap)
+  };
+
+  /**
+   * @class THnSparseHandle
+   * @brief Pre-resolved fill handle for a THnSparse
+   * @ingroup Histmanager
+   *
+   * See @ref TH1Handle for details.
+   */
+  class THnSparseHandle {
+  public:
+    THnSparseHandle(): fHistogram(nullptr), fBinWidthAxes(0) {}
+    THnSparseHandle(THnSparse *hist, UInt_t binwidthaxes): fHistogram(hist), fBinWidthAxes(binwidthaxes) {}
+    ~THnSparseHandle() {}
+
+    Bool_t IsValid() const { return fHistogram != nullptr; }
+    THnSparse *GetHistogram() const { return fHistogram; }
+
+    /**
+     * @brief Fill the histogram.
+     * @param[in] x coordinates of the data
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(const double *x, double weight = 1.) const;
+
+  private:
+    THnSparse                   *fHistogram;          ///< Histogram connected to the handle (not owned)
+    UInt_t                      fBinWidthAxes;        ///< Axes for which the bin width correction is applied (bitmap)
+  };
+
+  /**
+   * @class TProfileHandle
+   * @brief Pre-resolved fill handle for a profile histogram
+   * @ingroup Histmanager
+   *
+   * See @ref TH1Handle for details.
+   */
+  class TProfileHandle {
+  public:
+    TProfileHandle(): fHistogram(nullptr) {}
+    TProfileHandle(TProfile *hist): fHistogram(hist) {}
+    ~TProfileHandle() {}
+
+    Bool_t IsValid() const { return fHistogram != nullptr; }
+    TProfile *GetHistogram() const { return fHistogram; }
+
+    /**
+     * @brief Fill the profile histogram.
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(double x, double y, double weight = 1.) const;
+
+  private:
+    TProfile                    *fHistogram;          ///< Histogram connected to the handle (not owned)
+  };
+
   /**
    * @brief Default constructor.
    *
@@ -530,7 +697,10 @@ public:
 	 * @brief Fill a 1D histogram within the container.
 	 *
 	 * The histogram name also contains the parent group(s)
-	 * according to the common group notation.
+	 * according to the common group notation. The histogram is
+	 * resolved into a @ref TH1Handle, so the bin width correction
+	 * (option "w") is applied as for the fill handles. The same holds
+	 * for all other name-based fill functions.
 	 * @param[in] name Name of the histogram
 	 * @param[in] x x-coordinate
 	 * @param[in] weight optional weight of the entry (default 1)
@@ -634,6 +804,59 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Resolve a 1D histogram into a fill handle.
+   *
+   * The path is parsed and the histogram is looked up only once,
+   * subsequent fills via the handle do not access the container
+   * anymore. Bin width correction options (see FillTH1) are applied
+   * to all fills via the handle. The handle is valid as long as the
+   * histogram manager owning the histogram is alive.
+   * @param[in] name Name of the histogram
+   * @param[in] opt Optional filling arguments
+   * @return Handle connected to the histogram
+   */
+  TH1Handle GetTH1Handle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Resolve a 2D histogram into a fill handle.
+   *
+   * See @ref GetTH1Handle for details.
+   * @param[in] name Name of the histogram
+   * @param[in] opt Optional filling arguments
+   * @return Handle connected to the histogram
+   */
+  TH2Handle GetTH2Handle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Resolve a 3D histogram into a fill handle.
+   *
+   * See @ref GetTH1Handle for details.
+   * @param[in] name Name of the histogram
+   * @param[in] opt Optional filling arguments
+   * @return Handle connected to the histogram
+   */
+  TH3Handle GetTH3Handle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Resolve a THnSparse into a fill handle.
+   *
+   * See @ref GetTH1Handle for details.
+   * @param[in] name Name of the histogram
+   * @param[in] opt Optional filling arguments
+   * @return Handle connected to the histogram
+   */
+  THnSparseHandle GetTHnSparseHandle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Resolve a profile histogram into a fill handle.
+   *
+   * See @ref GetTH1Handle for details.
+   * @param[in] name Name of the profile histogram
+   * @return Handle connected to the histogram
+   */
+  TProfileHandle GetTProfileHandle(const char *name) const;
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -705,6 +928,30 @@ private:
 	 */
 	THashList *FindGroup(const char *dirname) const;
 
+	/**
+	 * @brief Find histogram of a given type for filling.
+	 *
+	 * Aborts with a fatal error in case the parent group or
+	 * the histogram with the requested type does not exist.
+	 * @param[in] name Path of the histogram
+	 * @param[in] method Name of the calling method (for the error message)
+	 * @return Histogram found in the container
+	 */
+	template<typename HistType>
+	HistType *FindHistogram(const char *name, const char *method) const;
+
+	/**
+	 * @brief Decode the bin width correction options into a bitmap of axes.
+	 *
+	 * Supported are the axis names x, y, z (w, wx, wy, wz) as well as
+	 * the axis index (w0, w1, ...).
+	 * @param[in] opt Fill options
+	 * @param[in] ndim Number of dimensions of the histogram
+	 * @param[in] axisnames Use axis names instead of axis indices
+	 * @return Bitmap of axes for which the bin width correction is applied
+	 */
+	static UInt_t DecodeBinWidthAxes(Option_t *opt, int ndim, bool axisnames);
+
 	/**
 	 * @brief Extracting the basename from a given histogram path.
 	 * @param[in] path histogram path
@@ -762,6 +1009,8 @@ namespace TestTHistManager {
  * - Build histrogram in groups
  * - Simple fill
  * - Fill histograms in groups
+ * - Fill histograms via handles
+ * - Fill histograms by name and via handles with identical results
  */
 class THistManagerTestSuite {
 public:
@@ -845,6 +1094,43 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether fill handles are resolved correctly and
+   * whether fills via handles are propagated to the histograms in the container
+   * Relies on: TestFillSimpleHistograms, TestFillGroupedHistograms
+   *
+   * Creating histograms of all types, partly in groups, with 1 bin per
+   * dimension, resolving a handle for each of them and filling each
+   * handle 100 times. In addition a TH1 with bin width 0.5 is filled
+   * 100 times via a handle with bin width correction.
+   *
+   * Test passed:
+   * - All handles are valid and connected to the histogram in the container
+   * - All histograms have the expected value (100 for histograms, 1 for profile,
+   *   200 for the histogram with bin width correction)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandleHistograms();
+
+  /**
+   * Purpose of the test: Check whether the name-based fill functions and the
+   * fill handles give identical results, in particular for the bin width correction
+   * Relies on: TestFillHandleHistograms
+   *
+   * Creating the same set of histograms of all types in two groups, with
+   * several bins per dimension, bin labels, and with and without bin width
+   * correction on different axes. One group is filled by name, the other one
+   * via handles, with the same weighted values covering underflow, all bins
+   * and overflow. In addition a TH1 is filled by name with bin width correction.
+   *
+   * Test passed:
+   * - All bins of the histograms filled by name and via handles agree
+   * - The weight is multiplied by the inverse bin width, for all bins including
+   *   the last one, but not for underflow and overflow
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillNameVsHandleHistograms();
 };
 
 /**
@@ -882,5 +1168,19 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandle();
+
+/**
+ * Run the test comparing fills by name and via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillNameVsHandle();
+
 }
 #endif
@@ -574,512 +574,531 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   //
   // if mixed is non-0, mixed events are filled, the trigger particle is from particles, the associated from mixed
   // if weight < 0, then the pt of the associated particle is filled as weight
+  //
+  // the particles are converted into structure-of-arrays batches (see FillParticleBatch) which are then processed
+  // by the batch version of FillCorrelations
   
-  Bool_t fillpT = kFALSE;
-  if (weight < 0)
-    fillpT = kTRUE;
+  ParticleBatch particleBatch;
+  FillParticleBatch(particles, particleBatch, centrality, zVtx, applyEfficiency);
   
-  if (twoTrackEfficiencyCut && !fTwoTrackDistancePt[0])
+  if (!mixed)
   {
-    // do not add this hists to the directory
-    Bool_t oldStatus = TH1::AddDirectoryStatus();
-    TH1::AddDirectory(kFALSE);
+    FillCorrelations(centrality, zVtx, step, particleBatch, 0, weight, firstTime, twoTrackEfficiencyCut, bSign, twoTrackEfficiencyCutValue);
+    return;
+  }
+  
+  ParticleBatch mixedBatch;
+  FillParticleBatch(mixed, mixedBatch, centrality, zVtx, applyEfficiency);
+  FillCorrelations(centrality, zVtx, step, particleBatch, &mixedBatch, weight, firstTime, twoTrackEfficiencyCut, bSign, twoTrackEfficiencyCutValue);
+}
 
-    fTwoTrackDistancePt[0] = new TH3F("fTwoTrackDistancePt[0]", ";#Delta#eta;#Delta#varphi^{*}_{min};#Delta p_{T}", 100, -0.15, 0.15, 100, -0.05, 0.05, 20, 0, 10);
-    fTwoTrackDistancePt[1] = (TH3F*) fTwoTrackDistancePt[0]->Clone("fTwoTrackDistancePt[1]");
+//____________________________________________________________________
+void AliUEHistograms::ParticleBatch::Resize(Int_t n)
+{
+  // resizes all arrays to n particles
+  
+  fPt.resize(n);
+  fEta.resize(n);
+  fPhi.resize(n);
+  fCharge.resize(n);
+  fEffTrigger.resize(n);
+  fEffAssociated.resize(n);
+  fIdentity.resize(n);
+  fEventIndex.resize(n);
+}
 
-    TH1::AddDirectory(oldStatus);
+//____________________________________________________________________
+void AliUEHistograms::FillParticleBatch(TObjArray* particles, ParticleBatch& batch, Double_t centrality, Float_t zVtx, Bool_t applyEfficiency) const
+{
+  // copies the kinematics of the AliVParticles in particles into batch
+  // the virtual getters as well as the efficiency lookups are called here once per particle instead of once per pair
+  //
+  // if applyEfficiency is set, the efficiency correction factors for the particle being used as trigger and as associated 
+  // particle are looked up in fEfficiencyCorrectionTriggers and fEfficiencyCorrectionAssociated
+  
+  const Int_t n = (particles) ? particles->GetEntriesFast() : 0;
+  batch.Resize(n);
+  
+  // the identity is taken from IsEqual, which is used by the per-pair comparison: particles which compare equal to
+  // another object with the same unique ID are identified by their unique ID (flagged with the highest bit),
+  // otherwise by the address of the object
+  const ULong64_t kUniqueIDIdentity = 1ULL << 63;
+  TObject uniqueIDProbe;
+  
+  for (Int_t i=0; i<n; i++)
+  {
+    AliVParticle* particle = (AliVParticle*) particles->UncheckedAt(i);
+    
+    batch.fPt[i] = particle->Pt();
+    batch.fEta[i] = particle->Eta();
+    batch.fPhi[i] = particle->Phi();
+    batch.fCharge[i] = particle->Charge();
+    
+    uniqueIDProbe.SetUniqueID(particle->GetUniqueID());
+    if (particle->IsEqual(&uniqueIDProbe))
+      batch.fIdentity[i] = kUniqueIDIdentity | particle->GetUniqueID();
+    else
+      batch.fIdentity[i] = (ULong64_t) particle;
+    
+    batch.fEventIndex[i] = -1;
+    if (fCheckEventNumberInCorrelation)
+    {
+      AliBasicParticle* particleBasic = dynamic_cast<AliBasicParticle*>(particle);
+      if (!particleBasic)
+        AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
+      else
+        batch.fEventIndex[i] = particleBasic->GetEventIndex();
+    }
+    
+    batch.fEffTrigger[i] = 1;
+    batch.fEffAssociated[i] = 1;
+    if (!applyEfficiency)
+      continue;
+    
+    if (fEfficiencyCorrectionTriggers)
+    {
+      Int_t effVars[4];
+      effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(batch.fEta[i]);
+      effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(batch.fPt[i]);
+      effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(centrality);
+      effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin((Double_t) zVtx);
+      batch.fEffTrigger[i] = fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+    }
+    if (fEfficiencyCorrectionAssociated)
+    {
+      Int_t effVars[4];
+      effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(batch.fEta[i]);
+      effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(batch.fPt[i]);
+      effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(centrality);
+      effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin((Double_t) zVtx);
+      batch.fEffAssociated[i] = fEfficiencyCorrectionAssociated->GetBinContent(effVars);
+    }
   }
+}
 
-  // Eta() is extremely time consuming, therefore cache it for the inner loop here:
-  TObjArray* input = (mixed) ? mixed : particles;
-  TArrayF eta(input->GetEntriesFast());
-  for (Int_t i=0; i<input->GetEntriesFast(); i++)
-    eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
+//____________________________________________________________________
+Bool_t AliUEHistograms::PassResonanceCuts(Double_t pt1, Float_t eta1, Double_t phi1, Double_t pt2, Float_t eta2, Double_t phi2)
+{
+  // applies the cuts on conversions and resonances on a pair of opposite charge
+  // returns kFALSE if the pair is rejected by one of the cuts
   
-  // if particles is not set, just fill event statistics
-  if (particles)
+  // conversions
+  if (fCutConversionsV > 0)
   {
-    Int_t jMax = particles->GetEntriesFast();
-    if (mixed)
-      jMax = mixed->GetEntriesFast();
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.510e-3, 0.510e-3);
     
-    TH1* triggerWeighting = 0;
-    if (fWeightPerEvent)
+    if (mass < fCutConversionsV * 5)
     {
-      TAxis* axis = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->GetGrid(0)->GetGrid()->GetAxis(2);
-      triggerWeighting = new TH1F("triggerWeighting", "", axis->GetNbins(), axis->GetXbins()->GetArray());
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.510e-3, 0.510e-3);
+      
+      fControlConvResoncances->Fill(0.0, mass);
+
+      if (mass < fCutConversionsV*fCutConversionsV) 
+        return kFALSE;
+    }
+  }
+  
+  // K0s
+  if (fCutK0sV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.1396);
     
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
-      {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-	
-	// some optimization
-	Float_t triggerEta = triggerParticle->Eta();
-
-	if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
-	  continue;
-
-	if (fOnlyOneEtaSide != 0)
-	{
-	  if (fOnlyOneEtaSide * triggerEta < 0)
-	    continue;
-	}
-	
-	if (fTriggerSelectCharge != 0)
-	  if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
-	    continue;
-	
-	triggerWeighting->Fill(triggerParticle->Pt());
-      }
+    const Float_t kK0smass = 0.4976;
+    
+    if (TMath::Abs(mass - kK0smass*kK0smass) < fCutK0sV * 5)
+    {
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.1396);
+      
+      fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
+
+      if (mass > (kK0smass-fCutK0sV)*(kK0smass-fCutK0sV) && mass < (kK0smass+fCutK0sV)*(kK0smass+fCutK0sV))
+        return kFALSE;
     }
+  }
+
+  // Lambda
+  if (fCutLambdaV > 0)
+  {
+    Float_t mass1 = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.9383);
+    Float_t mass2 = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.9383, 0.1396);
     
-    // identify K, Lambda candidates and flag those particles
-    // a TObject bit is used for this
-    const UInt_t kResonanceDaughterFlag = 1 << 14;
-    if (fRejectResonanceDaughters > 0)
+    const Float_t kLambdaMass = 1.115;
+
+    if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutLambdaV * 5)
     {
-      Double_t resonanceMass = -1;
-      Double_t massDaughter1 = -1;
-      Double_t massDaughter2 = -1;
-      const Double_t interval = 0.02;
+      mass1 = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.9383);
+
+      fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
       
-      switch (fRejectResonanceDaughters)
-      {
-	case 1: resonanceMass = 1.2; massDaughter1 = 0.1396; massDaughter2 = 0.9383; break; // method test
-	case 2: resonanceMass = 0.4976; massDaughter1 = 0.1396; massDaughter2 = massDaughter1; break; // k0
-	case 3: resonanceMass = 1.115; massDaughter1 = 0.1396; massDaughter2 = 0.9383; break; // lambda
-	default: AliFatal(Form("Invalid setting %d", fRejectResonanceDaughters));
-      }
+      if (mass1 > (kLambdaMass-fCutLambdaV)*(kLambdaMass-fCutLambdaV) && mass1 < (kLambdaMass+fCutLambdaV)*(kLambdaMass+fCutLambdaV))
+        return kFALSE;
+    }
+    if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutLambdaV * 5)
+    {
+      mass2 = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.9383, 0.1396);
+
+      fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
+
+      if (mass2 > (kLambdaMass-fCutLambdaV)*(kLambdaMass-fCutLambdaV) && mass2 < (kLambdaMass+fCutLambdaV)*(kLambdaMass+fCutLambdaV))
+        return kFALSE;
+    }
+  }
 
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
-	particles->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
-      if (mixed)
-	for (Int_t i=0; i<jMax; i++)
-	  mixed->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
+  // Phi
+  if (fCutPhiV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.4937, 0.4937);
+    
+    const Float_t kPhimass = 1.019;
+    
+    if (TMath::Abs(mass - kPhimass*kPhimass) < fCutPhiV * 5)
+    {
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.4937, 0.4937);
       
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
-      {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-	
-	for (Int_t j=0; j<jMax; j++)
-	{
-	  if (!mixed && i == j)
-	    continue;
-	
-	  AliVParticle* particle = 0;
-	  if (!mixed)
-	    particle = (AliVParticle*) particles->UncheckedAt(j);
-	  else
-	    particle = (AliVParticle*) mixed->UncheckedAt(j);
-	  
-	  // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
-	  if (fCheckEventNumberInCorrelation)
-	  {
-	    AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
-	    AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
-	    if(!triggerParticleBasic || !particleBasic)
-	    {
-	      AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
-	      continue;
-	    }
-	
-	    if(triggerParticleBasic->IsInSameEvent(particleBasic))
-	      continue;
-	  }
-	  else if (mixed && triggerParticle->IsEqual(particle))
-	    continue;
-	  
-	  if (triggerParticle->Charge() * particle->Charge() > 0)
-	    continue;
+      fControlConvResoncances->Fill(3, mass - kPhimass*kPhimass);
       
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
-	      
-	  if (TMath::Abs(mass - resonanceMass*resonanceMass) < interval*5)
-	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
-
-	    if (mass > (resonanceMass-interval)*(resonanceMass-interval) && mass < (resonanceMass+interval)*(resonanceMass+interval))
-	    {
-	      triggerParticle->SetBit(kResonanceDaughterFlag);
-	      particle->SetBit(kResonanceDaughterFlag);
-	      
-// 	      Printf("Flagged %d %d %f", i, j, TMath::Sqrt(mass));
-	    }
-	  }
-	}
-      }
+      if (mass > (kPhimass-fCutPhiV)*(kPhimass-fCutPhiV) && mass < (kPhimass+fCutPhiV)*(kPhimass+fCutPhiV))
+        return kFALSE;
+    }
+  }	
+
+  // Rho
+  if (fCutRhoV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.1396);
+    
+    const Float_t kRhomass = 0.770;
+    
+    if (TMath::Abs(mass - kRhomass*kRhomass) < fCutRhoV * 5)
+    {
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.1396);
+      
+      fControlConvResoncances->Fill(4, mass - kRhomass*kRhomass);
+      
+      if (mass > (kRhomass-fCutRhoV)*(kRhomass-fCutRhoV) && mass < (kRhomass+fCutRhoV)*(kRhomass+fCutRhoV))
+        return kFALSE;
     }
+  }
+
+  // User-defined cut
+  if (fCutCustomMass > 0 && fCutCustomFirst > 0 && fCutCustomSecond > 0 && fCutCustomV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, fCutCustomFirst, fCutCustomSecond);
     
-    for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+    if (TMath::Abs(mass - fCutCustomMass*fCutCustomMass) < fCutCustomV * 5)
     {
-      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, fCutCustomFirst, fCutCustomSecond);
       
-      // some optimization
-      Float_t triggerEta = triggerParticle->Eta();
+      fControlConvResoncances->Fill(5, mass - fCutCustomMass*fCutCustomMass);
       
+      if (mass > (fCutCustomMass-fCutCustomV)*(fCutCustomMass-fCutCustomV) && mass < (fCutCustomMass+fCutCustomV)*(fCutCustomMass+fCutCustomV))
+        return kFALSE;
+    }
+  }
+  
+  return kTRUE;
+}
+
+//____________________________________________________________________
+void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, const ParticleBatch& particles, const ParticleBatch* mixed, Float_t weight, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue)
+{
+  // fills the fNumberDensityPhi histogram from structure-of-arrays batches of particles (see FillParticleBatch)
+  //
+  // if mixed is non-0, mixed events are filled, the trigger particle is from particles, the associated from mixed
+  // if weight < 0, then the pt of the associated particle is filled as weight
+  // efficiency corrections are taken from the batches
+  //
+  // for each trigger particle the cheap pair selections (charge, pT and eta ordering, resonance daughter flags) are 
+  // evaluated in a branch-free loop over the associated particles, the remaining cuts and the filling are done only 
+  // for the accepted candidates
+  
+  Bool_t fillpT = kFALSE;
+  if (weight < 0)
+    fillpT = kTRUE;
+  
+  if (twoTrackEfficiencyCut && !fTwoTrackDistancePt[0])
+  {
+    // do not add this hists to the directory
+    Bool_t oldStatus = TH1::AddDirectoryStatus();
+    TH1::AddDirectory(kFALSE);
+
+    fTwoTrackDistancePt[0] = new TH3F("fTwoTrackDistancePt[0]", ";#Delta#eta;#Delta#varphi^{*}_{min};#Delta p_{T}", 100, -0.15, 0.15, 100, -0.05, 0.05, 20, 0, 10);
+    fTwoTrackDistancePt[1] = (TH3F*) fTwoTrackDistancePt[0]->Clone("fTwoTrackDistancePt[1]");
+
+    TH1::AddDirectory(oldStatus);
+  }
+  
+  const ParticleBatch& associated = (mixed) ? *mixed : particles;
+  const Int_t iMax = particles.Size();
+  const Int_t jMax = associated.Size();
+  
+  TH1* triggerWeighting = 0;
+  if (fWeightPerEvent)
+  {
+    TAxis* axis = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->GetGrid(0)->GetGrid()->GetAxis(2);
+    triggerWeighting = new TH1F("triggerWeighting", "", axis->GetNbins(), axis->GetXbins()->GetArray());
+  
+    for (Int_t i=0; i<iMax; i++)
+    {
+      Float_t triggerEta = particles.fEta[i];
+
       if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
-	continue;
+        continue;
 
       if (fOnlyOneEtaSide != 0)
       {
-	if (fOnlyOneEtaSide * triggerEta < 0)
-	  continue;
+        if (fOnlyOneEtaSide * triggerEta < 0)
+          continue;
       }
       
       if (fTriggerSelectCharge != 0)
-	if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
-	  continue;
-	
-      if (fRejectResonanceDaughters > 0)
-	if (triggerParticle->TestBit(kResonanceDaughterFlag))
-	{
-// 	  Printf("Skipped i=%d", i);
-	  continue;
-	}
-	
+        if (particles.fCharge[i] * fTriggerSelectCharge < 0)
+          continue;
+      
+      triggerWeighting->Fill(particles.fPt[i]);
+    }
+  }
+  
+  // identify K, Lambda candidates and flag those particles
+  // in the same event case trigger and associated particles share the flags
+  std::vector<Char_t> resonanceFlagsTrigger(iMax, 0);
+  std::vector<Char_t> resonanceFlagsMixed((mixed) ? jMax : 0, 0);
+  Char_t* resonanceFlagsAssociated = (mixed) ? resonanceFlagsMixed.data() : resonanceFlagsTrigger.data();
+  if (fRejectResonanceDaughters > 0)
+  {
+    Double_t resonanceMass = -1;
+    Double_t massDaughter1 = -1;
+    Double_t massDaughter2 = -1;
+    const Double_t interval = 0.02;
+    
+    switch (fRejectResonanceDaughters)
+    {
+      case 1: resonanceMass = 1.2; massDaughter1 = 0.1396; massDaughter2 = 0.9383; break; // method test
+      case 2: resonanceMass = 0.4976; massDaughter1 = 0.1396; massDaughter2 = massDaughter1; break; // k0
+      case 3: resonanceMass = 1.115; massDaughter1 = 0.1396; massDaughter2 = 0.9383; break; // lambda
+      default: AliFatal(Form("Invalid setting %d", fRejectResonanceDaughters));
+    }
+
+    for (Int_t i=0; i<iMax; i++)
+    {
       for (Int_t j=0; j<jMax; j++)
       {
         if (!mixed && i == j)
           continue;
-      
-        AliVParticle* particle = 0;
-        if (!mixed)
-          particle = (AliVParticle*) particles->UncheckedAt(j);
-        else
-          particle = (AliVParticle*) mixed->UncheckedAt(j);
         
         // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
         if (fCheckEventNumberInCorrelation)
         {
-          AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
-          AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
-          if(!triggerParticleBasic || !particleBasic)
-            AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
-      
-          if(triggerParticleBasic->IsInSameEvent(particleBasic))
+          if (particles.fEventIndex[i] == associated.fEventIndex[j])
             continue;
         }
-        else if (mixed && triggerParticle->IsEqual(particle))
+        else if (mixed && particles.fIdentity[i] == associated.fIdentity[j])
           continue;
         
-        if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
-	    continue;
-	
-	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
-	    continue;
-
-        if (fSelectCharge > 0)
-        {
-          // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
-            continue;
+        if (particles.fCharge[i] * associated.fCharge[j] > 0)
+          continue;
+    
+        Float_t mass = GetInvMassSquaredCheap(particles.fPt[i], particles.fEta[i], particles.fPhi[i], associated.fPt[j], associated.fEta[j], associated.fPhi[j], massDaughter1, massDaughter2);
             
-          // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
-            continue;
-        }
-        
-        if (fOnlyOneAssocEtaSide != 0)
-          if (fOnlyOneAssocEtaSide * eta[j] < 0)
-            continue;
-
-	if (fEtaOrdering)
-	{
-	  if (triggerEta < 0 && eta[j] < triggerEta)
-	    continue;
-	  if (triggerEta > 0 && eta[j] > triggerEta)
-	    continue;
-	}
-
-	if (fRejectResonanceDaughters > 0)
-	  if (particle->TestBit(kResonanceDaughterFlag))
-	  {
-// 	    Printf("Skipped j=%d", j);
-	    continue;
-	  }
-
-	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
-	  
-	  if (mass < fCutConversionsV * 5)
-	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
-	    
-	    fControlConvResoncances->Fill(0.0, mass);
-
-	    if (mass < fCutConversionsV*fCutConversionsV) 
-	      continue;
-	  }
-	}
-	
-	// K0s
-	if (fCutK0sV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
-	  
-	  const Float_t kK0smass = 0.4976;
-	  
-	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutK0sV * 5)
-	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
-	    
-	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
-
-	    if (mass > (kK0smass-fCutK0sV)*(kK0smass-fCutK0sV) && mass < (kK0smass+fCutK0sV)*(kK0smass+fCutK0sV))
-	      continue;
-	  }
-	}
-
-	// Lambda
-	if (fCutLambdaV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
-	  
-	  const Float_t kLambdaMass = 1.115;
-
-	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutLambdaV * 5)
-	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-
-	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
-	    
-	    if (mass1 > (kLambdaMass-fCutLambdaV)*(kLambdaMass-fCutLambdaV) && mass1 < (kLambdaMass+fCutLambdaV)*(kLambdaMass+fCutLambdaV))
-	      continue;
-	  }
-	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutLambdaV * 5)
-	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
-
-	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
-
-	    if (mass2 > (kLambdaMass-fCutLambdaV)*(kLambdaMass-fCutLambdaV) && mass2 < (kLambdaMass+fCutLambdaV)*(kLambdaMass+fCutLambdaV))
-	      continue;
-	  }
-	}
-
-        // Phi
-	if (fCutPhiV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.4937, 0.4937);
-	  
-	  const Float_t kPhimass = 1.019;
-	  
-	  if (TMath::Abs(mass - kPhimass*kPhimass) < fCutPhiV * 5)
-	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.4937, 0.4937);
-	    
-	    fControlConvResoncances->Fill(3, mass - kPhimass*kPhimass);
-	    
-	    if (mass > (kPhimass-fCutPhiV)*(kPhimass-fCutPhiV) && mass < (kPhimass+fCutPhiV)*(kPhimass+fCutPhiV))
-	      continue;
-	  }
-	}	
-
-        // Rho
-	if (fCutRhoV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+        if (TMath::Abs(mass - resonanceMass*resonanceMass) < interval*5)
         {
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
-	  
-	  const Float_t kRhomass = 0.770;
-	  
-	  if (TMath::Abs(mass - kRhomass*kRhomass) < fCutRhoV * 5)
+          mass = GetInvMassSquared(particles.fPt[i], particles.fEta[i], particles.fPhi[i], associated.fPt[j], associated.fEta[j], associated.fPhi[j], massDaughter1, massDaughter2);
+
+          if (mass > (resonanceMass-interval)*(resonanceMass-interval) && mass < (resonanceMass+interval)*(resonanceMass+interval))
           {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
-	    
-	    fControlConvResoncances->Fill(4, mass - kRhomass*kRhomass);
-	    
-	    if (mass > (kRhomass-fCutRhoV)*(kRhomass-fCutRhoV) && mass < (kRhomass+fCutRhoV)*(kRhomass+fCutRhoV))
-	      continue;
-	  }
-	}
-
-        // User-defined cut
-	if (fCutCustomMass > 0 && fCutCustomFirst > 0 && fCutCustomSecond > 0 && fCutCustomV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+            resonanceFlagsTrigger[i] = 1;
+            resonanceFlagsAssociated[j] = 1;
+          }
+        }
+      }
+    }
+  }
+  
+  // candidates of associated particles passing the cheap selections for the current trigger particle
+  std::vector<Int_t> candidates(jMax);
+  
+  for (Int_t i=0; i<iMax; i++)
+  {
+    const Double_t triggerPt = particles.fPt[i];
+    const Float_t triggerEta = particles.fEta[i];
+    const Double_t triggerPhi = particles.fPhi[i];
+    const Float_t triggerCharge = particles.fCharge[i];
+    
+    if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
+      continue;
+
+    if (fOnlyOneEtaSide != 0)
+    {
+      if (fOnlyOneEtaSide * triggerEta < 0)
+        continue;
+    }
+    
+    if (fTriggerSelectCharge != 0)
+      if (triggerCharge * fTriggerSelectCharge < 0)
+        continue;
+      
+    if (fRejectResonanceDaughters > 0)
+      if (resonanceFlagsTrigger[i])
+        continue;
+    
+    // branch-free pre-selection, all conditions are loop invariant apart from the particle properties
+    const Float_t* assocEta = associated.fEta.data();
+    const Double_t* assocPt = associated.fPt.data();
+    const Float_t* assocCharge = associated.fCharge.data();
+    const Bool_t checkResonanceFlags = (fRejectResonanceDaughters > 0);
+    Int_t nCandidates = 0;
+    for (Int_t j=0; j<jMax; j++)
+    {
+      const Float_t chargeProduct = assocCharge[j] * triggerCharge;
+      Bool_t accept = (mixed != 0) | (i != j);
+      accept &= !fPtOrder | (assocPt[j] < triggerPt);
+      accept &= (fAssociatedSelectCharge == 0) | (assocCharge[j] * fAssociatedSelectCharge >= 0);
+      accept &= (fSelectCharge != 1) | (chargeProduct <= 0);     // skip like sign
+      accept &= (fSelectCharge != 2) | (chargeProduct >= 0);     // skip unlike sign
+      accept &= (fOnlyOneAssocEtaSide == 0) | (fOnlyOneAssocEtaSide * assocEta[j] >= 0);
+      accept &= !fEtaOrdering | !(((triggerEta < 0) & (assocEta[j] < triggerEta)) | ((triggerEta > 0) & (assocEta[j] > triggerEta)));
+      accept &= !checkResonanceFlags | !resonanceFlagsAssociated[j];
+      candidates[nCandidates] = j;
+      nCandidates += accept;
+    }
+    
+    for (Int_t iCandidate=0; iCandidate<nCandidates; iCandidate++)
+    {
+      const Int_t j = candidates[iCandidate];
+      
+      // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
+      if (fCheckEventNumberInCorrelation)
+      {
+        if (particles.fEventIndex[i] == associated.fEventIndex[j])
+          continue;
+      }
+      else if (mixed && particles.fIdentity[i] == associated.fIdentity[j])
+        continue;
+      
+      if (associated.fCharge[j] * triggerCharge < 0)
+        if (!PassResonanceCuts(triggerPt, triggerEta, triggerPhi, associated.fPt[j], associated.fEta[j], associated.fPhi[j]))
+          continue;
+
+      if (twoTrackEfficiencyCut)
+      {
+        // the variables & cuthave been developed by the HBT group 
+        // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
+
+        Float_t phi1 = triggerPhi;
+        Float_t pt1 = triggerPt;
+        Float_t charge1 = triggerCharge;
+          
+        Float_t phi2 = associated.fPhi[j];
+        Float_t pt2 = associated.fPt[j];
+        Float_t charge2 = associated.fCharge[j];
+            
+        Float_t deta = triggerEta - associated.fEta[j];
+            
+        // optimization
+        if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
         {
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), fCutCustomFirst, fCutCustomSecond);
-	  
-	  if (TMath::Abs(mass - fCutCustomMass*fCutCustomMass) < fCutCustomV * 5)
+          // check first boundaries to see if is worth to loop and find the minimum
+          Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
+          Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
+          
+          const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
+
+          Float_t dphistarminabs = 1e5;
+          Float_t dphistarmin = 1e5;
+          if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
           {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), fCutCustomFirst, fCutCustomSecond);
-	    
-	    fControlConvResoncances->Fill(5, mass - fCutCustomMass*fCutCustomMass);
-	    
-	    if (mass > (fCutCustomMass-fCutCustomV)*(fCutCustomMass-fCutCustomV) && mass < (fCutCustomMass+fCutCustomV)*(fCutCustomMass+fCutCustomV))
-	      continue;
-	  }
-	}
-
-	if (twoTrackEfficiencyCut)
-	{
-	  // the variables & cuthave been developed by the HBT group 
-	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
-
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
-	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
-	      
-	  Float_t deta = triggerEta - eta[j];
-	      
-	  // optimization
-	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
-	  {
-	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
-	    
-	    const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
-
-	    Float_t dphistarminabs = 1e5;
-	    Float_t dphistarmin = 1e5;
-	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
-	    {
-	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
-	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
-
-		Float_t dphistarabs = TMath::Abs(dphistar);
-		
-		if (dphistarabs < dphistarminabs)
-		{
-		  dphistarmin = dphistar;
-		  dphistarminabs = dphistarabs;
-		}
-	      }
-	      
-	      fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
-	      
-	      if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
-	      {
-// 		Printf("Removed track pair %d %d with %f %f %f %f %f %f %f %f %f", i, j, deta, dphistarminabs, phi1, pt1, charge1, phi2, pt2, charge2, bSign);
-		continue;
-	      }
-
-    	      fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
-	    }
-	  }
-	}
-        
-        Double_t vars[6];
-        vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
-        vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
-        if (vars[4] > 1.5 * TMath::Pi()) 
-          vars[4] -= TMath::TwoPi();
-        if (vars[4] < -0.5 * TMath::Pi())
-          vars[4] += TMath::TwoPi();
-	vars[5] = zVtx;
-	
-	if (fillpT)
-	  weight = particle->Pt();
-	
-	Double_t useWeight = weight;
-	if (applyEfficiency)
-	{
-	  if (fEfficiencyCorrectionAssociated)
-	  {
-	    Int_t effVars[4];
-	    // associated particle
-	    effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
-	    effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(vars[1]); //pt
-	    effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    
-	    // 	  Printf("%d %d %d %d %f", effVars[0], effVars[1], effVars[2], effVars[3], fEfficiencyCorrectionAssociated->GetBinContent(effVars));
-	  
-	    useWeight *= fEfficiencyCorrectionAssociated->GetBinContent(effVars);
-	  }
-	  if (fEfficiencyCorrectionTriggers)
-	  {
-	    Int_t effVars[4];
-
-	    effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
-	    effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[2]); //pt
-	    effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
-	  }
-	}
-
-	if (fWeightPerEvent)
-	{
-	  Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[2]);
-// 	  Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
-	  useWeight /= triggerWeighting->GetBinContent(weightBin);
-	}
-    
-        // fill all in toward region and do not use the other regions
-	fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
+            for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
+            {
+              Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
+
+              Float_t dphistarabs = TMath::Abs(dphistar);
+              
+              if (dphistarabs < dphistarminabs)
+              {
+                dphistarmin = dphistar;
+                dphistarminabs = dphistarabs;
+              }
+            }
+            
+            fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+            
+            if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
+              continue;
 
-// 	Printf("%.2f %.2f --> %.2f", triggerEta, eta[j], vars[0]);
+            fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+          }
+        }
       }
- 
-      if (firstTime)
+      
+      Double_t vars[6];
+      vars[0] = triggerEta - associated.fEta[j];
+      vars[1] = associated.fPt[j];
+      vars[2] = triggerPt;
+      vars[3] = centrality;
+      vars[4] = triggerPhi - associated.fPhi[j];
+      if (vars[4] > 1.5 * TMath::Pi()) 
+        vars[4] -= TMath::TwoPi();
+      if (vars[4] < -0.5 * TMath::Pi())
+        vars[4] += TMath::TwoPi();
+      vars[5] = zVtx;
+      
+      if (fillpT)
+        weight = associated.fPt[j];
+      
+      Double_t useWeight = weight;
+      useWeight *= associated.fEffAssociated[j];
+      useWeight *= particles.fEffTrigger[i];
+
+      if (fWeightPerEvent)
       {
-        // once per trigger particle
-        Double_t vars[3];
-        vars[0] = triggerParticle->Pt();
-        vars[1] = centrality;
-	vars[2] = zVtx;
-
-	Double_t useWeight = 1;
-	if (fEfficiencyCorrectionTriggers && applyEfficiency)
-	{
-	  Int_t effVars[4];
-	  
-	  // trigger particle
-	  effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
-	  effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[0]); //pt
-	  effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[1]); //centrality
-	  effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[2]); //zVtx
-	  useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
-	}
-
-	if (TMath::Abs(triggerEta) < 0.8 && triggerParticle->Pt() > 0)
-	  fInvYield2->Fill(centrality, triggerParticle->Pt(), useWeight / triggerParticle->Pt());
-
-	if (fWeightPerEvent)
-	{
-	  // leads effectively to a filling of one entry per filled trigger particle pT bin
-	  Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[0]);
-// 	  Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
-	  useWeight /= triggerWeighting->GetBinContent(weightBin);
-	}
-	
-        fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
-
-	// QA
-        fCorrelationpT->Fill(centrality, triggerParticle->Pt());
-        fCorrelationEta->Fill(centrality, triggerEta);
-        fCorrelationPhi->Fill(centrality, triggerParticle->Phi());
-	fYields->Fill(centrality, triggerParticle->Pt(), triggerEta);
-	fYieldsEtaPhiPT->Fill(triggerParticle->Pt(), triggerEta, triggerParticle->Phi());
-	
-/*        if (dynamic_cast<AliAODTrack*>(triggerParticle))
-          fITSClusterMap->Fill(((AliAODTrack*) triggerParticle)->GetITSClusterMap(), centrality, triggerParticle->Pt());*/
+        Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[2]);
+        useWeight /= triggerWeighting->GetBinContent(weightBin);
       }
+  
+      // fill all in toward region and do not use the other regions
+      fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
     }
-    
-    if (triggerWeighting)
+
+    if (firstTime)
     {
-      delete triggerWeighting;
-      triggerWeighting = 0;
+      // once per trigger particle
+      Double_t vars[3];
+      vars[0] = triggerPt;
+      vars[1] = centrality;
+      vars[2] = zVtx;
+
+      Double_t useWeight = 1;
+      useWeight *= particles.fEffTrigger[i];
+
+      if (TMath::Abs(triggerEta) < 0.8 && triggerPt > 0)
+        fInvYield2->Fill(centrality, triggerPt, useWeight / triggerPt);
+
+      if (fWeightPerEvent)
+      {
+        // leads effectively to a filling of one entry per filled trigger particle pT bin
+        Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[0]);
+        useWeight /= triggerWeighting->GetBinContent(weightBin);
+      }
+      
+      fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
+
+      // QA
+      fCorrelationpT->Fill(centrality, triggerPt);
+      fCorrelationEta->Fill(centrality, triggerEta);
+      fCorrelationPhi->Fill(centrality, triggerPhi);
+      fYields->Fill(centrality, triggerPt, triggerEta);
+      fYieldsEtaPhiPT->Fill(triggerPt, triggerEta, triggerPhi);
     }
   }
   
+  if (triggerWeighting)
+  {
+    delete triggerWeighting;
+    triggerWeighting = 0;
+  }
+  
   fCentralityDistribution->Fill(centrality);
-  fCentralityCorrelation->Fill(centrality, particles->GetEntriesFast());
+  fCentralityCorrelation->Fill(centrality, iMax);
   FillEvent(centrality, step);
 }
   
@@ -12,6 +12,7 @@
 #include "AliUEHist.h"
 #include "TMath.h"
 #include "THn.h" // in cxx file causes .../THn.h:257: error: conflicting declaration ‘typedef class THnT<float> THnF’
+#include <vector>
 
 class AliVParticle;
 
@@ -25,11 +26,30 @@ class TH3F;
 class AliUEHistograms : public TNamed
 {
  public:
+  // structure-of-arrays copy of a list of particles, used by the correlation kernel in FillCorrelations
+  struct ParticleBatch
+  {
+    ParticleBatch() : fPt(), fEta(), fPhi(), fCharge(), fEffTrigger(), fEffAssociated(), fIdentity(), fEventIndex() {}
+    Int_t Size() const { return fPt.size(); }
+    void Resize(Int_t n);
+    
+    std::vector<Double_t> fPt;             // transverse momentum
+    std::vector<Float_t> fEta;             // pseudorapidity
+    std::vector<Double_t> fPhi;            // azimuthal angle
+    std::vector<Float_t> fCharge;          // charge
+    std::vector<Float_t> fEffTrigger;      // efficiency correction factor applied when the particle is the trigger particle (1 if not applied)
+    std::vector<Float_t> fEffAssociated;   // efficiency correction factor applied when the particle is the associated particle (1 if not applied)
+    std::vector<ULong64_t> fIdentity;      // particles with the same identity are not correlated in mixed mode (see AliVParticle::IsEqual)
+    std::vector<Long64_t> fEventIndex;     // event index (see AliBasicParticle::GetEventIndex), only used with SetCheckEventNumberInCorrelation
+  };
+
   AliUEHistograms(const char* name = "AliUEHistograms", const char* histograms = "", const char* binning = 0);
   virtual ~AliUEHistograms();
   
   void Fill(Int_t eventType, Float_t zVtx, AliUEHist::CFStep step, AliVParticle* leading, TList* toward, TList* away, TList* min, TList* max);
   void FillCorrelations(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed = 0, Float_t weight = 1, Bool_t firstTime = kTRUE, Bool_t twoTrackEfficiencyCut = kFALSE, Float_t bSign = 0, Float_t twoTrackEfficiencyCutValue = 0.02, Bool_t applyEfficiency = kFALSE);
+  void FillCorrelations(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, const ParticleBatch& particles, const ParticleBatch* mixed = 0, Float_t weight = 1, Bool_t firstTime = kTRUE, Bool_t twoTrackEfficiencyCut = kFALSE, Float_t bSign = 0, Float_t twoTrackEfficiencyCutValue = 0.02);
+  void FillParticleBatch(TObjArray* particles, ParticleBatch& batch, Double_t centrality, Float_t zVtx, Bool_t applyEfficiency = kFALSE) const;
   void Fill(AliVParticle* leadingMC, AliVParticle* leadingReco);
   void FillEvent(Int_t eventType, Int_t step);
   void FillEvent(Double_t centrality, Int_t step);
@@ -123,6 +143,7 @@ protected:
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign);
+  Bool_t PassResonanceCuts(Double_t pt1, Float_t eta1, Double_t phi1, Double_t pt2, Float_t eta2, Double_t phi2);
   
   static const Int_t fgkUEHists; // number of histograms
 
@@ -26,6 +26,14 @@ AliFemtoPair::AliFemtoPair():
   fDKLong(0.0),
   fCVK(0.0),
   fKStarCalc(0.0),
+  fInvParNotCalculated(1),
+  fQInvCalc(0.0),
+  fMInvCalc(0.0),
+  fKTCalc(0.0),
+  fLCMSParNotCalculated(1),
+  fQOutCMSCalc(0.0),
+  fQSideCMSCalc(0.0),
+  fQLongCMSCalc(0.0),
   fNonIdParNotCalculatedGlobal(0),
   fMergingParNotCalculated(0),
   fWeightedAvSep(0.0),
@@ -66,6 +74,14 @@ AliFemtoPair::AliFemtoPair(AliFemtoParticle* a, AliFemtoParticle* b):
   fDKLong(0.0),
   fCVK(0.0),
   fKStarCalc(0.0),
+  fInvParNotCalculated(1),
+  fQInvCalc(0.0),
+  fMInvCalc(0.0),
+  fKTCalc(0.0),
+  fLCMSParNotCalculated(1),
+  fQOutCMSCalc(0.0),
+  fQSideCMSCalc(0.0),
+  fQLongCMSCalc(0.0),
   fNonIdParNotCalculatedGlobal(0),
   fMergingParNotCalculated(0),
   fWeightedAvSep(0.0),
@@ -137,6 +153,14 @@ AliFemtoPair::AliFemtoPair(const AliFemtoPair &aPair):
   fDKLong(aPair.fDKLong),
   fCVK(aPair.fCVK),
   fKStarCalc(aPair.fKStarCalc),
+  fInvParNotCalculated(aPair.fInvParNotCalculated),
+  fQInvCalc(aPair.fQInvCalc),
+  fMInvCalc(aPair.fMInvCalc),
+  fKTCalc(aPair.fKTCalc),
+  fLCMSParNotCalculated(aPair.fLCMSParNotCalculated),
+  fQOutCMSCalc(aPair.fQOutCMSCalc),
+  fQSideCMSCalc(aPair.fQSideCMSCalc),
+  fQLongCMSCalc(aPair.fQLongCMSCalc),
   fNonIdParNotCalculatedGlobal(aPair.fNonIdParNotCalculatedGlobal),
   fMergingParNotCalculated(aPair.fMergingParNotCalculated),
   fWeightedAvSep(aPair.fWeightedAvSep),
@@ -184,6 +208,16 @@ AliFemtoPair& AliFemtoPair::operator=(const AliFemtoPair &aPair)
   fCVK = aPair.fCVK;
   fKStarCalc = aPair.fKStarCalc;
 
+  fInvParNotCalculated = aPair.fInvParNotCalculated;
+  fQInvCalc = aPair.fQInvCalc;
+  fMInvCalc = aPair.fMInvCalc;
+  fKTCalc = aPair.fKTCalc;
+
+  fLCMSParNotCalculated = aPair.fLCMSParNotCalculated;
+  fQOutCMSCalc = aPair.fQOutCMSCalc;
+  fQSideCMSCalc = aPair.fQSideCMSCalc;
+  fQLongCMSCalc = aPair.fQLongCMSCalc;
+
   fNonIdParNotCalculatedGlobal = aPair.fNonIdParNotCalculatedGlobal;
 
   fMergingParNotCalculated = aPair.fMergingParNotCalculated;
@@ -226,20 +260,22 @@ double AliFemtoPair::GetPairAngleEP() const
 	return fPairAngleEP;
 }
 //_________________
-double AliFemtoPair::MInv() const
-{
-  // invariant mass
-    double tInvariantMass = abs(fTrack1->FourMomentum() + fTrack2->FourMomentum());
-    return tInvariantMass;
-}
-//_________________
-double AliFemtoPair::KT() const
+void AliFemtoPair::CalcInvPar() const
 {
-  // transverse momentum
-  double tmp = (fTrack1->FourMomentum() + fTrack2->FourMomentum()).Perp();
-  tmp *= .5;
+  // Calculate the invariant pair quantities (qinv, minv, kT) in one go.
+  // They are cached until one of the tracks is changed, so that the pair
+  // cut and all correlation functions share the same calculation.
+  const AliFemtoLorentzVector &p1 = fTrack1->FourMomentum(),
+                              &p2 = fTrack2->FourMomentum();
 
-  return tmp;
+  const AliFemtoLorentzVector tDiff = p1 - p2,
+                              tSum = p1 + p2;
+
+  fQInvCalc = -tDiff.m();
+  fMInvCalc = abs(tSum);
+  fKTCalc = 0.5 * tSum.Perp();
+
+  fInvParNotCalculated = 0;
 }
 //_________________
 double AliFemtoPair::Rap() const
@@ -388,68 +424,51 @@ void AliFemtoPair::QYKPPF(double& qP, double& qT, double& q0) const
 
 
 //_________________
-double AliFemtoPair::QOutCMS() const
+void AliFemtoPair::CalcLCMSPar() const
 {
-  // relative momentum out component in lab frame
-  const AliFemtoThreeVector
-    &p1 = fTrack1->FourMomentum().vect(),
-    &p2 = fTrack2->FourMomentum().vect();
+  // Calculate the relative momentum components out, side and long in the
+  // longitudinally comoving system; cached like CalcInvPar
+  const AliFemtoLorentzVector
+    &tmp1 = fTrack1->FourMomentum(),
+    &tmp2 = fTrack2->FourMomentum();
 
   const double
-    dx = p1.x() - p2.x(),
-    px = p1.x() + p2.x(),
+    x1 = tmp1.x(),
+    y1 = tmp1.y(),
 
-    dy = p1.y() - p2.y(),
-    py = p1.y() + p2.y(),
+    x2 = tmp2.x(),
+    y2 = tmp2.y(),
 
-    k = dx*px + dy*py,
-    pt = ::sqrt(px*px + py*py);
+    dx = x1 - x2,
+    px = x1 + x2,
 
-  return CHECKED_DIVIDE_ELSE_ZERO(k, pt);
-}
+    dy = y1 - y2,
+    py = y1 + y2,
 
-//_________________
-double AliFemtoPair::QSideCMS() const
-{
-  // relative momentum side component in lab frame
-  const AliFemtoThreeVector
-    &p1 = fTrack1->FourMomentum().vect(),
-    &p2 = fTrack2->FourMomentum().vect();
-
-  const double
-    x1 = p1.x(),
-    y1 = p1.y(),
-
-    x2 = p2.x(),
-    y2 = p2.y(),
-
-    xt = x1+x2,
-    yt = y1+y2,
+    kout = dx*px + dy*py,
+    kside = 2.0 * (x2*y1 - x1*y2),
+    pt = ::sqrt(px*px + py*py);
 
-    k = 2.0 * (x2*y1 - x1*y2),
-    pt = ::sqrt(xt*xt + yt*yt);
+  // out: projection of the relative momentum on the pair transverse momentum
+  fQOutCMSCalc = CHECKED_DIVIDE_ELSE_ZERO(kout, pt);
 
-  return CHECKED_DIVIDE_ELSE_ZERO(k, pt);
-}
+  // side: perpendicular to out in the transverse plane
+  fQSideCMSCalc = CHECKED_DIVIDE_ELSE_ZERO(kside, pt);
 
-//_________________________
-double AliFemtoPair::QLongCMS() const
-{
-  // relative momentum component in lab frame
-  const AliFemtoLorentzVector
-    &tmp1 = fTrack1->FourMomentum(),
-    &tmp2 = fTrack2->FourMomentum();
+  // long: boosted to the frame where the pair longitudinal momentum vanishes
+  const double
+    dz = tmp1.z() - tmp2.z(),
+    zz = tmp1.z() + tmp2.z(),
 
-  double dz = tmp1.z() - tmp2.z();
-  double zz = tmp1.z() + tmp2.z();
+    dt = tmp1.t() - tmp2.t(),
+    tt = tmp1.t() + tmp2.t(),
 
-  double dt = tmp1.t() - tmp2.t();
-  double tt = tmp1.t() + tmp2.t();
+    beta = zz/tt,
+    gamma = 1.0/TMath::Sqrt((1.-beta)*(1.+beta));
 
-  double beta = zz/tt;
-  double gamma = 1.0/TMath::Sqrt((1.-beta)*(1.+beta));
+  fQLongCMSCalc = gamma * (dz - beta*dt);
 
-  return gamma * (dz - beta*dt);
+  fLCMSParNotCalculated = 0;
 }
 
 //________________________________
@@ -235,6 +235,18 @@ private:
   mutable double fKStarCalc; // momemntum of first particle in PRF - k*
   void CalcNonIdPar() const;
 
+  mutable short fInvParNotCalculated; // Set to 1 when qinv, minv and kT have not yet been calculated for this pair
+  mutable double fQInvCalc;           // cached invariant relative momentum
+  mutable double fMInvCalc;           // cached invariant mass
+  mutable double fKTCalc;             // cached pair transverse momentum
+  void CalcInvPar() const;
+
+  mutable short fLCMSParNotCalculated; // Set to 1 when the Bertsch-Pratt LCMS components have not yet been calculated
+  mutable double fQOutCMSCalc;         // cached q_out in LCMS
+  mutable double fQSideCMSCalc;        // cached q_side in LCMS
+  mutable double fQLongCMSCalc;        // cached q_long in LCMS
+  void CalcLCMSPar() const;
+
   mutable short fNonIdParNotCalculatedGlobal; // If global k* was calculated
  /* mutable double fDKSideGlobal;
   mutable double fDKOutGlobal;
@@ -304,6 +316,8 @@ private:
 };
 
 inline void AliFemtoPair::ResetParCalculated(){
+  fInvParNotCalculated=1;
+  fLCMSParNotCalculated=1;
   fNonIdParNotCalculated=1;
   fNonIdParNotCalculatedGlobal=1;
   fMergingParNotCalculated=1;
@@ -348,8 +362,28 @@ inline double AliFemtoPair::KStar() const{
   return fKStarCalc;
 }
 inline double AliFemtoPair::QInv() const {
-  AliFemtoLorentzVector tDiff = (fTrack1->FourMomentum()-fTrack2->FourMomentum());
-  return -tDiff.m();
+  if(fInvParNotCalculated) CalcInvPar();
+  return fQInvCalc;
+}
+inline double AliFemtoPair::MInv() const {
+  if(fInvParNotCalculated) CalcInvPar();
+  return fMInvCalc;
+}
+inline double AliFemtoPair::KT() const {
+  if(fInvParNotCalculated) CalcInvPar();
+  return fKTCalc;
+}
+inline double AliFemtoPair::QOutCMS() const {
+  if(fLCMSParNotCalculated) CalcLCMSPar();
+  return fQOutCMSCalc;
+}
+inline double AliFemtoPair::QSideCMS() const {
+  if(fLCMSParNotCalculated) CalcLCMSPar();
+  return fQSideCMSCalc;
+}
+inline double AliFemtoPair::QLongCMS() const {
+  if(fLCMSParNotCalculated) CalcLCMSPar();
+  return fQLongCMSCalc;
 }
 
 // Fabrice private <<<
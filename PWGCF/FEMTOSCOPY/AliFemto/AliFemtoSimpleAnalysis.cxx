@@ -13,6 +13,7 @@
 #include <string>
 #include <iostream>
 #include <iterator>
+#include <vector>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -183,7 +184,10 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fPair(),
+  fPairParticles1(),
+  fPairParticles2()
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -205,7 +209,10 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fPair(),
+  fPairParticles1(),
+  fPairParticles2()
 {
   /// Copy constructor
 
@@ -598,86 +605,86 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
   // "Seed" this here.
   bool swpart = fNeventsProcessed % 2;
 
-  // Setup iterator ranges
+  // Copy the particle pointers into contiguous arrays, which are cheaper to
+  // walk repeatedly in the inner loop than the linked-list collections. The
+  // arrays are members so their memory is reused between calls.
   //
-  // The outer loop alway starts at beginning of particle collection 1.
-  // * If we are iterating over both particle collections, then the loop simply
-  // runs through both from beginning to end.
+  // * If we are iterating over both particle collections, then the loops simply
+  // run through both from beginning to end.
   // * If we are only iterating over one particle collection, the inner loop
-  // loops over all particles between the outer iterator and the end of the
-  // collection. The outer loop must skip the last entry of the list.
-  AliFemtoParticleConstIterator tStartOuterLoop = partCollection1->begin(),
-                                tEndOuterLoop = partCollection1->end(),
-                                tStartInnerLoop,
-                                tEndInnerLoop;
-
-  if (partCollection2) {                         // Two collections:
-    tStartInnerLoop = partCollection2->begin();  //   Full inner & outer loops
-    tEndInnerLoop   = partCollection2->end();    //
+  // runs over all particles after the outer position, and the outer loop
+  // skips the last entry.
+  fPairParticles1.assign(partCollection1->begin(), partCollection1->end());
+  if (partCollection2) {
+    fPairParticles2.assign(partCollection2->begin(), partCollection2->end());
   }
-  else {                                         // One collection:
-    tEndOuterLoop--;                             //   Outer loop goes to next-to-last particle
-    tEndInnerLoop = partCollection1->end() ;     //   Inner loop goes to last particle
+
+  const std::vector<AliFemtoParticle*> &particles1 = fPairParticles1,
+                                       &particles2 = partCollection2 ? fPairParticles2 : fPairParticles1;
+
+  const size_t n1 = particles1.size(),
+               n2 = particles2.size();
+
+  if (n1 == 0 || n2 == 0) {
+    return;
   }
 
-  // Create the pair outside the loop - only allocate once
-  AliFemtoPair* tPair = new AliFemtoPair;
+  const size_t tEndOuterLoop = partCollection2 ? n1 : n1 - 1;
+
+  // The pair is reused for all combinations. Pair kinematics (qinv, kT, LCMS
+  // components, k*) are calculated lazily by the pair and cached until one of
+  // its tracks changes, so they are computed once and shared by the pair cut
+  // and all correlation functions.
+  AliFemtoPair &tPair = fPair;
 
   // Begin the outer loop
-  for (AliFemtoParticleConstIterator tPartIter1 = tStartOuterLoop;
-                                     tPartIter1 != tEndOuterLoop;
-                                     ++tPartIter1) {
+  for (size_t i = 0; i < tEndOuterLoop; ++i) {
+    AliFemtoParticle *tPart1 = particles1[i];
 
     // If analyzing identical particles, start inner loop at the particle
     // after the current outer loop position, (loops until end)
-    if (!partCollection2) {
-      tStartInnerLoop = tPartIter1;
-      tStartInnerLoop++;
-    }
+    const size_t tStartInnerLoop = partCollection2 ? 0 : i + 1;
 
     // If we have two collections - set the first track
     if (partCollection2 != nullptr) {
-      tPair->SetTrack1(*tPartIter1);
+      tPair.SetTrack1(tPart1);
     }
 
     // Begin the inner loop
-    for (AliFemtoParticleConstIterator tPartIter2 = tStartInnerLoop;
-                                       tPartIter2 != tEndInnerLoop;
-                                     ++tPartIter2) {
+    for (size_t j = tStartInnerLoop; j < n2; ++j) {
+      AliFemtoParticle *tPart2 = particles2[j];
+
       // If we have two collections - only set the second track
       if (partCollection2 != nullptr) {
-        tPair->SetTrack2(*tPartIter2);
+        tPair.SetTrack2(tPart2);
 
       // Swap between first and second particles to avoid biased ordering
       } else {
-        tPair->SetTrack1(swpart ? *tPartIter2 : *tPartIter1);
-        tPair->SetTrack2(swpart ? *tPartIter1 : *tPartIter2);
+        tPair.SetTrack1(swpart ? tPart2 : tPart1);
+        tPair.SetTrack2(swpart ? tPart1 : tPart2);
         swpart = !swpart;
       }
 
       // check if the pair passes the cut
-      bool tmpPassPair = fPairCut->Pass(tPair);
+      bool tmpPassPair = fPairCut->Pass(&tPair);
 
       // This is a condition for speed reasons
       if (enablePairMonitors) {
-        fPairCut->FillCutMonitor(tPair, tmpPassPair);
+        fPairCut->FillCutMonitor(&tPair, tmpPassPair);
       }
 
       // If pair passes cut, loop over CF's and add pair to real/mixed
       if (tmpPassPair) {
         for (auto &tCorrFctn : *fCorrFctnCollection) {
           if (these_are_real_pairs)
-            tCorrFctn->AddRealPair(tPair);
+            tCorrFctn->AddRealPair(&tPair);
           else
-            tCorrFctn->AddMixedPair(tPair);
+            tCorrFctn->AddMixedPair(&tPair);
         } // loop over correlation functions
       }
 
     }    // loop over second particle
   }      // loop over first particle
-
-  // we are done with the pair
-  delete tPair;
 }
 //_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
@@ -15,6 +15,9 @@
 #include "AliFemtoParticleCollection.h"
 #include "AliFemtoV0SharedDaughterCut.h"
 #include "AliFemtoXiSharedDaughterCut.h"
+#include "AliFemtoPair.h"
+
+#include <vector>
 
 class AliFemtoPicoEventCollectionVectorHideAway;
 class AliFemtoPicoEvent;
@@ -178,6 +181,10 @@ protected:
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
 
+  AliFemtoPair fPair;                                  //!<! Pair object reused by MakePairs
+  std::vector<AliFemtoParticle*> fPairParticles1;      //!<! Contiguous copy of the first particle collection in MakePairs
+  std::vector<AliFemtoParticle*> fPairParticles2;      //!<! Contiguous copy of the second particle collection in MakePairs
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
   ClassDef(AliFemtoSimpleAnalysis, 0);
@@ -395,7 +395,13 @@ void AliAnalysisTaskGFWFlow::UserExec(Option_t*) {
     AliAODTrack *lTrack;
     if(!fSelections[fCurrSystFlag]->AcceptVertex(fAOD,1)) return;
     // mywatchFill.Start(kFALSE);
-    for(Int_t lTr=0;lTr<fAOD->GetNumberOfTracks();lTr++) {
+    //Tracks are collected first and then filled to the GFW in one batch
+    Int_t nTracks = fAOD->GetNumberOfTracks();
+    vector<Double_t> lEtas, lPhis, lWeights;
+    vector<Int_t> lPtBins, lMasks;
+    lEtas.reserve(2*nTracks); lPhis.reserve(2*nTracks); lWeights.reserve(2*nTracks);
+    lPtBins.reserve(2*nTracks); lMasks.reserve(2*nTracks);
+    for(Int_t lTr=0;lTr<nTracks;lTr++) {
       lTrack = (AliAODTrack*)fAOD->GetTrack(lTr);
       //if(!AcceptAODTrack(lTrack,tca)) continue;
       Double_t POStrk[] = {0.,0.,0.};
@@ -419,12 +425,21 @@ void AliAnalysisTaskGFWFlow::UserExec(Option_t*) {
       //Double_t nuaITS = fExtraWeights->GetWeight(lTrack->Phi(),lTrack->Eta(),vz,lTrack->Pt(),cent,0);
       //Double_t nue = fPtAxis->GetNbins()>1?1:fWeights->GetWeight(lTrack->Phi(),lTrack->Eta(),vz,cent,l_pT,1);
       if(fSelections[fCurrSystFlag]->AcceptTrack(lTrack, lDCA)) {
-      	if(WithinPtPOI) fGFW->Fill(lTrack->Eta(),fPtAxis->FindBin(l_pT)-1,lTrack->Phi(),nua*nue,1); //Fill POI (mask = 1)
-        if(WithinPtRF)  fGFW->Fill(lTrack->Eta(),fPtAxis->FindBin(l_pT)-1,lTrack->Phi(),nua*nue,2); //Fit RF (mask = 2)
+        Int_t lPtBin = fPtAxis->FindBin(l_pT)-1;
+        for(Int_t lMask=1;lMask<=2;lMask++) { //POI (mask = 1) and RF (mask = 2)
+          if(lMask==1 && !WithinPtPOI) continue;
+          if(lMask==2 && !WithinPtRF) continue;
+          lEtas.push_back(lTrack->Eta());
+          lPtBins.push_back(lPtBin);
+          lPhis.push_back(lTrack->Phi());
+          lWeights.push_back(nua*nue);
+          lMasks.push_back(lMask);
+        };
       }
       /*if(fSelections[9]->AcceptTrack(lTrack, lDCA)) //No ITS for now
 	fGFW->Fill(lTrack->Eta(),fPtAxis->FindBin(lTrack->Pt())-1,lTrack->Phi(),nuaITS*nue,2);*/
     };
+    if(!lEtas.empty()) fGFW->Fill((Int_t)lEtas.size(),lEtas.data(),lPtBins.data(),lPhis.data(),lWeights.data(),lMasks.data());
     // mywatchFill.Stop();
     TRandom rndm(0);
     Double_t rndmn=rndm.Rndm();
@@ -619,7 +634,7 @@ Bool_t AliAnalysisTaskGFWFlow::FillFCs(TString head, TString hn, Double_t cent,
   };
   return kTRUE;
 };
-Bool_t AliAnalysisTaskGFWFlow::FillFCs(AliGFW::CorrConfig corconf, Double_t cent, Double_t rndmn, Bool_t DisableOverlap) {
+Bool_t AliAnalysisTaskGFWFlow::FillFCs(const AliGFW::CorrConfig &corconf, Double_t cent, Double_t rndmn, Bool_t DisableOverlap) {
   Double_t dnx, val;
   dnx = fGFW->Calculate(corconf,0,kTRUE).Re();
   if(dnx==0) return kFALSE;
@@ -2,6 +2,11 @@
 /*TODOs:
 need to add flags to have control over what is added, e.g. what happens, when I have several overlapping regions of different types: reference, pT-diff unID and pT-diff. ID?
 */
+namespace {
+  //Harmonics and powers used when harmonics are set to zero or powers are not specified
+  const Int_t kZeroHars[AliGFW::kMaxCorrOrder] = {0};
+  const Int_t kUnitPows[AliGFW::kMaxCorrOrder] = {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1};
+}
 AliGFW::AliGFW():
   fInitialized(kFALSE)
 {
@@ -35,6 +40,9 @@ void AliGFW::AddRegion(TString refName, Int_t lNhar, Int_t lNpar, Double_t lEtaM
   lOneRegion.rName = refName; //Name of the region
   lOneRegion.BitMask = BitMask; //Bit mask
   AddRegion(lOneRegion);
+  //Region indices of cached configurations might change, so recompile them on next use
+  fCompiledConfigs[0].clear();
+  fCompiledConfigs[1].clear();
 };
 void AliGFW::AddRegion(TString refName, Int_t lNhar, Int_t *lNparVec, Double_t lEtaMin, Double_t lEtaMax, Int_t lNpT, Int_t BitMask) {
   if(lNpT < 1) {
@@ -60,6 +68,9 @@ void AliGFW::AddRegion(TString refName, Int_t lNhar, Int_t *lNparVec, Double_t l
   lOneRegion.rName = refName; //Name of the region
   lOneRegion.BitMask = BitMask; //Bit mask
   AddRegion(lOneRegion);
+  //Region indices of cached configurations might change, so recompile them on next use
+  fCompiledConfigs[0].clear();
+  fCompiledConfigs[1].clear();
 };
 void AliGFW::SplitRegions() {
   //Simple case. Will not look for overlaps, etc. Everything is left for end-used
@@ -89,9 +100,36 @@ Int_t AliGFW::CreateRegions() {
 void AliGFW::Fill(Double_t eta, Int_t ptin, Double_t phi, Double_t weight, Int_t mask) {
   if(!fInitialized) CreateRegions();
   if(!fInitialized) return;
-  for(Int_t i=0;i<(Int_t)fRegions.size();++i) {
-    if(fRegions.at(i).EtaMin<eta && fRegions.at(i).EtaMax>eta && (fRegions.at(i).BitMask&mask))
-      fCumulants.at(i).FillArray(eta,ptin,phi,weight);
+  const Int_t nRegions = (Int_t)fRegions.size();
+  for(Int_t i=0;i<nRegions;++i) {
+    const Region &lRegion = fRegions[i];
+    if(lRegion.EtaMin<eta && lRegion.EtaMax>eta && (lRegion.BitMask&mask))
+      fCumulants[i].FillArray(eta,ptin,phi,weight);
+  };
+};
+void AliGFW::Fill(Int_t ntracks, const Double_t *eta, const Int_t *ptin, const Double_t *phi, const Double_t *weight, const Int_t *mask) {
+  //Same as calling Fill for each track, but tracks are first selected for each region, and
+  //then passed to the cumulant in one go, where the Q-vectors are filled by a vectorized kernel
+  if(!fInitialized) CreateRegions();
+  if(!fInitialized) return;
+  if(ntracks<1) return;
+  if((Int_t)fBatchPhi.size()<ntracks) {
+    fBatchPt.resize(ntracks);
+    fBatchPhi.resize(ntracks);
+    fBatchWeight.resize(ntracks);
+  };
+  const Int_t nRegions = (Int_t)fRegions.size();
+  for(Int_t i=0;i<nRegions;++i) {
+    const Region &lRegion = fRegions[i];
+    Int_t nSel=0;
+    for(Int_t j=0;j<ntracks;j++) {
+      if(!(lRegion.EtaMin<eta[j] && lRegion.EtaMax>eta[j] && (lRegion.BitMask&mask[j]))) continue;
+      fBatchPt[nSel] = ptin[j];
+      fBatchPhi[nSel] = phi[j];
+      fBatchWeight[nSel] = weight[j];
+      nSel++;
+    };
+    if(nSel) fCumulants[i].FillArrays(nSel,fBatchPt.data(),fBatchPhi.data(),fBatchWeight.data());
   };
 };
 TComplex AliGFW::TwoRec(Int_t n1, Int_t n2, Int_t p1, Int_t p2, Int_t ptbin, AliGFWCumulant *r1, AliGFWCumulant *r2, AliGFWCumulant *r3) {
@@ -124,6 +162,26 @@ TComplex AliGFW::RecursiveCorr(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGF
   };
   return formula;
 };
+TComplex AliGFW::RecursiveCorr(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGFWCumulant *qol, Int_t ptbin, const Int_t *hars, const Int_t *pows, Int_t nhars) {
+  //Same recursion as above, but harmonics and powers are passed as plain arrays, and the
+  //reduced combinations are built on the stack. Requires nhars <= kMaxCorrOrder
+  if(nhars<1) return TComplex(0,0);
+  if(nhars<2) return qpoi->Vec(hars[0],pows[0],ptbin);
+  if(nhars<3) return TwoRec(hars[0], hars[1], pows[0], pows[1], ptbin, qpoi, qref, qol);
+  const Int_t harlast=hars[nhars-1];
+  const Int_t powlast=pows[nhars-1];
+  TComplex formula = RecursiveCorr(qpoi, qref, qol, ptbin, hars, pows, nhars-1)*qref->Vec(harlast,powlast);
+  Int_t lhars[kMaxCorrOrder];
+  Int_t lpows[kMaxCorrOrder];
+  for(Int_t i=0;i<nhars-1;i++) {
+    std::copy(hars, hars+nhars-1, lhars);
+    std::copy(pows, pows+nhars-1, lpows);
+    lhars[i]+=harlast;
+    lpows[i]+=powlast;
+    formula-=RecursiveCorr(qpoi, qref, qol, ptbin, lhars, lpows, nhars-1);
+  };
+  return formula;
+};
 void AliGFW::Clear() {
   for(auto ptr = fCumulants.begin(); ptr!=fCumulants.end(); ++ptr) ptr->ResetQs();
   fCalculatedNames.clear();
@@ -134,24 +192,38 @@ TComplex AliGFW::Calculate(TString config, Bool_t SetHarmsToZero) {
     printf("Configuration empty!\n");
     return TComplex(0,0);
   };
-  TString tmp;
-  Ssiz_t sz1=0;
+  //Parse the configuration only once; afterwards, only the cached region indices and harmonics are used
+  std::map<TString, vector<CompiledSingle> > &lCache = fCompiledConfigs[SetHarmsToZero?1:0];
+  std::map<TString, vector<CompiledSingle> >::iterator lItr = lCache.find(config);
+  if(lItr==lCache.end()) {
+    vector<CompiledSingle> lCompiled;
+    TString tmp;
+    Ssiz_t sz1=0;
+    while(config.Tokenize(tmp,sz1,"}")) {
+      if(SetHarmsToZero) SetHarmonicsToZero(tmp);
+      CompiledSingle lSingle;
+      if(!CompileSingle(tmp,lSingle)) lSingle.Poi=-1;
+      lCompiled.push_back(lSingle);
+    };
+    lItr = lCache.insert(std::make_pair(config,lCompiled)).first;
+  };
   TComplex ret(1,0);
-  while(config.Tokenize(tmp,sz1,"}")) {
-    if(SetHarmsToZero) SetHarmonicsToZero(tmp);
-    /*Int_t ind=FindCalculated(tmp);
-    if(ind>=0) {
-      ret*=fCalculatedQs.at(ind);
-      continue;
-    };*/
-    TComplex val=CalculateSingle(tmp);
-    ret*=val;
-    fCalculatedQs.push_back(val);
-    fCalculatedNames.push_back(tmp);
+  for(vector<CompiledSingle>::const_iterator sItr=lItr->second.begin(); sItr!=lItr->second.end(); ++sItr) {
+    if(sItr->Poi<0) return TComplex(0,0);
+    AliGFWCumulant *qpoi = &fCumulants.at(sItr->Poi);
+    AliGFWCumulant *qref = &fCumulants.at(sItr->Ref);
+    Int_t nhars = (Int_t)sItr->Hars.size();
+    if(nhars<=kMaxCorrOrder) ret*=RecursiveCorr(qpoi, qref, qpoi, sItr->PtBin, sItr->Hars.data(), kUnitPows, nhars);
+    else ret*=RecursiveCorr(qpoi, qref, qpoi, sItr->PtBin, sItr->Hars);
   };
   return ret;
 };
 TComplex AliGFW::CalculateSingle(TString config) {
+  CompiledSingle lSingle;
+  if(!CompileSingle(config,lSingle)) return TComplex(0,0);
+  return Calculate(lSingle.Poi,lSingle.Ref,lSingle.Hars,lSingle.PtBin);
+};
+Bool_t AliGFW::CompileSingle(TString config, CompiledSingle &target) {
   //First remove all ; and ,:
   config.ReplaceAll(","," ");
   config.ReplaceAll(";"," ");
@@ -172,7 +244,7 @@ TComplex AliGFW::CalculateSingle(TString config) {
   if(sz1<0) sz1=0;
   if(!config.Tokenize(ts,szend,"{")) {
     printf("Could not find harmonics!\n");
-    return TComplex(0,0);
+    return kFALSE;
   };
   //Fetch regions
   while(ts.Tokenize(ts2,sz1," ")) {
@@ -187,8 +259,15 @@ TComplex AliGFW::CalculateSingle(TString config) {
   };
   //Fetch harmonics
   while(config.Tokenize(ts,szend," ")) hars.push_back(ts.Atoi());
-  if(regs.size()==1) return Calculate(regs.at(0),hars);
-  return Calculate(regs.at(0),regs.at(1),hars,ptbin);
+  if(regs.size()==0 || hars.size()==0) {
+    printf("Could not parse configuration %s!\n",config.Data());
+    return kFALSE;
+  };
+  target.Poi = regs.at(0);
+  target.Ref = (regs.size()==1)?regs.at(0):regs.at(1);
+  target.PtBin = (regs.size()==1)?0:ptbin;
+  target.Hars = hars;
+  return kTRUE;
 };
 AliGFW::CorrConfig AliGFW::GetCorrelatorConfig(TString config, TString head, Bool_t ptdif) {
   //First remove all ; and ,:
@@ -254,7 +333,7 @@ TComplex AliGFW::Calculate(Int_t poi, Int_t ref, vector<Int_t> hars, Int_t ptbin
   AliGFWCumulant *qovl = qpoi;
   return RecursiveCorr(qpoi, qref, qovl, ptbin, hars);
 };
-TComplex AliGFW::Calculate(CorrConfig corconf, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap) {
+TComplex AliGFW::Calculate(const CorrConfig &corconf, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap) {
   if(corconf.Regs.size()==0) return TComplex(0,0);
   Int_t poi = corconf.Regs.at(0);
   Int_t ref = (corconf.Regs.size()>1)?corconf.Regs.at(1):corconf.Regs.at(0);
@@ -263,19 +342,26 @@ TComplex AliGFW::Calculate(CorrConfig corconf, Int_t ptbin, Bool_t SetHarmsToZer
   if(!qpoi->IsPtBinFilled(ptbin)) return TComplex(0,0);
   //if(!qref->IsPtBinFilled(ptbin)) return TComplex(0,0);
   AliGFWCumulant *qovl = DisableOverlap?0:qpoi;
-  if(SetHarmsToZero) for(Int_t i=0;i<(Int_t)corconf.Hars.size();i++) corconf.Hars.at(i) = 0;
-  TComplex retval = RecursiveCorr(qpoi, qref, qovl, ptbin, corconf.Hars);
+  TComplex retval = CalculateCompiled(qpoi, qref, qovl, corconf.Hars, ptbin, SetHarmsToZero);
   if(corconf.Regs2.size()==0) return retval;
   poi = corconf.Regs2.at(0);
   ref = (corconf.Regs2.size()>1)?corconf.Regs2.at(1):corconf.Regs2.at(0);
   qref = &fCumulants.at(ref);
   qpoi = &fCumulants.at(poi);
   qovl = qpoi;
-  if(SetHarmsToZero) for(Int_t i=0;i<(Int_t)corconf.Hars2.size();i++) corconf.Hars2.at(i) = 0;
-  retval*=RecursiveCorr(qpoi, qref, qovl, 0, corconf.Hars2);
+  retval*=CalculateCompiled(qpoi, qref, qovl, corconf.Hars2, 0, SetHarmsToZero);
   return retval;
 };
-
+TComplex AliGFW::CalculateCompiled(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGFWCumulant *qovl, const vector<Int_t> &hars, Int_t ptbin, Bool_t SetHarmsToZero) {
+  //Evaluates a correlator of a precompiled configuration without copying the harmonics
+  Int_t nhars = (Int_t)hars.size();
+  if(nhars<=kMaxCorrOrder)
+    return RecursiveCorr(qpoi, qref, qovl, ptbin, SetHarmsToZero?kZeroHars:hars.data(), kUnitPows, nhars);
+  //Very high orders: fall back to the vector-based recursion
+  vector<Int_t> lhars = hars;
+  if(SetHarmsToZero) std::fill(lhars.begin(),lhars.end(),0);
+  return RecursiveCorr(qpoi, qref, qovl, ptbin, lhars);
+};
 TComplex AliGFW::Calculate(Int_t poi, vector<Int_t> hars) {
   AliGFWCumulant *qpoi = &fCumulants.at(poi);
   return RecursiveCorr(qpoi, qpoi, qpoi, 0, hars);
@@ -4,6 +4,7 @@
 #include <vector>
 #include <utility>
 #include <algorithm>
+#include <map>
 #include "TString.h"
 #include "TObjArray.h"
 using std::vector;
@@ -50,17 +51,26 @@ class AliGFW {
   void AddRegion(TString refName, Int_t lNhar, Int_t *lNparVec, Double_t lEtaMin, Double_t lEtaMax, Int_t lNpT=1, Int_t BitMask=1);
   Int_t CreateRegions();
   void Fill(Double_t eta, Int_t ptin, Double_t phi, Double_t weight, Int_t mask);
+  void Fill(Int_t ntracks, const Double_t *eta, const Int_t *ptin, const Double_t *phi, const Double_t *weight, const Int_t *mask); //Fill a whole event at once
   void Clear();// { for(auto ptr = fCumulants.begin(); ptr!=fCumulants.end(); ++ptr) ptr->ResetQs(); };
   AliGFWCumulant GetCumulant(Int_t index) { return fCumulants.at(index); };
   TComplex Calculate(TString config, Bool_t SetHarmsToZero=kFALSE);
   CorrConfig GetCorrelatorConfig(TString config, TString head = "", Bool_t ptdif=kFALSE);
-  TComplex Calculate(CorrConfig corconf, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap=kFALSE);
+  TComplex Calculate(const CorrConfig &corconf, Int_t ptbin, Bool_t SetHarmsToZero, Bool_t DisableOverlap=kFALSE);
+  enum { kMaxCorrOrder = 16 }; //Maximum number of particles in a single correlator
  private:
+  //One region descriptor of a string configuration (one "{...}" block), parsed once and cached
+  struct CompiledSingle {
+    Int_t Poi, Ref, PtBin;
+    vector<Int_t> Hars;
+  };
   Bool_t fInitialized;
   void SplitRegions();
   AliGFWCumulant fEmptyCumulant;
   TComplex TwoRec(Int_t n1, Int_t n2, Int_t p1, Int_t p2, Int_t ptbin, AliGFWCumulant*, AliGFWCumulant*, AliGFWCumulant*);
   TComplex RecursiveCorr(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGFWCumulant *qol, Int_t ptbin, vector<Int_t> hars, vector<Int_t> pows={}); //POI, Ref. flow, overlapping region
+  TComplex RecursiveCorr(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGFWCumulant *qol, Int_t ptbin, const Int_t *hars, const Int_t *pows, Int_t nhars); //Same as above, but on plain arrays (no allocations)
+  TComplex CalculateCompiled(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGFWCumulant *qovl, const vector<Int_t> &hars, Int_t ptbin, Bool_t SetHarmsToZero);
   //Deprecated and not used (for now):
   void AddRegion(Region inreg) { fRegions.push_back(inreg); };
   Region GetRegion(Int_t index) { return fRegions.at(index); };
@@ -73,6 +83,11 @@ class AliGFW {
   TComplex Calculate(Int_t poi, vector<Int_t> hars); //For integrated case
   //Process one string (= one region)
   TComplex CalculateSingle(TString config);
+  Bool_t CompileSingle(TString config, CompiledSingle &target);
+  vector<Int_t> fBatchPt; //! Scratch arrays for batch filling
+  vector<Double_t> fBatchPhi; //!
+  vector<Double_t> fBatchWeight; //!
+  std::map<TString, vector<CompiledSingle> > fCompiledConfigs[2]; //! String configurations already parsed, w/o and w/ harmonics set to zero
 
   Bool_t SetHarmonicsToZero(TString &instr);
 
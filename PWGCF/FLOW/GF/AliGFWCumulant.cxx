@@ -1,7 +1,11 @@
 #include "AliGFWCumulant.h"
+#include <algorithm>
 
 AliGFWCumulant::AliGFWCumulant():
-  fQvector(0),
+  fQRe(0),
+  fQIm(0),
+  fHarOffset(0),
+  fStride(0),
   fUsed(kBlank),
   fNEntries(-1),
   fN(1),
@@ -23,41 +27,104 @@ void AliGFWCumulant::FillArray(Double_t eta, Int_t ptin, Double_t phi, Double_t
   if(fPt==1) ptin=0; //If one bin, then just fill it straight; otherwise, if ptin is out-of-range, do not fill
   else if(ptin<0 || ptin>=fPt) return;
   fFilledPts[ptin] = kTRUE;
+  Double_t *lQRe = fQRe + ptin*fStride;
+  Double_t *lQIm = fQIm + ptin*fStride;
   for(Int_t lN = 0; lN<fN; lN++) {
     Double_t lSin = TMath::Sin(lN*phi); //No need to recalculate for each power
     Double_t lCos = TMath::Cos(lN*phi); //No need to recalculate for each power
+    Double_t lPrefactor = 1.; //weight^lPow, updated by multiplication as cheaper than power
+    const Int_t lOffset = fHarOffset[lN];
     for(Int_t lPow=0; lPow<PW(lN); lPow++) {
-      Double_t lPrefactor = TMath::Power(weight, lPow); //Dont calculate it twice; multiplication is cheaper that power
-      Double_t qsin = lPrefactor * lSin;
-      Double_t qcos = lPrefactor * lCos;
-      fQvector[ptin][lN][lPow](fQvector[ptin][lN][lPow].Re()+qcos,fQvector[ptin][lN][lPow].Im()+qsin);//+=TComplex(qcos,qsin);
+      lQRe[lOffset+lPow] += lPrefactor * lCos;
+      lQIm[lOffset+lPow] += lPrefactor * lSin;
+      lPrefactor *= weight;
     };
   };
   Inc();
 };
-void AliGFWCumulant::ResetQs() {
-  if(!fNEntries) return; //If 0 entries, then no need to reset. Otherwise, if -1, then just initialized and need to set to 0.
-  for(Int_t i=0; i<fPt; i++) {
-    fFilledPts[i] = kFALSE;
-    for(Int_t lN=0;lN<fN;lN++) {
-      for(Int_t lPow=0;lPow<PW(lN);lPow++) {
-  	       fQvector[i][lN][lPow](0.,0.);
+void AliGFWCumulant::FillArrays(Int_t ntracks, const Int_t *ptin, const Double_t *phi, const Double_t *weight) {
+  //Fills a batch of tracks. Tracks are processed in blocks: e^{i*phi} is evaluated once per track,
+  //and higher harmonics and powers of the weight are obtained by recurrence (multiplication), so that
+  //the inner loops run over contiguous arrays of the block and can be vectorized by the compiler.
+  //Results agree with FillArray up to rounding.
+  if(!fInitialized)
+    CreateComplexVectorArray(1,1,1);
+  const Int_t kBlock = 64;
+  Double_t lPhi[kBlock];
+  Double_t lCos1[kBlock], lSin1[kBlock]; //e^{i*phi}
+  Double_t lCos[kBlock], lSin[kBlock]; //e^{i*n*phi}
+  Double_t lW[kBlock], lWPow[kBlock]; //weight and weight^p
+  Int_t lPt[kBlock];
+  Int_t iTrack=0;
+  while(iTrack<ntracks) {
+    //Collect the next block of tracks within the pt range
+    Int_t nBlock=0;
+    Bool_t lSinglePt=kTRUE;
+    for(;iTrack<ntracks && nBlock<kBlock;iTrack++) {
+      Int_t lPtBin = (fPt==1)?0:ptin[iTrack];
+      if(lPtBin<0 || lPtBin>=fPt) continue;
+      fFilledPts[lPtBin] = kTRUE;
+      lPt[nBlock] = lPtBin;
+      lPhi[nBlock] = phi[iTrack];
+      lW[nBlock] = weight[iTrack];
+      if(lPtBin!=lPt[0]) lSinglePt=kFALSE;
+      nBlock++;
+      Inc();
+    };
+    if(!nBlock) continue;
+    for(Int_t k=0;k<nBlock;k++) {
+      lSin1[k] = TMath::Sin(lPhi[k]);
+      lCos1[k] = TMath::Cos(lPhi[k]);
+      lCos[k] = 1.;
+      lSin[k] = 0.;
+    };
+    for(Int_t lN=0; lN<fN; lN++) {
+      if(lN>0) {
+        for(Int_t k=0;k<nBlock;k++) {
+          Double_t lTmp = lCos[k]*lCos1[k] - lSin[k]*lSin1[k];
+          lSin[k] = lSin[k]*lCos1[k] + lCos[k]*lSin1[k];
+          lCos[k] = lTmp;
+        };
+      };
+      for(Int_t k=0;k<nBlock;k++) lWPow[k] = 1.;
+      const Int_t lOffset = fHarOffset[lN];
+      for(Int_t lPow=0; lPow<PW(lN); lPow++) {
+        if(lSinglePt) {
+          //All tracks of the block in the same pt bin: plain reduction
+          Double_t lSumRe=0., lSumIm=0.;
+          for(Int_t k=0;k<nBlock;k++) {
+            lSumRe += lWPow[k]*lCos[k];
+            lSumIm += lWPow[k]*lSin[k];
+          };
+          fQRe[QIndex(lN,lPow,lPt[0])] += lSumRe;
+          fQIm[QIndex(lN,lPow,lPt[0])] += lSumIm;
+        } else {
+          for(Int_t k=0;k<nBlock;k++) {
+            Int_t ind = lPt[k]*fStride+lOffset+lPow;
+            fQRe[ind] += lWPow[k]*lCos[k];
+            fQIm[ind] += lWPow[k]*lSin[k];
+          };
+        };
+        for(Int_t k=0;k<nBlock;k++) lWPow[k] *= lW[k];
       };
     };
   };
+};
+void AliGFWCumulant::ResetQs() {
+  if(!fNEntries) return; //If 0 entries, then no need to reset. Otherwise, if -1, then just initialized and need to set to 0.
+  for(Int_t i=0; i<fPt; i++) fFilledPts[i] = kFALSE;
+  std::fill(fQRe,fQRe+fPt*fStride,0.);
+  std::fill(fQIm,fQIm+fPt*fStride,0.);
   fNEntries=0;
 };
 void AliGFWCumulant::DestroyComplexVectorArray() {
   if(!fInitialized) return;
-  for(Int_t l_n = 0; l_n<fN; l_n++) {
-    for(Int_t i=0;i<fPt;i++) {
-      delete [] fQvector[i][l_n];
-    };
-  };
-  for(Int_t i=0;i<fPt;i++) {
-    delete [] fQvector[i];
-  };
-  delete [] fQvector;
+  delete [] fQRe;
+  delete [] fQIm;
+  delete [] fHarOffset;
+  fQRe=0;
+  fQIm=0;
+  fHarOffset=0;
   delete [] fFilledPts;
   fInitialized=kFALSE;
   fNEntries=-1;
@@ -76,21 +143,24 @@ void AliGFWCumulant::CreateComplexVectorArrayVarPower(Int_t N, vector<Int_t> Pow
   fPt=Pt;
   fFilledPts = new Bool_t[Pt];
   fPowVec = PowVec;
-  fQvector = new TComplex**[fPt];
-  for(Int_t i=0;i<fPt;i++) {
-    fQvector[i] = new TComplex*[fN];
-  };
+  fHarOffset = new Int_t[fN];
+  fStride=0;
   for(Int_t l_n=0;l_n<fN;l_n++) {
-    for(Int_t i=0;i<fPt;i++) {
-      fQvector[i][l_n] = new TComplex[PW(l_n)];
-    };
+    fHarOffset[l_n]=fStride;
+    fStride+=PW(l_n);
   };
+  fQRe = new Double_t[fPt*fStride];
+  fQIm = new Double_t[fPt*fStride];
   ResetQs();
   fInitialized=kTRUE;
 };
 TComplex AliGFWCumulant::Vec(Int_t n, Int_t p, Int_t ptbin) {
   if(!fInitialized) return 0;
   if(ptbin>=fPt || ptbin<0) ptbin=0;
-  if(n>=0) return fQvector[ptbin][n][p];
-  return TComplex::Conjugate(fQvector[ptbin][-n][p]);
+  if(n>=0) {
+    Int_t ind = QIndex(n,p,ptbin);
+    return TComplex(fQRe[ind],fQIm[ind]);
+  };
+  Int_t ind = QIndex(-n,p,ptbin);
+  return TComplex(fQRe[ind],-fQIm[ind]);
 };
@@ -11,16 +11,24 @@ class AliGFWCumulant {
   ~AliGFWCumulant();
   void ResetQs();
   void FillArray(Double_t eta, Int_t ptin, Double_t phi, Double_t weight=1);
+  void FillArrays(Int_t ntracks, const Int_t *ptin, const Double_t *phi, const Double_t *weight); //Batch version of FillArray
   enum UsedFlags_t {kBlank = 0, kFull=1, kPt=2};
   void SetType(UInt_t infl) { DestroyComplexVectorArray(); fUsed = infl; };
   void Inc() { fNEntries++; };
   Int_t GetN() { return fNEntries; };
   // protected:
-  TComplex ***fQvector;
+  //Q-vectors are stored in flat, contiguous arrays of real and imaginary parts, indexed as
+  //[ptbin*fStride + fHarOffset[harmonic] + power]. All powers of one harmonic are adjacent,
+  //and all harmonics of one pt bin form one block
+  Double_t *fQRe; //! Real parts of Q-vectors
+  Double_t *fQIm; //! Imaginary parts of Q-vectors
+  Int_t *fHarOffset; //! Offset of each harmonic within one pt bin
+  Int_t fStride; //! Number of Q-vectors per pt bin
   UInt_t fUsed;
   Int_t fNEntries;
   //Q-vectors. Could be done recursively, but maybe defining each one of them explicitly is easier to read
   TComplex Vec(Int_t, Int_t, Int_t ptbin=0); //envelope class to summarize pt-dif. Q-vec getter
+  Int_t QIndex(Int_t n, Int_t p, Int_t ptbin) const { return ptbin*fStride+fHarOffset[n]+p; }; //No checks, n must be non-negative
   Int_t fN; //! Harmonics
   Int_t fPow; //! Power
   vector<Int_t> fPowVec; //! Powers array
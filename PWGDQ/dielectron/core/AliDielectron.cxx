@@ -160,6 +160,8 @@ AliDielectron::AliDielectron() :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fUseLightPairs(kFALSE),
+  fPairPool(),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -171,7 +173,7 @@ AliDielectron::AliDielectron() :
   //
   // Default constructor
   //
-
+  fPairPool.SetOwner();
 }
 
 //________________________________________________________________
@@ -237,6 +239,8 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fUseLightPairs(kFALSE),
+  fPairPool(),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -247,7 +251,7 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   //
   // Named constructor
   //
-
+  fPairPool.SetOwner();
 }
 
 //________________________________________________________________
@@ -1197,6 +1201,7 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
   Int_t ntrack2=arrTracks2.GetEntriesFast();
   AliDielectronPair candidate;
   candidate.SetKFUsage(fUseKF);
+  candidate.SetLightMode(fUseLightPairs);
   // flag arrays for track removal
   Bool_t *bTracks1 = new Bool_t[ntrack1];
   for (Int_t itrack1=0; itrack1<ntrack1; ++itrack1) bTracks1[itrack1]=kFALSE;
@@ -1416,8 +1421,7 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   Int_t ntrack1=arrTracks1.GetEntriesFast();
   Int_t ntrack2=arrTracks2.GetEntriesFast();
 
-  AliDielectronPair *candidate=new AliDielectronPair;
-  candidate->SetKFUsage(fUseKF);
+  AliDielectronPair *candidate=NewPairCandidate();
 
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
@@ -1464,12 +1468,26 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
       //add the candidate to the candidate array
       PairArray(pairIndex)->Add(candidate);
       //get a new candidate
-      candidate=new AliDielectronPair;
-      candidate->SetKFUsage(fUseKF);
+      candidate=NewPairCandidate();
     }
   }
-  //delete the surplus candidate
-  delete candidate;
+  //delete the surplus candidate (keep it for the next call in the light pair mode)
+  if (fUseLightPairs) fPairPool.Add(candidate);
+  else delete candidate;
+}
+
+//________________________________________________________________
+AliDielectronPair* AliDielectron::NewPairCandidate()
+{
+  //
+  // new pair candidate, in the light pair mode taken from the pool of pairs of the previous events
+  //
+  AliDielectronPair *candidate=0x0;
+  if (fUseLightPairs && fPairPool.GetEntriesFast()>0) candidate=static_cast<AliDielectronPair*>(fPairPool.RemoveLast());
+  else candidate=new AliDielectronPair;
+  candidate->SetKFUsage(fUseKF);
+  candidate->SetLightMode(fUseLightPairs);
+  return candidate;
 }
 
 //________________________________________________________________
@@ -89,6 +89,10 @@ public:
   void SetNoPairing(Bool_t noPairing=kTRUE) { fNoPairing=noPairing; }
   void SetProcessLS(Bool_t doLS=kTRUE) { fProcessLS=doLS; }
   void SetUseKF(Bool_t useKF=kTRUE) { fUseKF=useKF; }
+  // light pair mode: pair kinematics from the legs, KF particles only built for requested vertexing
+  // variables, pair objects are reused in the following events (see AliDielectronPair::SetLightMode)
+  void SetUseLightPairs(Bool_t light=kTRUE) { fUseLightPairs=light; }
+  Bool_t GetUseLightPairs() const { return fUseLightPairs; }
   const TObjArray* GetTrackArray(Int_t i) const {return (i>=0&&i<4)?&fTracks[i]:0;}
   const TObjArray* GetPairArray(Int_t i)  const {return (i>=0&&i<11)?
       static_cast<TObjArray*>(fPairCandidates->UncheckedAt(i)):0;}
@@ -273,12 +277,15 @@ private:
   Bool_t fDontClearArrays;      //Don't clear the arrays at the end of the Process function, needed for external use of pair and tracks
   Bool_t fEventProcess;         //Process event (or pair array)
   Bool_t fUseGammaTracks;       // use function SetGammaTracks for MCtruth photons
+  Bool_t fUseLightPairs;        // light pair mode
+  TObjArray fPairPool;          //! pair objects for reuse in the light pair mode
 
   void FillTrackArrays(AliVEvent * const ev, Int_t eventNr=0);
   void EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTracks1, TObjArray arrTracks2, const AliVEvent *ev);
   void PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1, TObjArray &arrTracks2, const AliVEvent *ev, Int_t prefilterN);
   void FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev = 0x0);
   void FillPairArrayTR();
+  AliDielectronPair* NewPairCandidate();
 
   Int_t GetPairIndex(Int_t arr1, Int_t arr2) const {return arr1>=arr2?arr1*(arr1+1)/2+arr2:arr2*(arr2+1)/2+arr1;}
 
@@ -312,7 +319,7 @@ private:
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,18);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
@@ -345,7 +352,17 @@ inline void AliDielectron::ClearArrays()
     fTracks[i].Clear();
   }
   for (Int_t i=0;i<11;++i){
-    if (PairArray(i)) PairArray(i)->Delete();
+    TObjArray *arr=PairArray(i);
+    if (!arr) continue;
+    if (fUseLightPairs) {
+      // move the pairs to the pool instead of deleting them
+      for (Int_t ipair=0; ipair<arr->GetEntriesFast(); ++ipair) fPairPool.Add(arr->UncheckedAt(ipair));
+      arr->SetOwner(kFALSE);
+      arr->Clear();
+      arr->SetOwner(kTRUE);
+    } else {
+      arr->Delete();
+    }
   }
 }
 
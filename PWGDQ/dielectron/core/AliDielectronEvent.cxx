@@ -28,10 +28,13 @@ Detailed description
 #include <TObjArray.h>
 #include <TExMap.h>
 #include <TProcessID.h>
+#include <TClass.h>
+#include <TMath.h>
 
 #include <AliVTrack.h>
 #include <AliESDtrack.h>
 #include <AliAODTrack.h>
+#include <AliAODPid.h>
 
 #include "AliDielectronEvent.h"
 
@@ -46,6 +49,9 @@ AliDielectronEvent::AliDielectronEvent() :
   fNTracksP(0),
   fNTracksN(0),
   fIsAOD(kFALSE),
+  fIsCompact(kFALSE),
+  fCompactF(),
+  fCompactI(),
   fEventData(),
   fPID(0x0),
   fPIDIndex(0)
@@ -66,6 +72,9 @@ AliDielectronEvent::AliDielectronEvent(const char* name, const char* title) :
   fNTracksP(0),
   fNTracksN(0),
   fIsAOD(kFALSE),
+  fIsCompact(kFALSE),
+  fCompactF(),
+  fCompactI(),
   fEventData(),
   fPID(0x0),
   fPIDIndex(0)
@@ -101,6 +110,11 @@ void AliDielectronEvent::SetTracks(const TObjArray &arrP, const TObjArray &arrN,
   fNTracksN=0;
   fNTracksP=0;
 
+  if (fIsCompact){
+    SetCompactTracks(arrP,arrN);
+    return;
+  }
+
   //check size of the arrays
   if (fArrTrackP.GetSize()<arrP.GetSize()) {
     fArrTrackP.Expand(arrP.GetSize());
@@ -183,6 +197,162 @@ void AliDielectronEvent::SetTracks(const TObjArray &arrP, const TObjArray &arrN,
   //TODO: pair arrays
 }
 
+//______________________________________________
+void AliDielectronEvent::SetCompactTracks(const TObjArray &arrP, const TObjArray &arrN)
+{
+  //
+  // store a compact record per track instead of a full copy,
+  // positive tracks first followed by the negative ones.
+  // The record arrays only grow, so that the event slot of a pool
+  // does not need to be reallocated for each event
+  //
+  const Int_t nTracks=arrP.GetEntriesFast()+arrN.GetEntriesFast();
+  if (fCompactF.GetSize()<nTracks*kNCompactFloats) fCompactF.Set(nTracks*kNCompactFloats);
+  if (fCompactI.GetSize()<nTracks*kNCompactInts)   fCompactI.Set(nTracks*kNCompactInts);
+
+  Int_t tracks=0;
+  for (Int_t itrack=0; itrack<arrP.GetEntriesFast(); ++itrack){
+    const AliVTrack *track=dynamic_cast<AliVTrack*>(arrP.At(itrack));
+    if (!track) continue;
+    SetCompactRecord(tracks,*track);
+    ++tracks;
+  }
+  fNTracksP=tracks;
+
+  for (Int_t itrack=0; itrack<arrN.GetEntriesFast(); ++itrack){
+    const AliVTrack *track=dynamic_cast<AliVTrack*>(arrN.At(itrack));
+    if (!track) continue;
+    SetCompactRecord(tracks,*track);
+    ++tracks;
+  }
+  fNTracksN=tracks-fNTracksP;
+}
+
+//______________________________________________
+void AliDielectronEvent::SetCompactRecord(Int_t itrack, const AliVTrack &track)
+{
+  //
+  // fill the compact record 'itrack' with the kinematics, charge,
+  // PID signals and track bits needed to re-run the pair cuts
+  //
+  Float_t *f=fCompactF.GetArray()+itrack*kNCompactFloats;
+  Int_t   *i=fCompactI.GetArray()+itrack*kNCompactInts;
+
+  Double_t p[3]={0.};
+  Double_t x[3]={0.};
+  Double_t cov[21]={0.};
+  track.PxPyPz(p);
+  track.GetXYZ(x);
+  track.GetCovarianceXYZPxPyPz(cov);
+  for (Int_t j=0; j<3; ++j){
+    f[kCPx+j]=p[j];
+    f[kCX+j] =x[j];
+  }
+  for (Int_t j=0; j<21; ++j) f[kCCov+j]=cov[j];
+
+  f[kCTPCsignal]=track.GetTPCsignal();
+  f[kCTPCmom]   =track.GetTPCmomentum();
+  f[kCITSsignal]=track.GetITSsignal();
+  f[kCTOFsignal]=track.GetTOFsignal();
+
+  const AliAODTrack *aodTrack=dynamic_cast<const AliAODTrack*>(&track);
+  const AliESDtrack *esdTrack=dynamic_cast<const AliESDtrack*>(&track);
+  f[kCChi2perNDF]=0.;
+  if (aodTrack) {
+    f[kCChi2perNDF]=aodTrack->Chi2perNDF();
+  } else if (esdTrack && esdTrack->GetTPCNcls()>0) {
+    f[kCChi2perNDF]=esdTrack->GetTPCchi2()/esdTrack->GetTPCNcls();
+  }
+
+  const ULong_t status=track.GetStatus();
+  i[kCID]            =track.GetID();
+  i[kCLabel]         =track.GetLabel();
+  i[kCCharge]        =track.Charge();
+  i[kCStatusLow]     =(Int_t)(status&0xffffffff);
+  i[kCStatusHigh]    =(Int_t)((ULong64_t)status>>32);
+  i[kCFilterMap]     =aodTrack ? (Int_t)aodTrack->GetFilterMap() : 0;
+  i[kCITSClusterMap] =track.GetITSClusterMap();
+  i[kCTPCsignalN]    =track.GetTPCsignalN();
+  i[kCTPCCrossedRows]=TMath::Nint(track.GetTPCCrossedRows());
+}
+
+//______________________________________________
+Int_t AliDielectronEvent::BuildTracks(TClonesArray &buffer, Int_t offset, TObjArray &arrP, TObjArray &arrN) const
+{
+  //
+  // set up AliAODTracks from the compact track records for the mixing.
+  // The tracks are placed in 'buffer' starting at 'offset', objects already
+  // constructed in the buffer are reused. The tracks are added to arrP and arrN.
+  // Returns the index in 'buffer' after the last track used
+  //
+  const Int_t nTracks=fNTracksP+fNTracksN;
+  for (Int_t itrack=0; itrack<nTracks; ++itrack){
+    const Float_t *f=fCompactF.GetArray()+itrack*kNCompactFloats;
+    const Int_t   *i=fCompactI.GetArray()+itrack*kNCompactInts;
+
+    AliAODTrack *track=static_cast<AliAODTrack*>(buffer.ConstructedAt(offset+itrack));
+    // a reused track may have been referenced by a pair of an earlier round:
+    // drop it from the object table and clear its unique ID, such that a new TRef
+    // to it gets a new ID instead of one that may resolve to another object
+    if (track->TestBit(kIsReferenced)){
+      TProcessID *processID=TProcessID::GetProcessWithUID(track);
+      if (processID) processID->RecursiveRemove(track);
+      track->ResetBit(kIsReferenced);
+      track->SetUniqueID(0);
+    }
+
+    Double_t p[3]  ={f[kCPx],f[kCPy],f[kCPz]};
+    Double_t x[3]  ={f[kCX],f[kCY],f[kCZ]};
+    Double_t cov[21]={0.};
+    for (Int_t j=0; j<21; ++j) cov[j]=f[kCCov+j];
+    track->SetP(p,kTRUE);
+    track->SetPosition(x,kFALSE);
+    track->SetCovMatrix(cov);
+    track->SetChi2perNDF(f[kCChi2perNDF]);
+    track->SetProdVertex(0x0);
+
+    track->SetID(i[kCID]);
+    track->SetLabel(i[kCLabel]);
+    track->SetCharge(i[kCCharge]);
+    track->SetFlags((ULong_t)(((ULong64_t)(UInt_t)i[kCStatusHigh]<<32) | (UInt_t)i[kCStatusLow]));
+    track->SetFilterMap((UInt_t)i[kCFilterMap]);
+    track->SetITSClusterMap(i[kCITSClusterMap]);
+    track->SetTPCNCrossedRows(i[kCTPCCrossedRows]);
+
+    AliAODPid *pid=track->GetDetPid();
+    if (!pid) {
+      pid=new AliAODPid;
+      track->SetDetPID(pid);
+    }
+    pid->SetTPCsignal(f[kCTPCsignal]);
+    pid->SetTPCsignalN(i[kCTPCsignalN]);
+    pid->SetTPCmomentum(f[kCTPCmom]);
+    pid->SetITSsignal(f[kCITSsignal]);
+    pid->SetTOFsignal(f[kCTOFsignal]);
+
+    if (itrack<fNTracksP) arrP.Add(track);
+    else arrN.Add(track);
+  }
+  return offset+nTracks;
+}
+
+//______________________________________________
+Long64_t AliDielectronEvent::GetMemoryUsage() const
+{
+  //
+  // approximate memory in bytes allocated for the buffered tracks of this event.
+  // For full track copies only the size of the objects is counted,
+  // memory allocated by the tracks themselves comes on top
+  //
+  if (fIsCompact) return (Long64_t)fCompactF.GetSize()*sizeof(Float_t)+(Long64_t)fCompactI.GetSize()*sizeof(Int_t);
+
+  Long64_t size=0;
+  if (fArrTrackP.GetClass()) size+=(Long64_t)fArrTrackP.GetClass()->Size()*fNTracksP;
+  if (fArrTrackN.GetClass()) size+=(Long64_t)fArrTrackN.GetClass()->Size()*fNTracksN;
+  size+=(Long64_t)sizeof(AliAODVertex)*fArrVertex.GetEntriesFast();
+  return size;
+}
+
 //______________________________________________
 void AliDielectronEvent::Clear(Option_t *opt)
 {
@@ -15,15 +15,26 @@
 
 #include <TNamed.h>
 #include <TClonesArray.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
 
 #include "AliDielectronVarManager.h"
 
 
 class TObjArray;
 class TProcessID;
+class AliVTrack;
 
 class AliDielectronEvent : public TNamed {
 public:
+  // layout of the compact per-track records, see SetCompact
+  enum ECompactFloat { kCPx=0, kCPy, kCPz, kCX, kCY, kCZ, kCCov,
+                       kCTPCsignal=kCCov+21, kCTPCmom, kCITSsignal, kCTOFsignal, kCChi2perNDF,
+                       kNCompactFloats };
+  enum ECompactInt   { kCID=0, kCLabel, kCCharge, kCStatusLow, kCStatusHigh, kCFilterMap,
+                       kCITSClusterMap, kCTPCsignalN, kCTPCCrossedRows,
+                       kNCompactInts };
+
   AliDielectronEvent();
   AliDielectronEvent(const char*name, const char* title);
 
@@ -33,6 +44,9 @@ public:
   void SetAOD(Int_t sizeP=1000, Int_t sizeN=1000);
   Bool_t IsAOD() const { return fIsAOD; }
 
+  void SetCompact(Bool_t compact=kTRUE) { fIsCompact=compact; }
+  Bool_t IsCompact() const { return fIsCompact; }
+
   void SetTracks(const TObjArray &arrP, const TObjArray &arrN, const TObjArray &arrPairs);
   void SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues]);
   const Double_t* GetEventData() const {return fEventData;}
@@ -44,6 +58,9 @@ public:
   Int_t GetNTracksP() const { return fNTracksP; }
   Int_t GetNTracksN() const { return fNTracksN; }
 
+  Int_t BuildTracks(TClonesArray &buffer, Int_t offset, TObjArray &arrP, TObjArray &arrN) const;
+  Long64_t GetMemoryUsage() const;
+
   void SetProcessID(TProcessID *pid) { fPID=pid;    }
   const TProcessID* GetProcessID()   { return fPID; }
   
@@ -61,6 +78,10 @@ private:
   Int_t fNTracksN;              //number of negative tracks
 
   Bool_t fIsAOD;                // if we deal with AODs
+  Bool_t fIsCompact;            // store compact track records instead of track copies
+
+  TArrayF fCompactF;            // float part of the compact track records, positive tracks first
+  TArrayI fCompactI;            // integer part of the compact track records
 
   Double_t fEventData[AliDielectronVarManager::kNMaxValues]; // event informaion from the var manager
 
@@ -71,8 +92,10 @@ private:
   AliDielectronEvent &operator=(const AliDielectronEvent &c);
 
   void AssignID(TObject *obj);
+  void SetCompactTracks(const TObjArray &arrP, const TObjArray &arrN);
+  void SetCompactRecord(Int_t itrack, const AliVTrack &track);
   
-  ClassDef(AliDielectronEvent,1)         // Dielectron Event
+  ClassDef(AliDielectronEvent,2)         // Dielectron Event
 };
 
 
@@ -50,6 +50,8 @@ AliDielectronMixingHandler::AliDielectronMixingHandler() :
   fMixIncomplete(kTRUE),
   fMoveToSameVertex(kFALSE),
   fSkipFirstEvt(kFALSE),
+  fCompactTracks(kFALSE),
+  fMixTracks("AliAODTrack",1000),
   fPID(0x0),
   fPIDobjectCount(1)
 {
@@ -72,6 +74,8 @@ AliDielectronMixingHandler::AliDielectronMixingHandler(const char* name, const c
   fMixIncomplete(kTRUE),
   fMoveToSameVertex(kFALSE),
   fSkipFirstEvt(kFALSE),
+  fCompactTracks(kFALSE),
+  fMixTracks("AliAODTrack",1000),
   fPID(0x0),
   fPIDobjectCount(1)
 {
@@ -91,6 +95,7 @@ AliDielectronMixingHandler::~AliDielectronMixingHandler()
   // Default Destructor
   //
   fAxes.Delete();
+  fMixTracks.Delete();
   delete fPID;
 }
 
@@ -222,6 +227,7 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
         event->SetESD(diele->GetTrackArray(0)->GetEntriesFast(),diele->GetTrackArray(1)->GetEntriesFast());
     }
     event->SetProcessID(fPID);
+    event->SetCompact(fCompactTracks);
   } else {
     AliDebug(10,Form("use event at %d: %d",bin,index1));
      //printf("use event at %d: %d\n",bin,index1);
@@ -233,6 +239,8 @@ void AliDielectronMixingHandler::Fill(const AliVEvent *ev, AliDielectron *diele)
   //set current event position in ring buffer
   pool.SetUniqueID(index1);
 
+  FillPoolMemory(bin,diele);
+
   // increase counter for full bins
 //   if (diele->fHistos) {
 //     diele->fHistos->Fill("Mixing","Stats",0);
@@ -291,6 +299,12 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
   // TIter ev1N(ev1->GetTrackArrayN());
   TIter ev1P(&arrTrDummy[0]);
   TIter ev1N(&arrTrDummy[1]);
+
+  // tracks set up from compact records, they are referenced by the pairs
+  // and therefore have to stay valid until the next call
+  TObjArray arrCompactP;
+  TObjArray arrCompactN;
+  Int_t nMixTracks=0;
   
 
   for (Int_t i1=0; i1<pool.GetEntriesFast(); ++i1){
@@ -308,8 +322,17 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
     //setup track arrays
     ev1P.Reset();
     ev1N.Reset();
-    TIter ev2P(ev2->GetTrackArrayP());
-    TIter ev2N(ev2->GetTrackArrayN());
+    const TCollection *arrEv2P=ev2->GetTrackArrayP();
+    const TCollection *arrEv2N=ev2->GetTrackArrayN();
+    if (ev2->IsCompact()){
+      arrCompactP.Clear();
+      arrCompactN.Clear();
+      nMixTracks=ev2->BuildTracks(fMixTracks,nMixTracks,arrCompactP,arrCompactN);
+      arrEv2P=&arrCompactP;
+      arrEv2N=&arrCompactN;
+    }
+    TIter ev2P(arrEv2P);
+    TIter ev2N(arrEv2N);
 
     //
     //move tracks to the same vertex (vertex of the first event), if requested
@@ -375,6 +398,35 @@ void AliDielectronMixingHandler::DoMixing(TClonesArray &pool, AliDielectron *die
   AliDielectronVarManager::SetEventData(values);
 }
 
+//______________________________________________
+Long64_t AliDielectronMixingHandler::GetPoolMemoryUsage(Int_t bin) const
+{
+  //
+  // approximate memory in bytes used by the buffered tracks of pool 'bin'
+  //
+  const TClonesArray *pool=static_cast<const TClonesArray*>(fArrPools.At(bin));
+  if (!pool) return 0;
+
+  Long64_t size=0;
+  for (Int_t ievent=0; ievent<pool->GetEntriesFast(); ++ievent){
+    const AliDielectronEvent *event=static_cast<const AliDielectronEvent*>(pool->At(ievent));
+    if (event) size+=event->GetMemoryUsage();
+  }
+  return size;
+}
+
+//______________________________________________
+void AliDielectronMixingHandler::FillPoolMemory(Int_t bin, AliDielectron *diele) const
+{
+  //
+  // update the memory report of pool 'bin'
+  //
+  if (!diele->fHistos) return;
+  TH1 *h=diele->fHistos->GetHistogram("Mixing","PoolMemory");
+  if (!h) return;
+  h->SetBinContent(bin+1,GetPoolMemoryUsage(bin)/1024.);
+}
+
 //______________________________________________
 Bool_t AliDielectronMixingHandler::MixRemaining(AliDielectron */*diele*/, Int_t /*ipool*/)
 {
@@ -433,6 +485,14 @@ void AliDielectronMixingHandler::Init(const AliDielectron *diele)
 
   if(diele && diele->DoEventProcess()) fArrPools.Expand(size);
 
+  //memory report of the pools if we have a histogram manager
+  if (diele && diele->fHistos && diele->DoEventProcess()) {
+    if (!diele->fHistos->GetHistogramList()->FindObject("Mixing")) diele->fHistos->AddClass("Mixing");
+    diele->fHistos->UserHistogram("Mixing","PoolMemory",
+                                  Form("Buffered tracks (%s);pool;memory (kB)",fCompactTracks?"compact records":"track copies"),
+                                  size,0,size,AliDielectronHistos::kNoAutoFill);
+  }
+
   //add statics histogram if we have a histogram manager
   //if (diele && diele->fHistos && diele->DoEventProcess()) {
   //  diele->fHistos->AddClass("Mixing");
@@ -55,6 +55,13 @@ public:
 
   void SetSkipFirstEvent(Bool_t skip) { fSkipFirstEvt=skip; }
 
+  // store compact track records in the pools instead of full track copies,
+  // the tracks are set up as AliAODTracks for the mixing
+  void SetCompactTracks(Bool_t compact=kTRUE) { fCompactTracks=compact; }
+  Bool_t GetCompactTracks() const { return fCompactTracks; }
+
+  Long64_t GetPoolMemoryUsage(Int_t bin) const;
+
   Int_t GetNumberOfBins() const;
   Int_t FindBin(const Double_t values[], TString *dim=0x0);
   void Fill(const AliVEvent *ev, AliDielectron *diele);
@@ -76,18 +83,22 @@ private:
   Bool_t fMixIncomplete;  // whether to mix uncomplete bins at the end of the processing
   Bool_t fMoveToSameVertex; //whether to move the mixed tracks to the same vertex position
   Bool_t fSkipFirstEvt;   //whether to skip the first event in the pool
+  Bool_t fCompactTracks;  //whether to store compact track records in the pools
+
+  TClonesArray fMixTracks; //! tracks set up from the compact records of a pool
 
   TProcessID *fPID;       //! internal PID for references to buffered objects
   UInt_t fPIDobjectCount; // object counter for TRefs to buffered objects
                           // needed for event mixing, see AliDielectronMixingHandler.cxx
   
   void DoMixing(TClonesArray &pool, AliDielectron *diele);
+  void FillPoolMemory(Int_t bin, AliDielectron *diele) const;
 
   AliDielectronMixingHandler(const AliDielectronMixingHandler &c);
   AliDielectronMixingHandler &operator=(const AliDielectronMixingHandler &c);
 
   
-  ClassDef(AliDielectronMixingHandler,1)         // Dielectron MixingHandler
+  ClassDef(AliDielectronMixingHandler,2)         // Dielectron MixingHandler
 };
 
 
@@ -21,6 +21,8 @@
 
 
 #include <TDatabasePDG.h>
+#include <TVector2.h>
+#include <TVector3.h>
 #include <AliVTrack.h>
 #include <AliVVertex.h>
 #include <AliPID.h>
@@ -44,12 +46,20 @@ AliDielectronPair::AliDielectronPair() :
   fD2(),
   fRefD1(),
   fRefD2(),
-  fKFUsage(kTRUE)
+  fKFUsage(kTRUE),
+  fLightMode(kFALSE),
+  fLightKinematics(kFALSE),
+  fKFPending(kFALSE),
+  fLightSwapped(kFALSE)
 {
   //
   // Default Constructor
   //
-  
+  fLightLeg[0]=fLightLeg[1]=0x0;
+  fLightPid[0]=fLightPid[1]=0;
+  fLightQ[0]=fLightQ[1]=0;
+  for (Int_t i=0; i<4; ++i) fLightP[i]=0.;
+  for (Int_t i=0; i<3; ++i) fLightLegP[0][i]=fLightLegP[1][i]=0.;
 }
 
 //______________________________________________
@@ -63,7 +73,11 @@ AliDielectronPair::AliDielectronPair(AliVTrack * const particle1, Int_t pid1,
   fD2(),
   fRefD1(),
   fRefD2(),
-  fKFUsage(kTRUE)
+  fKFUsage(kTRUE),
+  fLightMode(kFALSE),
+  fLightKinematics(kFALSE),
+  fKFPending(kFALSE),
+  fLightSwapped(kFALSE)
 {
   //
   // Constructor with tracks
@@ -84,7 +98,11 @@ AliDielectronPair::AliDielectronPair(const AliKFParticle * const particle1,
   fD2(),
   fRefD1(),
   fRefD2(),
-  fKFUsage(kTRUE)
+  fKFUsage(kTRUE),
+  fLightMode(kFALSE),
+  fLightKinematics(kFALSE),
+  fKFPending(kFALSE),
+  fLightSwapped(kFALSE)
 {
   //
   // Constructor with tracks
@@ -110,7 +128,16 @@ void AliDielectronPair::SetTracks(AliVTrack * const particle1, Int_t pid1,
   // set AliKF daughters and pair
   // refParticle1 and 2 are the original tracks. In the case of track rotation
   // they are needed in the framework
+  // In the light mode only the four-vectors of the legs are stored, the KF particles
+  // are built on first use (see BuildKF)
   //
+  if (fLightMode) {
+    SetLightTracks(particle1, pid1, particle2, pid2);
+    return;
+  }
+  fLightKinematics=kFALSE;
+  fKFPending=kFALSE;
+
   fPair.Initialize();
   fD1.Initialize();
   fD2.Initialize();
@@ -158,6 +185,8 @@ void AliDielectronPair::SetGammaTracks(AliVTrack * const particle1, Int_t pid1,
   // refParticle1 and 2 are the original tracks. In the case of track rotation
   // they are needed in the framework
   //
+  fLightKinematics=kFALSE;
+  fKFPending=kFALSE;
   fD1.Initialize();
   fD2.Initialize();
 
@@ -205,6 +234,8 @@ void AliDielectronPair::SetTracks(const AliKFParticle * const particle1,
   // refParticle1 and 2 are the original tracks. In the case of track rotation
   // they are needed in the framework
   //
+  fLightKinematics=kFALSE;
+  fKFPending=kFALSE;
   fPair.Initialize();
   fD1.Initialize();
   fD2.Initialize();
@@ -243,14 +274,167 @@ void AliDielectronPair::SetTracks(const AliKFParticle * const particle1,
   }
 }
 
+//______________________________________________
+void AliDielectronPair::SetLightTracks(AliVTrack * const particle1, Int_t pid1,
+                                       AliVTrack * const particle2, Int_t pid2)
+{
+  //
+  // Light mode: same daughter ordering as SetTracks, but only the leg momenta
+  // and the pair four-vector are calculated
+  //
+  Bool_t swap=kFALSE;
+  if (fRandomizeDaughters) swap=!(fRandom3.Rndm()>0.5);
+  else                     swap=!(particle1->Pt()>particle2->Pt());
+
+  fLightSwapped=swap;
+  fLightLeg[0]=swap?particle2:particle1;
+  fLightLeg[1]=swap?particle1:particle2;
+  fLightPid[0]=swap?pid2:pid1;
+  fLightPid[1]=swap?pid1:pid2;
+  fRefD1 = fLightLeg[0];
+  fRefD2 = fLightLeg[1];
+
+  fLightP[0]=fLightP[1]=fLightP[2]=fLightP[3]=0.;
+  for (Int_t ileg=0; ileg<2; ++ileg){
+    AliVTrack *leg=fLightLeg[ileg];
+    leg->PxPyPz(fLightLegP[ileg]);
+    fLightQ[ileg]=leg->Charge();
+    const Double_t mass=LegMass(fLightPid[ileg]);
+    const Double_t *p=fLightLegP[ileg];
+    fLightP[0]+=p[0];
+    fLightP[1]+=p[1];
+    fLightP[2]+=p[2];
+    fLightP[3]+=TMath::Sqrt(p[0]*p[0]+p[1]*p[1]+p[2]*p[2]+mass*mass);
+  }
+
+  fLightKinematics=kTRUE;
+  fKFPending=kTRUE;
+}
+
+//______________________________________________
+void AliDielectronPair::BuildKF() const
+{
+  //
+  // build the KF pair and daughters of a pair created in the light mode,
+  // the daughters are added in the order they were passed to SetTracks
+  //
+  fKFPending=kFALSE;
+
+  fPair.Initialize();
+  fD1.Initialize();
+  fD2.Initialize();
+
+  AliKFParticle kf1(*fLightLeg[0],fLightPid[0]);
+  AliKFParticle kf2(*fLightLeg[1],fLightPid[1]);
+
+  if (fLightSwapped) {
+    fPair.AddDaughter(kf2);
+    fPair.AddDaughter(kf1);
+  } else {
+    fPair.AddDaughter(kf1);
+    fPair.AddDaughter(kf2);
+  }
+  fD1+=kf1;
+  fD2+=kf2;
+}
+
+//______________________________________________
+Double_t AliDielectronPair::LegMass(Int_t pid)
+{
+  //
+  // mass of the leg hypothesis, as used for the KF particles
+  //
+  static Int_t    lastPid=0;
+  static Double_t lastMass=0.;
+  if (pid!=lastPid){
+    TParticlePDG *part=TDatabasePDG::Instance()->GetParticle(pid);
+    lastMass=part?part->Mass():0.13957; // default of AliKFParticle
+    lastPid=pid;
+  }
+  return lastMass;
+}
+
+//______________________________________________
+void AliDielectronPair::GetDaughterMomenta(Double_t p1[3], Double_t p2[3], Short_t &q1, Short_t &q2) const
+{
+  //
+  // momenta and charges of the first and second daughter
+  //
+  if (fLightKinematics) {
+    for (Int_t i=0; i<3; ++i){
+      p1[i]=fLightLegP[0][i];
+      p2[i]=fLightLegP[1][i];
+    }
+    q1=fLightQ[0];
+    q2=fLightQ[1];
+    return;
+  }
+  p1[0]=fD1.GetPx(); p1[1]=fD1.GetPy(); p1[2]=fD1.GetPz();
+  p2[0]=fD2.GetPx(); p2[1]=fD2.GetPy(); p2[2]=fD2.GetPz();
+  q1=fD1.GetQ();
+  q2=fD2.GetQ();
+}
+
+//______________________________________________
+Double_t AliDielectronPair::M() const
+{
+  //
+  // invariant mass, negative for space-like four-vectors (as AliKFParticle::GetMass)
+  //
+  if (!fLightKinematics) return fPair.GetMass();
+  const Double_t m2=fLightP[3]*fLightP[3]-fLightP[0]*fLightP[0]-fLightP[1]*fLightP[1]-fLightP[2]*fLightP[2];
+  return (m2<0.)?-TMath::Sqrt(-m2):TMath::Sqrt(m2);
+}
+
+//______________________________________________
+Double_t AliDielectronPair::Eta() const
+{
+  //
+  // pseudo-rapidity of the pair
+  //
+  if (!fLightKinematics) return fPair.GetEta();
+  return TVector3(fLightP[0],fLightP[1],fLightP[2]).Eta();
+}
+
+//______________________________________________
+Double_t AliDielectronPair::OpeningAngle() const
+{
+  //
+  // opening angle of the daughters (of the leg momenta in the light mode)
+  //
+  if (!fLightKinematics) return fD1.GetAngle(fD2);
+  return TVector3(fLightLegP[0]).Angle(TVector3(fLightLegP[1]));
+}
+
+//______________________________________________
+Double_t AliDielectronPair::DeltaEta() const
+{
+  //
+  // pseudo-rapidity difference of the daughters
+  //
+  if (!fLightKinematics) return TMath::Abs(fD1.GetEta()-fD2.GetEta());
+  return TMath::Abs(TVector3(fLightLegP[0]).Eta()-TVector3(fLightLegP[1]).Eta());
+}
+
+//______________________________________________
+Double_t AliDielectronPair::DeltaPhi() const
+{
+  //
+  // opening angle of the daughters in the transverse plane
+  //
+  if (!fLightKinematics) return fD1.GetAngleXY(fD2);
+  return TMath::Abs(TVector2(fLightLegP[0][0],fLightLegP[0][1]).DeltaPhi(TVector2(fLightLegP[1][0],fLightLegP[1][1])));
+}
+
 //______________________________________________
 void AliDielectronPair::GetThetaPhiCM(Double_t &thetaHE, Double_t &phiHE, Double_t &thetaCS, Double_t &phiCS) const
 {
   //
   // Calculate theta and phi in helicity and Collins-Soper coordinate frame
   //
-  Double_t pxyz1[3]={fD1.GetPx(),fD1.GetPy(),fD1.GetPz()};
-  Double_t pxyz2[3]={fD2.GetPx(),fD2.GetPy(),fD2.GetPz()};
+  Double_t pxyz1[3], pxyz2[3];
+  Short_t legQ1, legQ2;
+  GetDaughterMomenta(pxyz1,pxyz2,legQ1,legQ2);
   Double_t eleMass=AliPID::ParticleMass(AliPID::kElectron);
   Double_t proMass=AliPID::ParticleMass(AliPID::kProton);
   
@@ -286,7 +470,7 @@ void AliDielectronPair::GetThetaPhiCM(Double_t &thetaHE, Double_t &phiHE, Double
   TVector3 xAxisCS = (yAxis.Cross(zAxisCS)).Unit();
   
   // fill theta and phi
-  if(fD1.GetQ()>0){
+  if(legQ1>0){
     thetaHE = zAxisHE.Dot((p1Mom.Vect()).Unit());
     thetaCS = zAxisCS.Dot((p1Mom.Vect()).Unit());
     phiHE   = TMath::ATan2((p1Mom.Vect()).Dot(yAxis), (p1Mom.Vect()).Dot(xAxisHE));
@@ -305,6 +489,7 @@ Double_t AliDielectronPair::PsiPair(Double_t MagField) const
 {
   //Following idea to use opening of colinear pairs in magnetic field from e.g. PHENIX
   //to ID conversions. Adapted from AliTRDv0Info class
+  if (fKFPending) BuildKF();
   Double_t x, y;//, z;
   x = fPair.GetX();
   y = fPair.GetY();
@@ -424,6 +609,9 @@ Double_t AliDielectronPair::ThetaPhiCM(Bool_t isHE, Bool_t isTheta) const {
   // The function calculates theta and phi in the mother rest frame with 
   // respect to the helicity coordinate system and Collins-Soper coordinate system
   // TO DO: generalize for different decays (only J/Psi->e+e- now)
+  Double_t legP1[3], legP2[3];
+  Short_t legQ1, legQ2;
+  GetDaughterMomenta(legP1,legP2,legQ1,legQ2);
 
   // Laboratory frame 4-vectors:
   // projectile beam & target beam 4-mom
@@ -465,13 +653,13 @@ Double_t AliDielectronPair::ThetaPhiCM(Bool_t isHE, Bool_t isTheta) const {
 
   // return either theta or phi
   if(isTheta) {
-    if(fD1.GetQ()>0) 
+    if(legQ1>0) 
       return zAxis.Dot((p1Mom.Vect()).Unit());
     else
       return zAxis.Dot((p2Mom.Vect()).Unit());
   }
   else {
-    if(fD1.GetQ()>0)
+    if(legQ1>0)
       return TMath::ATan2((p1Mom.Vect()).Dot(yAxis), (p1Mom.Vect()).Dot(xAxis));
     else
       return TMath::ATan2((p2Mom.Vect()).Dot(yAxis), (p2Mom.Vect()).Dot(xAxis));
@@ -483,6 +671,7 @@ Double_t AliDielectronPair::GetCosPointingAngle(const AliVVertex *primVtx) const
   //
   // Calculate the poiting angle of the pair to the primary vertex and take the cosine
   //
+  if (fKFPending) BuildKF();
   if(!primVtx) return -1.;
 
   Double_t deltaPos[3]; //vector between the reference point and the V0 vertex
@@ -505,14 +694,17 @@ Double_t AliDielectronPair::GetArmAlpha() const
   //
   // Calculate the Armenteros-Podolanski Alpha
   //
-  Int_t qD1 = fD1.GetQ();
-
-  TVector3 momNeg( (qD1<0?fD1.GetPx():fD2.GetPx()),
-		   (qD1<0?fD1.GetPy():fD2.GetPy()),
-		   (qD1<0?fD1.GetPz():fD2.GetPz()) );
-  TVector3 momPos( (qD1<0?fD2.GetPx():fD1.GetPx()),
-		   (qD1<0?fD2.GetPy():fD1.GetPy()),
-		   (qD1<0?fD2.GetPz():fD1.GetPz()) );
+  Double_t legP1[3], legP2[3];
+  Short_t legQ1, legQ2;
+  GetDaughterMomenta(legP1,legP2,legQ1,legQ2);
+  Int_t qD1 = legQ1;
+
+  TVector3 momNeg( (qD1<0?legP1[0]:legP2[0]),
+		   (qD1<0?legP1[1]:legP2[1]),
+		   (qD1<0?legP1[2]:legP2[2]) );
+  TVector3 momPos( (qD1<0?legP2[0]:legP1[0]),
+		   (qD1<0?legP2[1]:legP1[1]),
+		   (qD1<0?legP2[2]:legP1[2]) );
   TVector3 momTot(Px(),Py(),Pz());
 
   Double_t lQlNeg = momNeg.Dot(momTot)/momTot.Mag();
@@ -527,11 +719,14 @@ Double_t AliDielectronPair::GetArmPt() const
   //
   // Calculate the Armenteros-Podolanski Pt
   //
-  Int_t qD1 = fD1.GetQ();
-
-  TVector3 momNeg( (qD1<0?fD1.GetPx():fD2.GetPx()),
-		   (qD1<0?fD1.GetPy():fD2.GetPy()),
-		   (qD1<0?fD1.GetPz():fD2.GetPz()) );
+  Double_t legP1[3], legP2[3];
+  Short_t legQ1, legQ2;
+  GetDaughterMomenta(legP1,legP2,legQ1,legQ2);
+  Int_t qD1 = legQ1;
+
+  TVector3 momNeg( (qD1<0?legP1[0]:legP2[0]),
+		   (qD1<0?legP1[1]:legP2[1]),
+		   (qD1<0?legP1[2]:legP2[2]) );
   TVector3 momTot(Px(),Py(),Pz());
 
   return (momNeg.Perp(momTot));
@@ -587,66 +782,69 @@ Double_t AliDielectronPair::PhivPair(Double_t MagField) const
   /// at pi or at 0 depending on which leg has the higher momentum. (not checked yet)
   /// This expected ambiguity is not seen due to sorting of track arrays in this framework. 
   /// To reach the same result as for ULS (~pi), the legs are flipped for LS.
+  Double_t legP1[3], legP2[3];
+  Short_t legQ1, legQ2;
+  GetDaughterMomenta(legP1,legP2,legQ1,legQ2);
 
   //Define local buffer variables for leg properties
   Double_t px1=-9999.,py1=-9999.,pz1=-9999.;
   Double_t px2=-9999.,py2=-9999.,pz2=-9999.;
 
-  if (fD1.GetQ()*fD2.GetQ() > 0.) { // Like Sign
+  if (legQ1*legQ2 > 0.) { // Like Sign
     if(MagField<0){ // inverted behaviour
-      if(fD1.GetQ()>0){
-        px1 = fD1.GetPx();   py1 = fD1.GetPy();   pz1 = fD1.GetPz();
-        px2 = fD2.GetPx();   py2 = fD2.GetPy();   pz2 = fD2.GetPz();
+      if(legQ1>0){
+        px1 = legP1[0];   py1 = legP1[1];   pz1 = legP1[2];
+        px2 = legP2[0];   py2 = legP2[1];   pz2 = legP2[2];
       }else{
-        px1 = fD2.GetPx();   py1 = fD2.GetPy();   pz1 = fD2.GetPz();
-        px2 = fD1.GetPx();   py2 = fD1.GetPy();   pz2 = fD1.GetPz();
+        px1 = legP2[0];   py1 = legP2[1];   pz1 = legP2[2];
+        px2 = legP1[0];   py2 = legP1[1];   pz2 = legP1[2];
       }
     }else{
-      if(fD1.GetQ()>0){
-        px1 = fD2.GetPx();   py1 = fD2.GetPy();   pz1 = fD2.GetPz();
-        px2 = fD1.GetPx();   py2 = fD1.GetPy();   pz2 = fD1.GetPz();
+      if(legQ1>0){
+        px1 = legP2[0];   py1 = legP2[1];   pz1 = legP2[2];
+        px2 = legP1[0];   py2 = legP1[1];   pz2 = legP1[2];
       }else{
-        px1 = fD1.GetPx();   py1 = fD1.GetPy();   pz1 = fD1.GetPz();
-        px2 = fD2.GetPx();   py2 = fD2.GetPy();   pz2 = fD2.GetPz();
+        px1 = legP1[0];   py1 = legP1[1];   pz1 = legP1[2];
+        px2 = legP2[0];   py2 = legP2[1];   pz2 = legP2[2];
       }
     }
   }
   else { // Unlike Sign
   if(MagField>0){ // regular behaviour
-    if(fD1.GetQ()>0){
-      px1 = fD1.GetPx();
-      py1 = fD1.GetPy();
-      pz1 = fD1.GetPz();
-
-      px2 = fD2.GetPx();
-      py2 = fD2.GetPy();
-      pz2 = fD2.GetPz();
+    if(legQ1>0){
+      px1 = legP1[0];
+      py1 = legP1[1];
+      pz1 = legP1[2];
+
+      px2 = legP2[0];
+      py2 = legP2[1];
+      pz2 = legP2[2];
     }else{
-      px1 = fD2.GetPx();
-      py1 = fD2.GetPy();
-      pz1 = fD2.GetPz();
+      px1 = legP2[0];
+      py1 = legP2[1];
+      pz1 = legP2[2];
 
-      px2 = fD1.GetPx();
-      py2 = fD1.GetPy();
-      pz2 = fD1.GetPz();
+      px2 = legP1[0];
+      py2 = legP1[1];
+      pz2 = legP1[2];
     }
   }else{
-    if(fD1.GetQ()>0){
-      px1 = fD2.GetPx();
-      py1 = fD2.GetPy();
-      pz1 = fD2.GetPz();
-
-      px2 = fD1.GetPx();
-      py2 = fD1.GetPy();
-      pz2 = fD1.GetPz();
+    if(legQ1>0){
+      px1 = legP2[0];
+      py1 = legP2[1];
+      pz1 = legP2[2];
+
+      px2 = legP1[0];
+      py2 = legP1[1];
+      pz2 = legP1[2];
     }else{
-      px1 = fD1.GetPx();
-      py1 = fD1.GetPy();
-      pz1 = fD1.GetPz();
+      px1 = legP1[0];
+      py1 = legP1[1];
+      pz1 = legP1[2];
 
-      px2 = fD2.GetPx();
-      py2 = fD2.GetPy();
-      pz2 = fD2.GetPz();
+      px2 = legP2[0];
+      py2 = legP2[1];
+      pz2 = legP2[2];
     }
    }
   }
@@ -709,17 +907,20 @@ Double_t AliDielectronPair::GetPairPlaneAngle(Double_t v0rpH2, Int_t VariNum)con
 
   // Calculate the angle between electron pair plane and variables
   // kv0rpH2 is reaction plane angle using V0-A,C,AC,Random
+  Double_t legP1[3], legP2[3];
+  Short_t legQ1, legQ2;
+  GetDaughterMomenta(legP1,legP2,legQ1,legQ2);
 
   Double_t px1=-9999.,py1=-9999.,pz1=-9999.;
   Double_t px2=-9999.,py2=-9999.,pz2=-9999.;
 
-  px1 = fD1.GetPx();
-  py1 = fD1.GetPy();
-  pz1 = fD1.GetPz();
+  px1 = legP1[0];
+  py1 = legP1[1];
+  pz1 = legP1[2];
 
-  px2 = fD2.GetPx();
-  py2 = fD2.GetPy();
-  pz2 = fD2.GetPz();
+  px2 = legP2[0];
+  py2 = legP2[1];
+  pz2 = legP2[2];
 
   //p1+p2
   Double_t px = px1+px2;
@@ -820,26 +1021,30 @@ Double_t AliDielectronPair::PairPlaneMagInnerProduct(Double_t ZDCrpH1) const
 
   if(TMath::Abs(ZDCrpH1 - 999.) < 1e-10) return -9999.;
 
+  Double_t legP1[3], legP2[3];
+  Short_t legQ1, legQ2;
+  GetDaughterMomenta(legP1,legP2,legQ1,legQ2);
+
   Double_t px1=-9999.,py1=-9999.,pz1=-9999.;
   Double_t px2=-9999.,py2=-9999.,pz2=-9999.;
 
-  if(fD1.GetQ()<0){
-    px1 = fD1.GetPx();
-    py1 = fD1.GetPy();
-    pz1 = fD1.GetPz();
+  if(legQ1<0){
+    px1 = legP1[0];
+    py1 = legP1[1];
+    pz1 = legP1[2];
 
-    px2 = fD2.GetPx();
-    py2 = fD2.GetPy();
-    pz2 = fD2.GetPz();
+    px2 = legP2[0];
+    py2 = legP2[1];
+    pz2 = legP2[2];
 
   }else{
-    px1 = fD2.GetPx();
-    py1 = fD2.GetPy();
-    pz1 = fD2.GetPz();
+    px1 = legP2[0];
+    py1 = legP2[1];
+    pz1 = legP2[2];
 
-    px2 = fD1.GetPx();
-    py2 = fD1.GetPy();
-    pz2 = fD1.GetPz();
+    px2 = legP1[0];
+    py2 = legP1[1];
+    pz2 = legP1[2];
 
   }
 
@@ -886,12 +1091,15 @@ void AliDielectronPair::SetBeamEnergy(AliVEvent *ev, Double_t beamEbyHand)
 
 Double_t AliDielectronPair::DeltaCotTheta() const
 {
-  Double_t px1 = fD1.GetPx();
-  Double_t py1 = fD1.GetPy();
-  Double_t pz1 = fD1.GetPz();
-  Double_t px2 = fD2.GetPx();
-  Double_t py2 = fD2.GetPy();
-  Double_t pz2 = fD2.GetPz();
+  Double_t legP1[3], legP2[3];
+  Short_t legQ1, legQ2;
+  GetDaughterMomenta(legP1,legP2,legQ1,legQ2);
+  Double_t px1 = legP1[0];
+  Double_t py1 = legP1[1];
+  Double_t pz1 = legP1[2];
+  Double_t px2 = legP2[0];
+  Double_t py2 = legP2[1];
+  Double_t pz2 = legP2[2];
 
   Double_t cotTheta1 = (px1 != 0. || py1 !=0.) ? pz1 / TMath::Sqrt(px1*px1 + py1*py1) : 0.;
   Double_t cotTheta2 = (px2 != 0. || py2 !=0.) ? pz2 / TMath::Sqrt(px2*px2 + py2*py2) : 0.;
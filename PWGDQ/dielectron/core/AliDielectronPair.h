@@ -67,33 +67,33 @@ public:
 
   //AliVParticle interface
   // kinematics
-  virtual Double_t Px() const { return fPair.GetPx(); }
-  virtual Double_t Py() const { return fPair.GetPy(); }
-  virtual Double_t Pz() const { return fPair.GetPz(); }
-  virtual Double_t Pt() const { return fPair.GetPt(); }
-  virtual Double_t P() const  { return fPair.GetP();  }
+  virtual Double_t Px() const { return fLightKinematics ? fLightP[0] : fPair.GetPx(); }
+  virtual Double_t Py() const { return fLightKinematics ? fLightP[1] : fPair.GetPy(); }
+  virtual Double_t Pz() const { return fLightKinematics ? fLightP[2] : fPair.GetPz(); }
+  virtual Double_t Pt() const { return fLightKinematics ? TMath::Sqrt(fLightP[0]*fLightP[0]+fLightP[1]*fLightP[1]) : fPair.GetPt(); }
+  virtual Double_t P() const  { return fLightKinematics ? TMath::Sqrt(Pt()*Pt()+fLightP[2]*fLightP[2]) : fPair.GetP();  }
   virtual Bool_t   PxPyPz(Double_t p[3]) const { p[0]=Px(); p[1]=Py(); p[2]=Pz(); return kTRUE; }
 
-  virtual Double_t Xv() const { return fPair.GetX(); }
-  virtual Double_t Yv() const { return fPair.GetY(); }
-  virtual Double_t Zv() const { return fPair.GetZ(); }
+  virtual Double_t Xv() const { return KFPair().GetX(); }
+  virtual Double_t Yv() const { return KFPair().GetY(); }
+  virtual Double_t Zv() const { return KFPair().GetZ(); }
   virtual Bool_t   XvYvZv(Double_t x[3]) const { x[0]=Xv(); x[1]=Yv(); x[2]=Zv(); return kTRUE; }
 
   virtual Double_t OneOverPt() const { return Pt()>0.?1./Pt():0.; }  //TODO: check
-  virtual Double_t Phi()       const { return fPair.GetPhi();}
+  virtual Double_t Phi()       const { return fLightKinematics ? TMath::ATan2(fLightP[1],fLightP[0]) : fPair.GetPhi();}
   virtual Double_t Theta()     const { return Pz()!=0?TMath::ATan(Pt()/Pz()):0.; } //TODO: check
 
 
-  virtual Double_t E() const { return fPair.GetE();    }
-  virtual Double_t M() const { return fPair.GetMass(); }
+  virtual Double_t E() const { return fLightKinematics ? fLightP[3] : fPair.GetE();    }
+  virtual Double_t M() const;
 
-  virtual Double_t Eta() const { return fPair.GetEta();}
+  virtual Double_t Eta() const;
   virtual Double_t Y()  const  {
     if((E()*E()-Px()*Px()-Py()*Py()-Pz()*Pz())>0.) return TLorentzVector(Px(),Py(),Pz(),E()).Rapidity();
     else return -1111.;
   }
 
-  virtual Short_t Charge() const    { return fPair.GetQ();}
+  virtual Short_t Charge() const    { return fLightKinematics ? fLightQ[0]+fLightQ[1] : fPair.GetQ();}
   virtual Int_t   GetLabel() const  { return fLabel;      }
   // PID
   virtual const Double_t *PID() const { return 0;} //TODO: check
@@ -112,22 +112,22 @@ public:
   void SetPdgCode(Int_t pdgCode) { fPdgCode=pdgCode; }
   Int_t PdgCode() const {return fPdgCode;}
 
-  void SetProductionVertex(const AliKFParticle &Vtx) { fPair.SetProductionVertex(Vtx); }
+  void SetProductionVertex(const AliKFParticle &Vtx) { if (fKFPending) BuildKF(); fPair.SetProductionVertex(Vtx); }
 
   //inter leg information
-  Double_t GetKFChi2()            const { return fPair.GetChi2();                               }
-  Int_t    GetKFNdf()             const { return fPair.GetNDF();                                }
-  Double_t OpeningAngle()         const { return fD1.GetAngle(fD2);                             }
-  Double_t OpeningAngleXY()       const { return fD1.GetAngleXY(fD2);                           }
-  Double_t OpeningAngleRZ()       const { return fD1.GetAngleRZ(fD2);                           }
-  Double_t DistanceDaughters()    const { return fD1.GetDistanceFromParticle(fD2);              }
-  Double_t DistanceDaughtersXY()  const { return fD1.GetDistanceFromParticleXY(fD2);            }
-  Double_t DeviationDaughters()   const { return fD1.GetDeviationFromParticle(fD2);             }
-  Double_t DeviationDaughtersXY() const { return fD1.GetDeviationFromParticleXY(fD2);           }
-  Double_t DeltaEta()             const { return TMath::Abs(fD1.GetEta()-fD2.GetEta());         }
+  Double_t GetKFChi2()            const { return KFPair().GetChi2();                            }
+  Int_t    GetKFNdf()             const { return KFPair().GetNDF();                             }
+  Double_t OpeningAngle()         const;
+  Double_t OpeningAngleXY()       const { return KFFirstDaughter().GetAngleXY(fD2);             }
+  Double_t OpeningAngleRZ()       const { return KFFirstDaughter().GetAngleRZ(fD2);             }
+  Double_t DistanceDaughters()    const { return KFFirstDaughter().GetDistanceFromParticle(fD2);   }
+  Double_t DistanceDaughtersXY()  const { return KFFirstDaughter().GetDistanceFromParticleXY(fD2); }
+  Double_t DeviationDaughters()   const { return KFFirstDaughter().GetDeviationFromParticle(fD2);  }
+  Double_t DeviationDaughtersXY() const { return KFFirstDaughter().GetDeviationFromParticleXY(fD2);}
+  Double_t DeltaEta()             const;
 //   Double_t DeltaPhi()             const { Double_t dphi=TMath::Abs(fD1.GetPhi()-fD2.GetPhi());
 //                                           return (dphi>TMath::Pi())?dphi-TMath::Pi():dphi;      }
-  Double_t DeltaPhi()             const { return fD1.GetAngleXY(fD2);     }
+  Double_t DeltaPhi()             const;
   Double_t DeltaCotTheta()        const;
 
   // calculate cos(theta*) and phi* in HE and CS pictures
@@ -153,10 +153,13 @@ public:
   Double_t PairPlaneMagInnerProduct(Double_t ZDCrpH1) const;
 
 
-  // internal KF particle
-  const AliKFParticle& GetKFParticle()       const { return fPair; }
-  const AliKFParticle& GetKFFirstDaughter()  const { return fD1;   }
-  const AliKFParticle& GetKFSecondDaughter() const { return fD2;   }
+  // internal KF particle (built on first access in the light mode)
+  const AliKFParticle& GetKFParticle()       const { return KFPair();           }
+  const AliKFParticle& GetKFFirstDaughter()  const { return KFFirstDaughter();  }
+  const AliKFParticle& GetKFSecondDaughter() const { return KFSecondDaughter(); }
+
+  // leg momenta and charges, available without building the KF particles
+  void GetDaughterMomenta(Double_t p1[3], Double_t p2[3], Short_t &q1, Short_t &q2) const;
 
   // daughter references
   void SetRefFirstDaughter(AliVParticle * const track)  {fRefD1 = track;}
@@ -168,23 +171,47 @@ public:
   void SetKFUsage(Bool_t KFUsage) {fKFUsage = KFUsage;}
   Bool_t GetKFUsage() const {return fKFUsage;}
 
+  // light mode: SetTracks with tracks only computes the four-vector kinematics of the legs,
+  // the KF particles are built when a vertexing quantity is requested
+  void SetLightMode(Bool_t light=kTRUE) { fLightMode=light; }
+  Bool_t GetLightMode() const { return fLightMode; }
+  Bool_t IsKFBuilt() const { return !fKFPending; }
+
 
 
 private:
+  void SetLightTracks(AliVTrack * const particle1, Int_t pid1,
+                      AliVTrack * const particle2, Int_t pid2);
+  void BuildKF() const;
+  static Double_t LegMass(Int_t pid);
+  const AliKFParticle& KFPair()           const { if (fKFPending) BuildKF(); return fPair; }
+  const AliKFParticle& KFFirstDaughter()  const { if (fKFPending) BuildKF(); return fD1;   }
+  const AliKFParticle& KFSecondDaughter() const { if (fKFPending) BuildKF(); return fD2;   }
+
   Char_t   fType;         // type of the pair e.g. like sign SE, unlike sign SE, ... see AliDielectron
   Int_t    fLabel;        // MC label
   Int_t    fPdgCode;      // pdg code in case it is a MC particle
   static Double_t fBeamEnergy; //!beam energy
 
-  AliKFParticle fPair;   // KF particle internally used for pair calculation
-  AliKFParticle fD1;     // KF particle first daughter
-  AliKFParticle fD2;     // KF particle1 second daughter
+  mutable AliKFParticle fPair;   // KF particle internally used for pair calculation
+  mutable AliKFParticle fD1;     // KF particle first daughter
+  mutable AliKFParticle fD2;     // KF particle1 second daughter
 
   TRef fRefD1;           // Reference to first daughter
   TRef fRefD2;           // Reference to second daughter
 
   Bool_t fKFUsage;       // Use KF for vertexing
 
+  Bool_t fLightMode;           //! build pairs from tracks in the light mode
+  Bool_t fLightKinematics;     //! kinematics taken from the legs (pair built in the light mode)
+  mutable Bool_t fKFPending;   //! KF particles not built yet
+  AliVTrack *fLightLeg[2];     //! first and second daughter track
+  Int_t    fLightPid[2];       //! pdg codes of the daughters
+  Bool_t   fLightSwapped;      //! first daughter was passed as second particle to SetTracks
+  Double_t fLightP[4];         //! pair four-momentum (px,py,pz,E)
+  Double_t fLightLegP[2][3];   //! daughter momenta
+  Short_t  fLightQ[2];         //! daughter charges
+
   static Bool_t   fRandomizeDaughters;
   static TRandom3 fRandom3;
 
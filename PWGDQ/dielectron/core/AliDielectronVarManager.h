@@ -878,9 +878,10 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
   values[AliDielectronVarManager::kPtSq]      = particle->Pt()*particle->Pt();
   values[AliDielectronVarManager::kP]         = particle->P();
 
-  values[AliDielectronVarManager::kXv]        = particle->Xv();
-  values[AliDielectronVarManager::kYv]        = particle->Yv();
-  values[AliDielectronVarManager::kZv]        = particle->Zv();
+  // only if requested: for pairs in the light mode the vertex needs the KF particle
+  if(Req(kXv)) values[AliDielectronVarManager::kXv] = particle->Xv();
+  if(Req(kYv)) values[AliDielectronVarManager::kYv] = particle->Yv();
+  if(Req(kZv)) values[AliDielectronVarManager::kZv] = particle->Zv();
 
   values[AliDielectronVarManager::kOneOverPt] = (particle->Pt()>1.0e-3 ? particle->OneOverPt() : 0.0);
   values[AliDielectronVarManager::kPhi]       = TVector2::Phi_0_2pi(particle->Phi());
@@ -1722,7 +1723,8 @@ inline void AliDielectronVarManager::FillVarMCParticle(const AliMCParticle *part
   // distance of space point to a straight line
   // d = |b x (p-a)|/|b|
   TVector3 priVtx(values[AliDielectronVarManager::kXvPrim],values[AliDielectronVarManager::kYvPrim],values[AliDielectronVarManager::kZvPrim]);
-  TVector3 secVtx(values[AliDielectronVarManager::kXv],values[AliDielectronVarManager::kYv],values[AliDielectronVarManager::kZv]);
+  // kXv/kYv/kZv are only filled if requested, take the production vertex from the particle
+  TVector3 secVtx(particle->Xv(),particle->Yv(),particle->Zv());
   TVector3 momPart(values[AliDielectronVarManager::kPx],values[AliDielectronVarManager::kPy],values[AliDielectronVarManager::kPz]);
   priVtx -= secVtx;
   TVector3 denom = momPart.Cross(priVtx);
@@ -1934,7 +1936,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   FillVarVParticle(pair, values); // this also filles the event information into 'values'.
 
   // Fill AliDielectronPair specific information
-  const AliKFParticle &kfPair = pair->GetKFParticle();
+  // (the KF particle is only accessed for requested variables, in the light pair mode it is built on first access)
 
 
   values[AliDielectronVarManager::kThetaHE]      = 0.0;
@@ -1968,9 +1970,9 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     values[AliDielectronVarManager::kCosTilPhiCS]  = (thetaCS>0)?(TMath::Cos(phiCS-TMath::Pi()/4.)):(TMath::Cos(phiCS-3*TMath::Pi()/4.));
   }
 
-  if(Req(kChi2NDF))          values[AliDielectronVarManager::kChi2NDF]          = kfPair.GetChi2()/kfPair.GetNDF();
-  if(Req(kDecayLength))      values[AliDielectronVarManager::kDecayLength]      = kfPair.GetDecayLength();
-  if(Req(kR))                values[AliDielectronVarManager::kR]                = kfPair.GetR();
+  if(Req(kChi2NDF))          values[AliDielectronVarManager::kChi2NDF]          = pair->GetKFParticle().GetChi2()/pair->GetKFParticle().GetNDF();
+  if(Req(kDecayLength))      values[AliDielectronVarManager::kDecayLength]      = pair->GetKFParticle().GetDecayLength();
+  if(Req(kR))                values[AliDielectronVarManager::kR]                = pair->GetKFParticle().GetR();
   if(Req(kOpeningAngle))     values[AliDielectronVarManager::kOpeningAngle]     = pair->OpeningAngle();
   if(Req(kOpeningAngleXY))     values[AliDielectronVarManager::kOpeningAngleXY] = pair->OpeningAngleXY();
   if(Req(kOpeningAngleRZ))     values[AliDielectronVarManager::kOpeningAngleRZ] = pair->OpeningAngleRZ();
@@ -1980,7 +1982,10 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kLegDistXY)) values[AliDielectronVarManager::kLegDistXY]    = pair->DistanceDaughtersXY();
   if(Req(kDeltaEta))  values[AliDielectronVarManager::kDeltaEta]     = pair->DeltaEta();
   if(Req(kDeltaPhi))  values[AliDielectronVarManager::kDeltaPhi]     = pair->DeltaPhi();
-  if(Req(kMerr))      values[AliDielectronVarManager::kMerr]         = kfPair.GetErrMass()>1e-30&&kfPair.GetMass()>1e-30?kfPair.GetErrMass()/kfPair.GetMass():1000000;
+  if(Req(kMerr)) {
+    const AliKFParticle &kfPair = pair->GetKFParticle();
+    values[AliDielectronVarManager::kMerr]         = kfPair.GetErrMass()>1e-30&&kfPair.GetMass()>1e-30?kfPair.GetErrMass()/kfPair.GetMass():1000000;
+  }
 
   values[AliDielectronVarManager::kPairType]     = pair->GetType();
   // Armenteros-Podolanski quantities
@@ -2037,7 +2042,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) - 21. * pair->M() : -999.;
   if(Req(kPseudoProperTime) || Req(kPseudoProperTimeErr)) {
     values[AliDielectronVarManager::kPseudoProperTime] =
-      fgEvent ? kfPair.GetPseudoProperDecayTime(*(fgEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
+      fgEvent ? pair->GetKFParticle().GetPseudoProperDecayTime(*(fgEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
       // values[AliDielectronVarManager::kPseudoProperTime] = fgEvent ? pair->GetPseudoProperTime(fgEvent->GetPrimaryVertex()): -1e10;
     values[AliDielectronVarManager::kPseudoProperTimeErr] = (errPseudoProperTime2 > 0) ? TMath::Sqrt(errPseudoProperTime2) : -1e10;
   }
@@ -2191,8 +2196,10 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   	//particles are copied in the Pair-Object
   	static const Double_t mElectron = AliPID::ParticleMass(AliPID::kElectron); // MeV
 
-  	const AliKFParticle& fD1 = pair->GetKFFirstDaughter();
-  	const AliKFParticle& fD2 = pair->GetKFSecondDaughter();
+  	//(leg momenta without building the KF particles in the light pair mode)
+  	Double_t legP1[3], legP2[3];
+  	Short_t legQ1, legQ2;
+  	pair->GetDaughterMomenta(legP1,legP2,legQ1,legQ2);
 
   	//Define local buffer variables for leg properties
   	Double_t px1=-9999.,py1=-9999.,pz1=-9999.;
@@ -2201,17 +2208,15 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   	Double_t feta1=-9999.;//,fphi1=-9999.;
   	Double_t feta2=-9999.;//,fphi2=-9999.;
 
-  	px1 = fD1.GetPx();
-  	py1 = fD1.GetPy();
-  	pz1 = fD1.GetPz();
-  	feta1 = fD1.GetEta();
-  	//	fphi1 = fD1.GetPhi();
+  	px1 = legP1[0];
+  	py1 = legP1[1];
+  	pz1 = legP1[2];
+  	feta1 = TVector3(legP1).Eta();
 
-  	px2 = fD2.GetPx();
-  	py2 = fD2.GetPy();
-  	pz2 = fD2.GetPz();
-  	feta2 = fD2.GetEta();
-  	//	fphi2 = fD2.GetPhi();
+  	px2 = legP2[0];
+  	py2 = legP2[1];
+  	pz2 = legP2[2];
+  	feta2 = TVector3(legP2).Eta();
 
   	//Calculate Energy per particle by hand
   	e1 = TMath::Sqrt(mElectron*mElectron+px1*px1+py1*py1+pz1*pz1);
@@ -2252,7 +2257,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   	values[AliDielectronVarManager::kDeltaEta]     = TMath::Abs(feta1 -feta2 );
   	values[AliDielectronVarManager::kDeltaPhi]     = lv1.DeltaPhi(lv2);
 
-         if( Req(kDeltaPhiChargeOrdered) && fgEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * fgEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
+         if( Req(kDeltaPhiChargeOrdered) && fgEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = legQ1 * fgEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
   	values[AliDielectronVarManager::kPairType]     = pair->GetType();
 
           // Calculate pair variables for corresponding generated pair
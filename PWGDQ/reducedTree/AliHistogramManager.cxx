@@ -49,7 +49,10 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fFillPlans(),
+  fFillPlanVars(),
+  fFillPlansReady(kFALSE)
 {
   //
   // Constructor
@@ -71,7 +74,10 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fFillPlans(),
+  fFillPlanVars(),
+  fFillPlansReady(kFALSE)
 {
   //
   // Constructor
@@ -131,6 +137,7 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
   fMainList.Add(hList);
+  fFillPlansReady = kFALSE;
 }
 
 //_________________________________________________________________
@@ -154,6 +161,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlansReady = kFALSE;
   TString hname = name;
   
   Int_t dimension = 1;
@@ -296,6 +304,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlansReady = kFALSE;
   TString hname = name;
   
   Int_t dimension = 1;
@@ -441,6 +450,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlansReady = kFALSE;
   TString hname = name;
   
   TString titleStr(title);
@@ -494,6 +504,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlansReady = kFALSE;
   TString hname = name;
   
   TString titleStr(title);
@@ -620,150 +631,153 @@ THnF* AliHistogramManager::CreateHistogram( const Char_t* name, const Char_t* ti
 
 
 //__________________________________________________________________
-void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
+Int_t AliHistogramManager::GetHistClassIndex(const Char_t* className) const {
   //
-  //  fill a class of histograms
+  // get the index of a histogram class, to be used with FillHistClass(Int_t, Float_t*)
+  // The index stays valid as long as no histogram class is added
   //
-  THashList* hList = (THashList*)fMainList.FindObject(className);
-  if(!hList) {
-    /*cout << "Warning in AliHistogramManager::FillHistClass(): Histogram list " << className << " not found!" << endl;
-    cout << "         Histogram list not filled" << endl; */
-    return;
-  }
-  if(!hList) {
-    return;
-  }
+  TObject* hList = fMainList.FindObject(className);
+  if(!hList) return -1;
+  return fMainList.IndexOf(hList);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::CompileFillPlans() {
+  //
+  // Build for each histogram class a flat list with the histograms, their type and the variable indices
+  //   decoded from the unique IDs, such that filling does not require any decoding or type checks.
+  // Histograms which would never be filled (variables not used) are not included in the plans.
+  //
+  fFillPlans.clear();
+  fFillPlans.resize(fMainList.GetEntries());
+  fFillPlanVars.clear();
+  
+  for(Int_t iclass=0; iclass<fMainList.GetEntries(); ++iclass) {
+    THashList* hList = (THashList*)fMainList.At(iclass);
+    hList->SetUniqueID(iclass);     // used to find the fill plan when filling by class name
+    std::vector<FillPlanEntry>& plan = fFillPlans[iclass];
     
-  TIter next(hList);
-  TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
-  Bool_t isSparse=kFALSE;
-  Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
-  while((h=next())) {
-    Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    if(isTHn && ((TString)h->ClassName()).Contains("Sparse")) isSparse = kTRUE;
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
-    uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
-    if(uid>0) {
-      varW = uid%(fNVars+1)-1;
-      if(varW==0) varW=AliReducedVarManager::kNothing;
-      uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
-      if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
-    }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
-        switch(dimension) {
+    TIter next(hList);
+    TObject* h=0x0;
+    while((h=next())) {
+      Int_t uid = h->GetUniqueID();
+      Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
+      Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+      Int_t thnDim = (isTHn ? (uid%100)-10 : 0);          // the excess over 10 from the last 2 digits give the dimension of the THn
+      
+      uid = (uid-(uid%100))/100;
+      Int_t varT = -1;
+      Int_t varW = -1;
+      if(uid>0) {
+        varW = uid%(fNVars+1)-1;
+        if(varW==0) varW=AliReducedVarManager::kNothing;
+        uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
+        if(uid>0) varT = uid - 1;
+      }
+      if(varW>AliReducedVarManager::kNothing && !fUsedVars[varW]) continue;
+      
+      FillPlanEntry entry;
+      entry.fHist = h;
+      entry.fVarW = varW;
+      entry.fVarOffset = fFillPlanVars.size();
+      Int_t vars[20] = {0};
+      if(isTHn) {
+        entry.fType = kFillTHn;
+        entry.fNDim = thnDim;
+        for(Int_t idim=0;idim<thnDim;++idim) vars[idim] = ((THnBase*)h)->GetAxis(idim)->GetUniqueID();
+      }
+      else {
+        TH1* hist = (TH1*)h;
+        vars[0] = hist->GetXaxis()->GetUniqueID();
+        switch(hist->GetDimension()) {
           case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
+            entry.fType = (isProfile ? kFillTProfile : kFillTH1);
+            entry.fNDim = (isProfile ? 2 : 1);
+            if(isProfile) vars[1] = hist->GetYaxis()->GetUniqueID();
           break;
           case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
+            entry.fType = (isProfile ? kFillTProfile2D : kFillTH2);
+            entry.fNDim = (isProfile ? 3 : 2);
+            vars[1] = hist->GetYaxis()->GetUniqueID();
+            if(isProfile) vars[2] = hist->GetZaxis()->GetUniqueID();
           break;
           case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
-            if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
-            }
+            entry.fType = (isProfile ? kFillTProfile3D : kFillTH3);
+            entry.fNDim = (isProfile ? 4 : 3);
+            vars[1] = hist->GetYaxis()->GetUniqueID();
+            vars[2] = hist->GetZaxis()->GetUniqueID();
+            if(isProfile) vars[3] = varT;
           break;
           default:
-          break;
-        }  // end switch
-      }
-    }  // end if(!isTHn)
-    else {
-      for(Int_t idim=0;idim<thnDim;++idim) {
-        if (isSparse) {
-          allVarsGood &= fUsedVars[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-        } else {
-          allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-        }
-      }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW]) {
-            if (isSparse) ((THnSparseF*)h)->Fill(fillValues,values[varW]);
-            else          ((THnF*)h)->Fill(fillValues,values[varW]);
-          }
-        }
-        else {
-          if (isSparse) ((THnSparseF*)h)->Fill(fillValues);
-          else          ((THnF*)h)->Fill(fillValues);
+            continue;
         }
       }
+      
+      Bool_t allVarsGood = kTRUE;
+      for(Int_t idim=0;idim<entry.fNDim;++idim) 
+        allVarsGood &= (vars[idim]>=0 && fUsedVars[vars[idim]]);
+      if(!allVarsGood) continue;
+      
+      for(Int_t idim=0;idim<entry.fNDim;++idim) fFillPlanVars.push_back(vars[idim]);
+      plan.push_back(entry);
+    }  // end loop over histograms
+  }  // end loop over histogram classes
+  fFillPlansReady = kTRUE;
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
+  //
+  //  fill a class of histograms
+  //
+  THashList* hList = (THashList*)fMainList.FindObject(className);
+  if(!hList) {
+    /*cout << "Warning in AliHistogramManager::FillHistClass(): Histogram list " << className << " not found!" << endl;
+    cout << "         Histogram list not filled" << endl; */
+    return;
+  }
+  if(!fFillPlansReady) CompileFillPlans();
+  FillHistClass((Int_t)hList->GetUniqueID(), values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classIdx, Float_t* values) {
+  //
+  //  fill a class of histograms using the precompiled fill plan
+  //
+  if(!fFillPlansReady) CompileFillPlans();
+  if(classIdx<0 || classIdx>=(Int_t)fFillPlans.size()) return;
+  
+  const std::vector<FillPlanEntry>& plan = fFillPlans[classIdx];
+  Double_t fillValues[20]={0.0};
+  for(std::vector<FillPlanEntry>::const_iterator it=plan.begin(); it!=plan.end(); ++it) {
+    const Int_t* vars = &fFillPlanVars[it->fVarOffset];
+    Double_t weight = (it->fVarW>AliReducedVarManager::kNothing ? values[it->fVarW] : 1.0);
+    switch(it->fType) {
+      case kFillTH1:
+        ((TH1*)it->fHist)->Fill(values[vars[0]], weight);
+      break;
+      case kFillTH2:
+        ((TH2*)it->fHist)->Fill(values[vars[0]], values[vars[1]], weight);
+      break;
+      case kFillTH3:
+        ((TH3*)it->fHist)->Fill(values[vars[0]], values[vars[1]], values[vars[2]], weight);
+      break;
+      case kFillTProfile:
+        ((TProfile*)it->fHist)->Fill(values[vars[0]], values[vars[1]], weight);
+      break;
+      case kFillTProfile2D:
+        ((TProfile2D*)it->fHist)->Fill(values[vars[0]], values[vars[1]], values[vars[2]], weight);
+      break;
+      case kFillTProfile3D:
+        ((TProfile3D*)it->fHist)->Fill(values[vars[0]], values[vars[1]], values[vars[2]], values[vars[3]], weight);
+      break;
+      case kFillTHn:
+        for(Int_t idim=0;idim<it->fNDim;++idim) fillValues[idim] = values[vars[idim]];
+        ((THnBase*)it->fHist)->Fill(fillValues, weight);
+      break;
+      default:
+      break;
     }
   }
 }
@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <THashList.h>
 
+#include <vector>
+
 #include "AliReducedVarManager.h"
 
 class TAxis;
@@ -69,6 +71,9 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  void FillHistClass(Int_t classIdx, Float_t* values);        // fill a class of histograms using the index from GetHistClassIndex()
+  Int_t GetHistClassIndex(const Char_t* className) const;      // index of a histogram class, -1 if the class does not exist
+  void CompileFillPlans();                                     // build the fill plans (done automatically on the first fill after booking)
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -91,6 +96,25 @@ class AliHistogramManager : public TObject {
    AliHistogramManager(const AliHistogramManager& histMan);             
    AliHistogramManager& operator=(const AliHistogramManager& histMan);      
    
+  // histogram types handled by the fill plans
+  enum FillPlanHistType {
+    kFillTH1=0,
+    kFillTH2,
+    kFillTH3,
+    kFillTProfile,
+    kFillTProfile2D,
+    kFillTProfile3D,
+    kFillTHn
+  };
+  // one entry of the fill plan; the variable indices are decoded once from the unique IDs at compile time
+  struct FillPlanEntry {
+    TObject* fHist;        // histogram (owned by the histogram class list)
+    Int_t fType;           // histogram type (FillPlanHistType)
+    Int_t fNDim;           // number of variables used as coordinates
+    Int_t fVarOffset;      // offset of the coordinate variable indices in fFillPlanVars
+    Int_t fVarW;           // weight variable (kNothing if no weight is used)
+  };
+   
   THashList fMainList;          // master histogram list
   TString fName;                 // master histogram list name
   THashList* fMainDirectory;   //! main directory with analysis output (this is used for loading output files and retrieving histograms offline)
@@ -105,6 +129,9 @@ class AliHistogramManager : public TObject {
   TString fVariableNames[AliReducedVarManager::kNVars];               //! variable names
   TString fVariableUnits[AliReducedVarManager::kNVars];               //! variable units
   Int_t fNVars;                          // maximum number of variables
+  std::vector<std::vector<FillPlanEntry> > fFillPlans;   //! fill plans, one per histogram class, indexed as fMainList
+  std::vector<Int_t> fFillPlanVars;                       //! flat array with the coordinate variable indices of all fill plans
+  Bool_t fFillPlansReady;                                 //! flag for fill plans being up to date with the booked histograms
   
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
   
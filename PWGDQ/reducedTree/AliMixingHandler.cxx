@@ -11,19 +11,37 @@
 #endif
 
 #include <iostream>
+#include <thread>
 using std::cout;
 using std::endl;
 using std::flush;
 
 #include <TMath.h>
+#include <TROOT.h>
 #include <TTimeStamp.h>
 #include <TRandom.h>
 
 #include "AliReducedVarManager.h"
 #include "AliReducedBaseTrack.h"
+#include "AliReducedTrackInfo.h"
+#include "AliReducedVarCut.h"
 
 ClassImp(AliMixingHandler);
 
+namespace {
+  // variables modified by AliReducedVarManager::FillPairInfoME(), copied for each mixed pair of the track arenas
+  const Int_t kMEPairVars[AliMixingHandler::kNMEPairVars] = {
+    AliReducedVarManager::kPairTypeSPD, AliReducedVarManager::kPairType, AliReducedVarManager::kCandidateId,
+    AliReducedVarManager::kPairChisquare, AliReducedVarManager::kMass,
+    AliReducedVarManager::kPx, AliReducedVarManager::kPy, AliReducedVarManager::kPz,
+    AliReducedVarManager::kPt, AliReducedVarManager::kPtSquared,
+    AliReducedVarManager::kPairLegPt, AliReducedVarManager::kPairLegPt+1, AliReducedVarManager::kPairLegPtSum,
+    AliReducedVarManager::kP, AliReducedVarManager::kEta, AliReducedVarManager::kRap, AliReducedVarManager::kRapAbs,
+    AliReducedVarManager::kPhi, AliReducedVarManager::kTheta,
+    AliReducedVarManager::kPairEff, AliReducedVarManager::kOneOverPairEff, AliReducedVarManager::kOneOverPairEffSq
+  };
+}
+
 //_________________________________________________________________________
 AliMixingHandler::AliMixingHandler(Int_t mixingSetup /* = kMixResonanceLegs*/) :
   TNamed(),
@@ -45,7 +63,13 @@ AliMixingHandler::AliMixingHandler(Int_t mixingSetup /* = kMixResonanceLegs*/) :
   fHistos(0x0),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fUseTrackArena(kFALSE),
+  fNThreads(1),
+  fArenas(),
+  fFlatPairCuts(),
+  fHasFlatPairCuts(kFALSE),
+  fHistClassArr(0x0)
 {
   // 
   // default constructor
@@ -84,7 +108,13 @@ AliMixingHandler::AliMixingHandler(const Char_t* name, const Char_t* title, Int_
   fHistos(0x0),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fUseTrackArena(kFALSE),
+  fNThreads(1),
+  fArenas(),
+  fFlatPairCuts(),
+  fHasFlatPairCuts(kFALSE),
+  fHistClassArr(0x0)
 {
   //
   // Named constructor
@@ -110,6 +140,7 @@ AliMixingHandler::~AliMixingHandler() {
    fCrossPairsCuts.Clear("C");
    fLikePairsLeg1Cuts.Clear("C");
    fLikePairsLeg2Cuts.Clear("C");
+   if(fHistClassArr) {fHistClassArr->Delete(); delete fHistClassArr;}
 }
 
 
@@ -174,6 +205,23 @@ void AliMixingHandler::Init() {
   fPoolSize.Set(fNParallelCuts*size);
   for(Int_t i=0;i<fNParallelCuts*size;++i) fPoolSize[i] = 0;
   
+  if(fUseTrackArena && fMixingSetup!=kMixResonanceLegs) {
+    cout << "AliMixingHandler::Init(): WARNING The track arena is only supported for kMixResonanceLegs, using the TList pools!" << endl;
+    fUseTrackArena = kFALSE;
+  }
+  if(fUseTrackArena) {
+    fArenas.clear();
+    fArenas.resize(size);
+    FlattenPairCuts();
+    // the mixing threads use ROOT objects (histograms, cuts), switch on its thread safety once here
+    if(fHasFlatPairCuts && fNThreads>1) ROOT::EnableThreadSafety();
+    if(fHistClassArr) {fHistClassArr->Delete(); delete fHistClassArr;}
+    fHistClassArr = histClassArr;
+  }
+  else {
+    histClassArr->Delete(); delete histClassArr;
+  }
+  
   fIsInitialized = kTRUE;
 }
 
@@ -210,6 +258,19 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   Int_t category = FindEventCategory(values);
   if(category<0) return;   // event characteristics outside the defined ranges
   
+  if(fUseTrackArena) {
+    // store the legs as flat records and mix the category if needed
+    if(category>=(Int_t)fArenas.size()) fArenas.resize(category+1);
+    FillArena(leg1List, leg2List, category);
+    ULong_t mixingMask = IncrementPoolSizes(leg1List,leg2List,category);
+    if(mixingMask) {
+      std::vector<Int_t> categories(1, category);
+      RunArenaMixing(categories,mixingMask,type,values,kFALSE);
+      ResetPoolSizes(mixingMask,category);
+    }
+    return;
+  }
+  
   TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(category));
   if(!leg1PoolP) leg1PoolP = new(fPoolsLeg1[category]) TClonesArray("TList",1);
   leg1PoolP->SetOwner(kTRUE);
@@ -389,16 +450,24 @@ void AliMixingHandler::RunLeftoverMixing(Int_t type) {
   for(Int_t i=0; i<fNParallelCuts; ++i) mixingMask |= (ULong_t(1)<<i);
   Float_t values[AliReducedVarManager::kNVars];
   
+  if(fUseTrackArena) {
+    // mix all categories in one go, so that they can be distributed over the threads
+    for(Int_t i=0; i<AliReducedVarManager::kNVars; ++i) values[i] = 0.0;
+    std::vector<Int_t> categories;
+    for(Int_t icateg=0; icateg<(Int_t)fArenas.size(); ++icateg)
+      if(!fArenas[icateg].fEventFirst.empty()) categories.push_back(icateg);
+    RunArenaMixing(categories,mixingMask,type,values,kTRUE);
+    for(UInt_t i=0; i<categories.size(); ++i) ResetPoolSizes(mixingMask,categories[i]);
+    return;
+  }
+  
   for(Int_t icateg=0; icateg<fPoolsLeg1.GetEntries(); ++icateg) {
     TClonesArray *leg1Pool = static_cast<TClonesArray*>(fPoolsLeg1.At(icateg));
     TClonesArray *leg2Pool = static_cast<TClonesArray*>(fPoolsLeg2.At(icateg));
     if(!leg1Pool) continue;
     if(!leg2Pool) continue;
     
-    for(Int_t iVar=0; iVar<fNMixingVariables; ++iVar) {
-       Int_t bin = GetBinFromCategory(iVar, icateg);
-       values[fVariables[iVar]] = 0.5*(fVariableLimits[iVar][bin] + fVariableLimits[iVar][bin+1]);
-    }
+    SetBinCenters(icateg, values);
     
     RunEventMixing(leg1Pool,leg2Pool,mixingMask,type,values);
     ResetPoolSizes(mixingMask,icateg);
@@ -406,6 +475,268 @@ void AliMixingHandler::RunLeftoverMixing(Int_t type) {
 }
 
 
+//_________________________________________________________________________
+void AliMixingHandler::SetBinCenters(Int_t category, Float_t* values) const {
+  //
+  // Set the mixing variables to the bin centers of the given event category
+  //
+  for(Int_t iVar=0; iVar<fNMixingVariables; ++iVar) {
+    Int_t bin = GetBinFromCategory(iVar, category);
+    values[fVariables[iVar]] = 0.5*(fVariableLimits[iVar][bin] + fVariableLimits[iVar][bin+1]);
+  }
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::FillArena(TList* leg1List, TList* leg2List, Int_t category) {
+  //
+  // Append the legs of this event as flat records to the arena of the event category
+  //
+  TrackArena& arena = fArenas[category];
+  arena.fEventFirst.push_back(arena.fTracks.size());
+  Int_t nLegs[2] = {0, 0};
+  TList* lists[2] = {leg1List, leg2List};
+  for(Int_t il=0; il<2; ++il) {
+    if(!lists[il]) continue;
+    TIter nextTrack(lists[il]);
+    AliReducedBaseTrack* track=0x0;
+    while((track=(AliReducedBaseTrack*)nextTrack())) {
+      ArenaTrack rec;
+      rec.fP[0] = track->Px(); rec.fP[1] = track->Py(); rec.fP[2] = track->Pz();
+      rec.fP[3] = track->P(); rec.fP[4] = track->Pt();
+      rec.fCharge = track->Charge();
+      rec.fSPDHit = (track->IsA()==AliReducedTrackInfo::Class() ? ((AliReducedTrackInfo*)track)->ITSLayerHit(0) : -1);
+      rec.fFlags = track->GetFlags();
+      arena.fTracks.push_back(rec);
+      nLegs[il] += 1;
+    }
+  }
+  arena.fEventNLeg1.push_back(nLegs[0]);
+  arena.fEventNLeg2.push_back(nLegs[1]);
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::RunArenaMixing(const std::vector<Int_t>& categories, ULong_t mixingMask,
+                                      Int_t type, Float_t* values, Bool_t useBinCenters) {
+  //
+  // Run the event mixing on the track arenas of the given event categories
+  // NOTE: The work is split in rows (category, first event). With fNThreads>1 the rows are processed in
+  //       batches of fNThreads rows in parallel, the pairs passing the cuts are buffered per row and
+  //       filled into the histograms afterwards in the order of the rows, so the output does not depend
+  //       on the number of threads. Parallel pairing requires pair cuts which could be flattened.
+  //       If useBinCenters is true, the mixing variables are set to the bin centers of each category.
+  //
+  if(!fHistClassArr) fHistClassArr = fHistClassNames.Tokenize(";");
+  
+  std::vector<Int_t> rowCategory, rowEvent;
+  for(UInt_t ic=0; ic<categories.size(); ++ic) {
+    const Int_t nEvents = fArenas[categories[ic]].fEventFirst.size();
+    if(nEvents<2) continue;
+    for(Int_t iev=0; iev<nEvents; ++iev) {
+      rowCategory.push_back(categories[ic]);
+      rowEvent.push_back(iev);
+    }
+  }
+  
+  const Int_t nRows = rowCategory.size();
+  const Int_t nThreads = (fHasFlatPairCuts && fNThreads>1 ? fNThreads : 1);
+  std::vector<std::vector<MixedPair> > pairs(nThreads);
+  Int_t currentCategory = -1;
+  for(Int_t firstRow=0; firstRow<nRows; firstRow+=nThreads) {
+    const Int_t nBatch = TMath::Min(nThreads, nRows-firstRow);
+    std::vector<std::thread> workers;
+    for(Int_t it=1; it<nBatch; ++it)
+      workers.push_back(std::thread(&AliMixingHandler::MixArenaEvent, this, rowCategory[firstRow+it], rowEvent[firstRow+it],
+                                    mixingMask, type, values, useBinCenters, &pairs[it]));
+    MixArenaEvent(rowCategory[firstRow], rowEvent[firstRow], mixingMask, type, values, useBinCenters, &pairs[0]);
+    for(UInt_t it=0; it<workers.size(); ++it) workers[it].join();
+    
+    // fill the histograms
+    for(Int_t it=0; it<nBatch; ++it) {
+      for(UInt_t ip=0; ip<pairs[it].size(); ++ip) {
+        const MixedPair& pair = pairs[it][ip];
+        if(useBinCenters && pair.fCategory!=currentCategory) {
+          SetBinCenters(pair.fCategory, values);
+          currentCategory = pair.fCategory;
+        }
+        for(Int_t iv=0; iv<kNMEPairVars; ++iv) values[kMEPairVars[iv]] = pair.fValues[iv];
+        for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
+          if(pair.fBits&(ULong_t(1)<<ibit))
+            fHistos->FillHistClass(fHistClassArr->At(ibit*3+pair.fHistOffset)->GetName(), values);
+        }
+      }
+      pairs[it].clear();
+    }
+  }
+  
+  // unset the mixing flags and remove the records and events which are not needed anymore
+  for(UInt_t ic=0; ic<categories.size(); ++ic) {
+    if(fArenas[categories[ic]].fEventFirst.size()<2) continue;
+    CompactArena(categories[ic], mixingMask);
+  }
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::MixArenaEvent(Int_t category, Int_t iev1, ULong_t mixingMask, Int_t type,
+                                     const Float_t* values, Bool_t useBinCenters, std::vector<MixedPair>* pairs) {
+  //
+  // Pair the legs of event iev1 with the legs of all other events in the arena of this category
+  // NOTE: Does not modify the arena and uses its own copy of the values, so that several events
+  //       can be mixed in parallel. Accepted pairs are appended to "pairs".
+  //
+  const TrackArena& arena = fArenas[category];
+  std::vector<Float_t> buffer(values, values+AliReducedVarManager::kNVars);
+  Float_t* pairValues = &buffer[0];
+  if(useBinCenters) SetBinCenters(category, pairValues);
+  
+  if(arena.fTracks.empty()) return;
+  const ArenaTrack* tracks = &arena.fTracks[0];
+  const Int_t nEvents = arena.fEventFirst.size();
+  const ArenaTrack* ev1Leg1 = tracks + arena.fEventFirst[iev1];
+  const ArenaTrack* ev1Leg2 = ev1Leg1 + arena.fEventNLeg1[iev1];
+  const Int_t nEv1Leg1 = arena.fEventNLeg1[iev1];
+  const Int_t nEv1Leg2 = arena.fEventNLeg2[iev1];
+  
+  MixedPair pair;
+  pair.fCategory = category;
+  for(Int_t iev2=0; iev2<nEvents; ++iev2) {
+    if(iev2==iev1) continue;
+    const ArenaTrack* ev2Leg1 = tracks + arena.fEventFirst[iev2];
+    const ArenaTrack* ev2Leg2 = ev2Leg1 + arena.fEventNLeg1[iev2];
+    const Int_t nEv2Leg1 = arena.fEventNLeg1[iev2];
+    const Int_t nEv2Leg2 = arena.fEventNLeg2[iev2];
+    
+    // pairs with a leg1 track of the first event: cross pairs (leg1 - leg2) and like pairs (leg1 - leg1)
+    for(Int_t i1=0; i1<nEv1Leg1; ++i1) {
+      const ArenaTrack& t1 = ev1Leg1[i1];
+      const ULong_t testFlags1 = mixingMask & t1.fFlags;
+      if(!testFlags1) continue;
+      for(Int_t il=0; il<2; ++il) {
+        if(il==1 && !fMixLikeSign) break;
+        const ArenaTrack* legs2 = (il==0 ? ev2Leg2 : ev2Leg1);
+        const Int_t nLegs2 = (il==0 ? nEv2Leg2 : nEv2Leg1);
+        const Int_t pairType = (il==0 ? 1 : 0);
+        for(Int_t i2=0; i2<nLegs2; ++i2) {
+          const ArenaTrack& t2 = legs2[i2];
+          const ULong_t testFlags2 = testFlags1 & t2.fFlags;
+          if(!testFlags2) continue;
+          AliReducedVarManager::FillPairInfoME(t1.fP, t1.fCharge, t2.fP, t2.fCharge,
+                                               (t1.fSPDHit<0 || t2.fSPDHit<0 ? -1 : t1.fSPDHit+t2.fSPDHit), type, pairValues);
+          if(fHasFlatPairCuts ? !IsPairSelectedFlat(pairValues, pairType) : !IsPairSelected(pairValues, pairType)) continue;
+          for(Int_t iv=0; iv<kNMEPairVars; ++iv) pair.fValues[iv] = pairValues[kMEPairVars[iv]];
+          pair.fBits = testFlags2;
+          pair.fHistOffset = pairType;
+          pairs->push_back(pair);
+        }
+      }
+    }
+    
+    if(!fMixLikeSign) continue;
+    // like pairs (leg2 - leg2)
+    for(Int_t i1=0; i1<nEv1Leg2; ++i1) {
+      const ArenaTrack& t1 = ev1Leg2[i1];
+      const ULong_t testFlags1 = mixingMask & t1.fFlags;
+      if(!testFlags1) continue;
+      for(Int_t i2=0; i2<nEv2Leg2; ++i2) {
+        const ArenaTrack& t2 = ev2Leg2[i2];
+        const ULong_t testFlags2 = testFlags1 & t2.fFlags;
+        if(!testFlags2) continue;
+        AliReducedVarManager::FillPairInfoME(t1.fP, t1.fCharge, t2.fP, t2.fCharge,
+                                             (t1.fSPDHit<0 || t2.fSPDHit<0 ? -1 : t1.fSPDHit+t2.fSPDHit), type, pairValues);
+        if(fHasFlatPairCuts ? !IsPairSelectedFlat(pairValues, 2) : !IsPairSelected(pairValues, 2)) continue;
+        for(Int_t iv=0; iv<kNMEPairVars; ++iv) pair.fValues[iv] = pairValues[kMEPairVars[iv]];
+        pair.fBits = testFlags2;
+        pair.fHistOffset = 2;
+        pairs->push_back(pair);
+      }
+    }
+  }  // end loop over the second event
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::CompactArena(Int_t category, ULong_t mixingMask) {
+  //
+  // Unset the mixing flags of all records in this category and remove the records without
+  // flags left, as well as the events without records. The arena memory is kept for reuse.
+  //
+  TrackArena& arena = fArenas[category];
+  const Int_t nEvents = arena.fEventFirst.size();
+  Int_t nTracks = 0;
+  Int_t nKeptEvents = 0;
+  for(Int_t iev=0; iev<nEvents; ++iev) {
+    const Int_t first = arena.fEventFirst[iev];
+    Int_t nLegs[2] = {0, 0};
+    const Int_t nOldLegs[2] = {arena.fEventNLeg1[iev], arena.fEventNLeg2[iev]};
+    const Int_t newFirst = nTracks;
+    Int_t itrack = first;
+    for(Int_t il=0; il<2; ++il) {
+      for(Int_t i=0; i<nOldLegs[il]; ++i, ++itrack) {
+        ArenaTrack rec = arena.fTracks[itrack];
+        rec.fFlags &= ~mixingMask;
+        if(!rec.fFlags) continue;
+        arena.fTracks[nTracks++] = rec;
+        nLegs[il] += 1;
+      }
+    }
+    if(nLegs[0]==0 && nLegs[1]==0) continue;
+    arena.fEventFirst[nKeptEvents] = newFirst;
+    arena.fEventNLeg1[nKeptEvents] = nLegs[0];
+    arena.fEventNLeg2[nKeptEvents] = nLegs[1];
+    nKeptEvents++;
+  }
+  arena.fTracks.resize(nTracks);
+  arena.fEventFirst.resize(nKeptEvents);
+  arena.fEventNLeg1.resize(nKeptEvents);
+  arena.fEventNLeg2.resize(nKeptEvents);
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::FlattenPairCuts() {
+  //
+  // Copy the ranges of the pair cuts into flat arrays which are evaluated without virtual calls.
+  // This is possible only if all pair cuts are AliReducedVarCut objects without cut functions,
+  // otherwise the cut objects are used and the mixing runs on a single thread.
+  //
+  fHasFlatPairCuts = kTRUE;
+  TList* cutLists[3] = {&fLikePairsLeg1Cuts, &fCrossPairsCuts, &fLikePairsLeg2Cuts};
+  for(Int_t il=0; il<3; ++il) {
+    fFlatPairCuts[il].clear();
+    TIter nextCut(cutLists[il]);
+    TObject* obj=0x0;
+    while((obj=nextCut())) {
+      if(obj->IsA()!=AliReducedVarCut::Class()) {fHasFlatPairCuts = kFALSE; continue;}
+      AliReducedVarCut* cut = (AliReducedVarCut*)obj;
+      for(Int_t i=0; i<cut->fNCuts; ++i) {
+        if(cut->fFuncCutLow[i] || cut->fFuncCutHigh[i]) {fHasFlatPairCuts = kFALSE; continue;}
+        FlatPairCut flat;
+        flat.fVar = cut->fCutVariables[i];
+        flat.fLow = cut->fCutLow[i];
+        flat.fHigh = cut->fCutHigh[i];
+        flat.fExclude = cut->fCutExclude[i];
+        flat.fDepVar[0] = (cut->fCutHasDependentVariable[i] ? cut->fDependentVariable[i] : -1);
+        flat.fDepLow[0] = cut->fDependentVariableCutLow[i];
+        flat.fDepHigh[0] = cut->fDependentVariableCutHigh[i];
+        flat.fDepExclude[0] = cut->fDependentVariableExclude[i];
+        flat.fDepVar[1] = (cut->fCutHasDependentVariable2[i] ? cut->fDependentVariable2[i] : -1);
+        flat.fDepLow[1] = cut->fDependentVariable2CutLow[i];
+        flat.fDepHigh[1] = cut->fDependentVariable2CutHigh[i];
+        flat.fDepExclude[1] = cut->fDependentVariable2Exclude[i];
+        fFlatPairCuts[il].push_back(flat);
+      }
+    }
+  }
+  if(!fHasFlatPairCuts) {
+    for(Int_t il=0; il<3; ++il) fFlatPairCuts[il].clear();
+    if(fNThreads>1)
+      cout << "AliMixingHandler::FlattenPairCuts(): WARNING Pair cuts other than AliReducedVarCut ranges are used, mixing on a single thread!" << endl;
+  }
+}
+
+
 //_________________________________________________________________________
 void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask,
 				      Int_t type, Float_t* values) {
@@ -614,6 +945,29 @@ Bool_t AliMixingHandler::IsPairSelected(Float_t* values, Int_t pairType) {
 }
 
 
+//_________________________________________________________________________
+Bool_t AliMixingHandler::IsPairSelectedFlat(const Float_t* values, Int_t pairType) const {
+   //
+   // apply the flattened pair cuts, same logic as AliReducedVarCut::IsSelected(values)
+   //
+   const std::vector<FlatPairCut>& cuts = fFlatPairCuts[pairType];
+   for(UInt_t i=0; i<cuts.size(); ++i) {
+      const FlatPairCut& cut = cuts[i];
+      Bool_t applyCut = kTRUE;
+      for(Int_t id=0; id<2; ++id) {
+         if(cut.fDepVar[id]<0) continue;
+         Bool_t inRangeDep = (values[cut.fDepVar[id]]>=cut.fDepLow[id] && values[cut.fDepVar[id]]<=cut.fDepHigh[id]);
+         // do not apply this cut if outside of the applicability range
+         if(inRangeDep==cut.fDepExclude[id]) {applyCut = kFALSE; break;}
+      }
+      if(!applyCut) continue;
+      Bool_t inRange = (values[cut.fVar]>=cut.fLow && values[cut.fVar]<=cut.fHigh);
+      if(inRange==cut.fExclude) return kFALSE;
+   }
+   return kTRUE;
+}
+
+
 //_________________________________________________________________________
 void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
    //
@@ -636,6 +990,8 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
    cout << "Track downscale :: " << fDownscaleTracks << endl;
    cout << "No. parallel cuts :: " << fNParallelCuts << endl;
    cout << "Histogram class names :: " << fHistClassNames.Data() << endl;
+   cout << "Track arena :: " << fUseTrackArena << endl;
+   cout << "No. threads :: " << fNThreads << endl;
   
    if(debugLevel<1) return;
   
@@ -659,6 +1015,14 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
       cout << endl;
       if(debugLevel<2) continue;
       
+      if(fUseTrackArena) {
+         const TrackArena& arena = fArenas[iCateg];
+         for(UInt_t iev=0; iev<arena.fEventFirst.size(); ++iev)
+            cout << "	Event #" << iev << ";  No. of tracks (leg1/leg2) :: "
+            << arena.fEventNLeg1[iev] << " / " << arena.fEventNLeg2[iev] << endl;
+         continue;
+      }
+      
       TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(iCateg));
       if(!leg1PoolP) continue;
       TClonesArray &leg1Pool=*leg1PoolP;
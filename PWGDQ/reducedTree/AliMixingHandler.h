@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <TString.h>
 
+#include <vector>
+
 #include "AliHistogramManager.h"
 #include "AliReducedVarManager.h"
 #include "AliReducedInfoCut.h"
@@ -24,7 +26,8 @@ public:
    enum Constants {
       kMixResonanceLegs=0,         // event mixing for resonance inv mass bkg
       kMixCorrelation,                 // event mixing for correlations
-      kNMaxVariables = 10
+      kNMaxVariables = 10,
+      kNMEPairVars = 22                // number of variables filled by AliReducedVarManager::FillPairInfoME()
    };
 
 public:
@@ -44,6 +47,8 @@ public:
   void SetNParallelCuts(Int_t n) {fNParallelCuts = n;}
   void SetHistogramManager(AliHistogramManager* histos) {fHistos = histos;}
   void SetHistClassNames(const Char_t* names) {fHistClassNames = names;}
+  void SetUseTrackArena(Bool_t flag=kTRUE) {fUseTrackArena = flag;}
+  void SetNThreads(Int_t n) {fNThreads = n;}
   void AddCrossPairsCut(AliReducedInfoCut* cut) {fCrossPairsCuts.Add(cut);}
   void AddOppositeSignPairsCut(AliReducedInfoCut* cut) {fCrossPairsCuts.Add(cut);}    // synonim function to AddCrossPairsCut() used for charged legs
   void AddLikePairsLeg1Cut(AliReducedInfoCut* cut) {fLikePairsLeg1Cuts.Add(cut);}
@@ -67,6 +72,8 @@ public:
   TString GetHistClassNames() const {return fHistClassNames;};
   Int_t GetNMixingVariables() const {return fNMixingVariables;}
   Int_t GetMixingSetup() const {return fMixingSetup;}
+  Bool_t GetUseTrackArena() const {return fUseTrackArena;}
+  Int_t GetNThreads() const {return fNThreads;}
   
   void Init();
   Int_t FindEventCategory(Float_t* values);
@@ -108,11 +115,59 @@ private:
   TList fLikePairsLeg1Cuts;    // cut object for LEG1 like pairs
   TList fLikePairsLeg2Cuts;    // cut object for LEG2 like pairs
   
+  // Track arena: the legs of the pooled events are stored as flat records, one arena per event category,
+  // instead of cloned tracks in TLists (only for kMixResonanceLegs)
+  // flat record of a leg
+  struct ArenaTrack {
+    Float_t fP[5];        // px, py, pz, p, pt
+    Int_t   fCharge;      // charge
+    Int_t   fSPDHit;      // hit in the first ITS layer, -1 if the leg is not an AliReducedTrackInfo
+    ULong_t fFlags;       // cut flags
+  };
+  // records of all events in one event category, the legs of an event are stored contiguously (leg1 then leg2)
+  struct TrackArena {
+    std::vector<ArenaTrack> fTracks;      // leg records
+    std::vector<Int_t> fEventFirst;       // index of the first record of each event
+    std::vector<Int_t> fEventNLeg1;       // number of leg1 records of each event
+    std::vector<Int_t> fEventNLeg2;       // number of leg2 records of each event
+  };
+  // range cut of an AliReducedVarCut, evaluated without virtual calls
+  struct FlatPairCut {
+    Short_t fVar;                              // variable to cut on
+    Float_t fLow, fHigh;                       // cut range
+    Bool_t  fExclude;                          // reject the range instead of selecting it
+    Short_t fDepVar[2];                        // dependent variables, -1 if not used
+    Float_t fDepLow[2], fDepHigh[2];           // applicability range of the cut
+    Bool_t  fDepExclude[2];                    // cut applied outside of the dependent variable range
+  };
+  // mixed pair which passed the pair cuts, filled into the histograms after the pairing
+  struct MixedPair {
+    Float_t fValues[kNMEPairVars];   // pair variables, see kMEPairVars in the implementation
+    ULong_t fBits;                   // cut bits for which the histograms are filled
+    Int_t   fHistOffset;             // 0: leg1-leg1, 1: leg1-leg2, 2: leg2-leg2 histogram class
+    Int_t   fCategory;               // event category
+  };
+  
+  Bool_t fUseTrackArena;           // store the pooled legs as flat records (only for kMixResonanceLegs)
+  Int_t  fNThreads;                // number of threads used to run the mixing on the arenas
+  std::vector<TrackArena> fArenas;                      //! track arenas, one per event category
+  std::vector<FlatPairCut> fFlatPairCuts[3];            //! flattened pair cuts for leg1-leg1, leg1-leg2 and leg2-leg2 pairs
+  Bool_t fHasFlatPairCuts;                              //! all pair cuts could be flattened
+  TObjArray* fHistClassArr;                             //! histogram class names, tokenized from fHistClassNames
+  
   void RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
+  void FillArena(TList* leg1List, TList* leg2List, Int_t category);
+  void RunArenaMixing(const std::vector<Int_t>& categories, ULong_t mixingMask, Int_t type, Float_t* values, Bool_t useBinCenters);
+  void MixArenaEvent(Int_t category, Int_t iev1, ULong_t mixingMask, Int_t type, const Float_t* values, Bool_t useBinCenters,
+                     std::vector<MixedPair>* pairs);
+  void CompactArena(Int_t category, ULong_t mixingMask);
+  void FlattenPairCuts();
+  Bool_t IsPairSelectedFlat(const Float_t* values, Int_t pairType) const;
   ULong_t IncrementPoolSizes(TList* list1, TList* list2, Int_t eventCategory);
   void ResetPoolSizes(ULong_t mixingMask, Int_t category);  
+  void SetBinCenters(Int_t category, Float_t* values) const;
   
-  ClassDef(AliMixingHandler,3);
+  ClassDef(AliMixingHandler,4);
 };
 
 #endif
@@ -11,6 +11,8 @@
 
 //_________________________________________________________________________
 class AliReducedVarCut : public AliReducedInfoCut {
+  
+  friend class AliMixingHandler;   // flattens the pair cuts for the event mixing
    
  public:
   AliReducedVarCut();
@@ -2318,19 +2318,34 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
   // type - Parameter encoding the resonance type 
   //        This is needed for making a mass assumption on the legs
   //
+  Int_t pairTypeSPD = -1;
+  if(t1->IsA()==TRACK::Class() && t2->IsA()==TRACK::Class() ){
+    TRACK* ti1=(TRACK*)t1; TRACK* ti2=(TRACK*)t2;
+    pairTypeSPD = ti1->ITSLayerHit(0)+ti2->ITSLayerHit(0);
+  }
+  const Float_t p1[5] = {t1->Px(), t1->Py(), t1->Pz(), t1->P(), t1->Pt()};
+  const Float_t p2[5] = {t2->Px(), t2->Py(), t2->Pz(), t2->P(), t2->Pt()};
+  FillPairInfoME(p1, t1->Charge(), p2, t2->Charge(), pairTypeSPD, type, values);
+}
+
+
+//_________________________________________________________________
+void AliReducedVarManager::FillPairInfoME(const Float_t* p1, Int_t charge1, const Float_t* p2, Int_t charge2,
+                                          Int_t pairTypeSPD, Int_t type, Float_t* values) {
+  //
+  // Fill pair information from the leg kinematics given as (px,py,pz,p,pt) arrays.
+  // NOTE: Used by the event mixing on flat track records, so no objects are needed for the legs.
+  //       Only the variables listed in AliMixingHandler (kMEPairVars) may be modified here.
+  //
   PAIR p;
-  p.PxPyPz(t1->Px()+t2->Px(), t1->Py()+t2->Py(), t1->Pz()+t2->Pz());
+  p.PxPyPz(p1[0]+p2[0], p1[1]+p2[1], p1[2]+p2[2]);
   p.CandidateId(type);
  
-  values[kPairTypeSPD] = -1.;
-   if(t1->IsA()==TRACK::Class() && t2->IsA()==TRACK::Class() ){
-   TRACK* ti1=(TRACK*)t1; TRACK* ti2=(TRACK*)t2;
-   values[kPairTypeSPD] = ti1->ITSLayerHit(0)+ti2->ITSLayerHit(0);
-   }
+  values[kPairTypeSPD] = pairTypeSPD;
    
-  if(t1->Charge()*t2->Charge()<0) p.PairType(1);
-  else if(t1->Charge()>0)         p.PairType(0);
-  else                            p.PairType(2);
+  if(charge1*charge2<0) p.PairType(1);
+  else if(charge1>0)    p.PairType(0);
+  else                  p.PairType(2);
   values[kPairType] = p.PairType();
   values[kCandidateId] = type;
   values[kPairChisquare] = -999.;
@@ -2340,14 +2355,14 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
     
   if(fgUsedVars[kMass]) {     
     values[kMass] = m1*m1+m2*m2 + 
-                    2.0*(TMath::Sqrt(m1*m1+t1->P()*t1->P())*TMath::Sqrt(m2*m2+t2->P()*t2->P()) - 
-                    t1->Px()*t2->Px() - t1->Py()*t2->Py() - t1->Pz()*t2->Pz());
+                    2.0*(TMath::Sqrt(m1*m1+p1[3]*p1[3])*TMath::Sqrt(m2*m2+p2[3]*p2[3]) - 
+                    p1[0]*p2[0] - p1[1]*p2[1] - p1[2]*p2[2]);
     if(values[kMass]<0.0) {
       cout << "FillPairInfoME(track, track, type, values): Warning: Very small squared mass found. "
            << "   Could be negative due to resolution of Float_t so it will be set to a small positive value." << endl; 
       cout << "   mass2: " << values[kMass] << endl;
-      cout << "p1(p,x,y,z): " << t1->P() << ", " << t1->Px() << ", " << t1->Py() << ", " << t1->Pz() << endl;
-      cout << "p2(p,x,y,z): " << t2->P() << ", " << t2->Px() << ", " << t2->Py() << ", " << t2->Pz() << endl;
+      cout << "p1(p,x,y,z): " << p1[3] << ", " << p1[0] << ", " << p1[1] << ", " << p1[2] << endl;
+      cout << "p2(p,x,y,z): " << p2[3] << ", " << p2[0] << ", " << p2[1] << ", " << p2[2] << endl;
       values[kMass] = 0.0;
     }
     else
@@ -2362,9 +2377,9 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
     values[kPt] = p.Pt();
     if(fgUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
   }
-  values[kPairLegPt] = t1->Pt();
-  values[kPairLegPt+1] = t2->Pt();
-  values[kPairLegPtSum] = t1->Pt() + t2->Pt();
+  values[kPairLegPt] = p1[4];
+  values[kPairLegPt+1] = p2[4];
+  values[kPairLegPtSum] = p1[4] + p2[4];
   if(fgUsedVars[kP])      values[kP]      = p.P();
   if(fgUsedVars[kEta])    values[kEta]    = p.Eta();
   if(fgUsedVars[kRap])    values[kRap]    = p.Rapidity();
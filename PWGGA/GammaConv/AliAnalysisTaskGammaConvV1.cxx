@@ -340,6 +340,8 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fWeightCentrality(NULL),
   fEnableClusterCutsForTrigger(kFALSE),
   fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE),
+  fDoPhotonSelectionCutSets(kFALSE),
+  fPhotonCutSetMasks(),
   tBrokenFiles(NULL),
   fFileNameBroken(NULL)
 {
@@ -627,6 +629,8 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fWeightCentrality(NULL),
   fEnableClusterCutsForTrigger(kFALSE),
   fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE),
+  fDoPhotonSelectionCutSets(kFALSE),
+  fPhotonCutSetMasks(),
   tBrokenFiles(NULL),
   fFileNameBroken(NULL)
 {
@@ -755,6 +759,10 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
   fV0Reader=(AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data());
   if(!fV0Reader){printf("Error: No V0 Reader");return;} // GetV0Reader
 
+  if(fDoPhotonSelectionCutSets && fnCuts > 64){
+    AliWarning(Form("%d cut sets, photon selection in one pass supports at most 64, switching it off",fnCuts));
+    fDoPhotonSelectionCutSets = kFALSE;
+  }
 
   if( ((AliConversionPhotonCuts*)fCutArray->At(0))->GetUseBDTPhotonCuts()){
       fEnableBDT  = kTRUE;
@@ -2301,6 +2309,7 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
     RelabelAODPhotonCandidates(kTRUE);    // In case of AODMC relabeling MC
     fV0Reader->RelabelAODs(kTRUE);
   }
+  if(fDoPhotonSelectionCutSets) SelectPhotonCandidatesCutSets();
   for(Int_t iCut = 0; iCut<fnCuts; iCut++){
     fiCut = iCut;
 
@@ -2507,6 +2516,28 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
 
   PostData(1, fOutputContainer);
 }
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvV1::SelectPhotonCandidatesCutSets()
+{
+  // Evaluate the photon cuts of all cut sets for the photon candidates of the event, sharing the
+  // cut independent quantities between the cut sets. ProcessPhotonCandidates takes the result for
+  // the current cut set from fPhotonCutSetMasks
+  for(Int_t iCut = 0; iCut<fnCuts; iCut++){
+    if(((AliConversionPhotonCuts*)fCutArray->At(iCut))->GetDoElecDeDxPostCalibration()){
+      if(!(((AliConversionPhotonCuts*)fCutArray->At(iCut))->LoadElecDeDxPostCalibration(fInputEvent->GetRunNumber()))){
+        AliFatal(Form("ERROR: LoadElecDeDxPostCalibration returned kFALSE for %d despite being requested!",fInputEvent->GetRunNumber()));
+      }
+    }
+  }
+
+  fPhotonCutSetMasks.assign(fReaderGammas->GetEntriesFast(), 0);
+  for(Int_t i = 0; i < fReaderGammas->GetEntriesFast(); i++){
+    AliAODConversionPhoton* PhotonCandidate = (AliAODConversionPhoton*) fReaderGammas->At(i);
+    if(!PhotonCandidate) continue;
+    fPhotonCutSetMasks[i] = AliConversionPhotonCuts::PhotonIsSelectedCutSets(PhotonCandidate,fInputEvent,fCutArray);
+  }
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
 {
@@ -2541,7 +2572,9 @@ void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
     }
 
 
-    if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent)) continue;
+    if(fDoPhotonSelectionCutSets){
+      if(!((fPhotonCutSetMasks[i] >> fiCut) & 1)) continue;
+    } else if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->InPlaneOutOfPlaneCut(PhotonCandidate->GetPhotonPhi(),fEventPlaneAngle)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseElecSharingCut() &&
       !((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseToCloseV0sCut()){
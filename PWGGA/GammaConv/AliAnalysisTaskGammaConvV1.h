@@ -75,6 +75,10 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
                                                                   fClusterCutArray              = CutArray  ;}
 
     void SetDoMaterialBudgetWeightingOfGammasForTrueMesons(Bool_t flag) {fDoMaterialBudgetWeightingOfGammasForTrueMesons = flag;}
+    // evaluate the photon cuts of all cut sets in one pass per photon (see AliConversionPhotonCuts::PhotonIsSelectedCutSets),
+    // the photon cut QA histograms of all cut sets are then filled for every photon of the event, at most 64 cut sets
+    void SetDoPhotonSelectionCutSets(Bool_t flag)                 { fDoPhotonSelectionCutSets   = flag    ;}
+    void SelectPhotonCandidatesCutSets();
 
     // BG HandlerSettings
     void SetMoveParticleAccordingToVertex(Bool_t flag)            {fMoveParticleAccordingToVertex = flag;}
@@ -388,6 +392,8 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     Double_t*                         fWeightCentrality;                          //[fnCuts], weight for centrality flattening
     Bool_t                            fEnableClusterCutsForTrigger;               //enables ClusterCuts for Trigger
     Bool_t                            fDoMaterialBudgetWeightingOfGammasForTrueMesons;
+    Bool_t                            fDoPhotonSelectionCutSets;                  // evaluate the photon cuts of all cut sets in one pass
+    vector<ULong64_t>                 fPhotonCutSetMasks;                         //! cut sets passed by the photon candidates of the event (bit iCut)
     TTree*                            tBrokenFiles;                               // tree for keeping track of broken files
     TObjString*                       fFileNameBroken;                            // string object for broken file name
 
@@ -395,7 +401,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 46);
+    ClassDef(AliAnalysisTaskGammaConvV1, 47);
 };
 
 #endif
@@ -29,6 +29,30 @@ using namespace std;
 
 ClassImp(AliGammaConversionAODBGHandler)
 
+namespace {
+	// copies the background events of another handler into the slots, the views then point to the own copies
+	// (same slot layout as AliGammaConversionAODBGHandler::GetBGSlot)
+	template<class T> void CopyBGEvents(std::vector<std::vector<std::vector<std::vector<T*> > > > &events,
+	                                    const std::vector<std::vector<std::vector<std::vector<T*> > > > &source,
+	                                    std::vector<TClonesArray*> &slots, Int_t nBinsZ, Int_t nBinsMult, Int_t nEvents)
+	{
+		for(Int_t z=0;z<nBinsZ && z<(Int_t)source.size();z++){
+			for(Int_t m=0;m<nBinsMult && m<(Int_t)source[z].size();m++){
+				for(Int_t ev=0;ev<nEvents && ev<(Int_t)source[z][m].size();ev++){
+					events[z][m][ev].clear();
+					if(source[z][m][ev].empty()) continue;
+					if(slots.empty()) slots.assign(nBinsZ*nBinsMult*nEvents,NULL);
+					TClonesArray *&slot = slots[(z*nBinsMult+m)*nEvents+ev];
+					if(!slot) slot = new TClonesArray(T::Class(),source[z][m][ev].size());
+					for(UInt_t i=0;i<source[z][m][ev].size();i++){
+						events[z][m][ev].push_back(new((*slot)[i]) T(*source[z][m][ev][i]));
+					}
+				}
+			}
+		}
+	}
+}
+
 //_____________________________________________________________________________________________________________________________
 AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	TObject(),
@@ -47,7 +71,11 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	fBGEvents(),
 	fBGEventsENeg(),
 	fBGEventsMeson(),
-	fBGEventsMCParticle()
+	fBGEventsMCParticle(),
+	fBGPhotonSlots(),
+	fBGENegSlots(),
+	fBGMesonSlots(),
+	fBGMCParticleSlots()
 {
 	// constructor
 }
@@ -70,7 +98,11 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t binsZ,Int_t
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
-	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents)))
+	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents))),
+	fBGPhotonSlots(),
+	fBGENegSlots(),
+	fBGMesonSlots(),
+	fBGMCParticleSlots()
 {
 	// constructor
 }
@@ -95,7 +127,11 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t collisionSy
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
-	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents)))
+	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents))),
+	fBGPhotonSlots(),
+	fBGENegSlots(),
+	fBGMesonSlots(),
+	fBGMCParticleSlots()
 {
 	// constructor
     if(fNBinsMultiplicity>5) fNBinsMultiplicity = 5;
@@ -390,9 +426,17 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(const AliGammaCon
 	fBGEvents(original.fBGEvents),
 	fBGEventsENeg(original.fBGEventsENeg),
 	fBGEventsMeson(original.fBGEventsMeson),
-	fBGEventsMCParticle(original.fBGEventsMCParticle)
+	fBGEventsMCParticle(original.fBGEventsMCParticle),
+	fBGPhotonSlots(),
+	fBGENegSlots(),
+	fBGMesonSlots(),
+	fBGMCParticleSlots()
 {
-	//copy constructor	
+	//copy constructor, the background events are copied into own slots
+	CopyBGEvents(fBGEvents,original.fBGEvents,fBGPhotonSlots,fNBinsZ,fNBinsMultiplicity,fNEvents);
+	CopyBGEvents(fBGEventsENeg,original.fBGEventsENeg,fBGENegSlots,fNBinsZ,fNBinsMultiplicity,fNEvents);
+	CopyBGEvents(fBGEventsMeson,original.fBGEventsMeson,fBGMesonSlots,fNBinsZ,fNBinsMultiplicity,fNEvents);
+	CopyBGEvents(fBGEventsMCParticle,original.fBGEventsMCParticle,fBGMCParticleSlots,fNBinsZ,fNBinsMultiplicity,fNEvents);
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -455,6 +499,12 @@ AliGammaConversionAODBGHandler::~AliGammaConversionAODBGHandler(){
 		fBGEventMesonCounter = NULL;
 	}
 
+	std::vector<TClonesArray*> *slots[4] = {&fBGPhotonSlots,&fBGENegSlots,&fBGMesonSlots,&fBGMCParticleSlots};
+	for(Int_t i=0;i<4;i++){
+		for(UInt_t j=0;j<slots[i]->size();j++) delete (*slots[i])[j];
+		slots[i]->clear();
+	}
+
 	if(fBinLimitsArrayZ){
 		delete[] fBinLimitsArrayZ;
 	}
@@ -645,15 +695,15 @@ void AliGammaConversionAODBGHandler::AddEvent(TList* const eventGammas,Double_t
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(UInt_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEvents[z][m][eventCounter][d]);
-	}
+	// the photons are constructed in place in the slot, overwriting the oldest event
+	TClonesArray *slot = GetBGSlot(fBGPhotonSlots,AliAODConversionPhoton::Class(),z,m,eventCounter);
+	slot->Clear();
 	fBGEvents[z][m][eventCounter].clear();
 	
 	// add the gammas to the vector
 	for(Int_t i=0; i< eventGammas->GetEntries();i++){
 		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEvents[z][m][eventCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
+		fBGEvents[z][m][eventCounter].push_back(new((*slot)[i]) AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
 	}
 	fBGEventCounter[z][m]++;
 }
@@ -677,14 +727,13 @@ void AliGammaConversionAODBGHandler::AddMesonEvent(TList* const eventMothers, Do
 	fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
 	//first clear the vector
-  for(UInt_t d=0;d<fBGEventsMeson[z][m][eventCounter].size();d++){
-		delete (AliAODConversionMother*)(fBGEventsMeson[z][m][eventCounter][d]);
-	}
+	TClonesArray *slot = GetBGSlot(fBGMesonSlots,AliAODConversionMother::Class(),z,m,eventCounter);
+	slot->Clear();
 	fBGEventsMeson[z][m][eventCounter].clear();
 	
 	// add the gammas to the vector
 	for(Int_t i=0; i< eventMothers->GetEntries();i++){
-		fBGEventsMeson[z][m][eventCounter].push_back(new AliAODConversionMother(*(AliAODConversionMother*)(eventMothers->At(i))));
+		fBGEventsMeson[z][m][eventCounter].push_back(new((*slot)[i]) AliAODConversionMother(*(AliAODConversionMother*)(eventMothers->At(i))));
 	}
 	fBGEventMesonCounter[z][m]++;
 }
@@ -705,14 +754,14 @@ void AliGammaConversionAODBGHandler::AddMesonEvent(const std::vector<AliAODConve
   fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
   //first clear the vector
-  for(UInt_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-    delete (AliAODConversionMother*)(fBGEventsMeson[z][m][eventCounter][d]);
-  }
+  TClonesArray *slot = GetBGSlot(fBGMesonSlots,AliAODConversionMother::Class(),z,m,eventCounter);
+  slot->Clear();
   fBGEventsMeson[z][m][eventCounter].clear();
 
   // add the gammas to the vector
+  Int_t i = 0;
   for(const auto &mother : eventMother){
-    fBGEventsMeson[z][m][eventCounter].push_back(new AliAODConversionMother(mother));
+    fBGEventsMeson[z][m][eventCounter].push_back(new((*slot)[i++]) AliAODConversionMother(mother));
   }
   fBGEventMesonCounter[z][m]++;
 }
@@ -733,16 +782,14 @@ void AliGammaConversionAODBGHandler::AddElectronEvent(TClonesArray* const eventE
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(UInt_t d=0;d<fBGEventsENeg[z][m][eventENegCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEventsENeg[z][m][eventENegCounter][d]);
-	}
-
+	TClonesArray *slot = GetBGSlot(fBGENegSlots,AliAODConversionPhoton::Class(),z,m,eventENegCounter);
+	slot->Clear();
 	fBGEventsENeg[z][m][eventENegCounter].clear();
 
 	// add the electron to the vector
 	for(Int_t i=0; i< eventENeg->GetEntriesFast();i++){
 		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEventsENeg[z][m][eventENegCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventENeg->At(i))));
+		fBGEventsENeg[z][m][eventENegCounter].push_back(new((*slot)[i]) AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventENeg->At(i))));
 	}
 	fBGEventENegCounter[z][m]++;
 }
@@ -767,18 +814,27 @@ void AliGammaConversionAODBGHandler::AddMCParticleEvent(TList* const eventGammas
 	fBGEventVertex[z][m][eventCounter].fZ = zvalue;
 	fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
-        for(UInt_t d=0;d<fBGEventsMCParticle[z][m][eventCounter].size();d++){
-          delete (AliAODMCParticle*)(fBGEventsMCParticle[z][m][eventCounter][d]);
-	}
+	TClonesArray *slot = GetBGSlot(fBGMCParticleSlots,AliAODMCParticle::Class(),z,m,eventCounter);
+	slot->Clear();
 	fBGEventsMCParticle[z][m][eventCounter].clear();
 
 	// add the gammas to the vector
 	for(Int_t i=0; i< eventGammas->GetEntries();i++){
 		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEventsMCParticle[z][m][eventCounter].push_back(new AliAODMCParticle(*(AliAODMCParticle*)(eventGammas->At(i))));
+		fBGEventsMCParticle[z][m][eventCounter].push_back(new((*slot)[i]) AliAODMCParticle(*(AliAODMCParticle*)(eventGammas->At(i))));
 	}
 	fBGMCParticleEventCounter[z][m]++;
 }
+//_____________________________________________________________________________________________________________________________
+TClonesArray* AliGammaConversionAODBGHandler::GetBGSlot(std::vector<TClonesArray*> &slots, TClass *cl, Int_t z, Int_t m, Int_t event){
+	// slot of the ring buffer for the given bin and event, the objects in it are reused when the slot is overwritten
+	// instead of deleting and allocating every background particle
+	if(slots.empty()) slots.assign(fNBinsZ*fNBinsMultiplicity*fNEvents,NULL);
+	TClonesArray *&slot = slots[(z*fNBinsMultiplicity+m)*fNEvents+event];
+	if(!slot) slot = new TClonesArray(cl,10);
+	return slot;
+}
+
 //_____________________________________________________________________________________________________________________________
 AliGammaConversionAODVector* AliGammaConversionAODBGHandler::GetBGGoodV0s(Int_t zbin, Int_t mbin, Int_t event){
 	//see headerfile for documentation
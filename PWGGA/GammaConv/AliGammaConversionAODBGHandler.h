@@ -26,6 +26,8 @@ typedef std::vector<AliAODConversionPhoton*> AliGammaConversionAODVector;
 typedef std::vector<AliAODConversionMother*> AliGammaConversionMotherAODVector;
 typedef std::vector<AliAODMCParticle*> AliAODMCParticleVector;
 
+class TClass;
+
 class AliGammaConversionAODBGHandler : public TObject {
 
 	public: 
@@ -91,6 +93,7 @@ class AliGammaConversionAODBGHandler : public TObject {
 	Double_t GetBGProb(Int_t z, Int_t m){return fBGProbability[z][m];}
 
 	private:
+		TClonesArray* GetBGSlot(std::vector<TClonesArray*> &slots, TClass *cl, Int_t z, Int_t m, Int_t event);
 
 		Int_t 								fNEvents; 						// number of events
 		Int_t ** 							fBGEventCounter;				//! bg counter
@@ -108,7 +111,12 @@ class AliGammaConversionAODBGHandler : public TObject {
 		AliGammaConversionBGVector 			fBGEventsENeg; 					// electron background electron events
 		AliGammaConversionMotherBGVector                fBGEventsMeson; 				// neutral meson background events
 		AliAODMCParticleBGVector 	                fBGEventsMCParticle; 				// MC Particle background events
+		// ring buffer storage, one reusable slot per (z bin, mult bin, event), the vectors above point into it
+		std::vector<TClonesArray*>			fBGPhotonSlots;					//! photon background events
+		std::vector<TClonesArray*>			fBGENegSlots;					//! electron background events
+		std::vector<TClonesArray*>			fBGMesonSlots;					//! neutral meson background events
+		std::vector<TClonesArray*>			fBGMCParticleSlots;				//! MC particle background events
 		
-	ClassDef(AliGammaConversionAODBGHandler,8)
+	ClassDef(AliGammaConversionAODBGHandler,9)
 };
 #endif
@@ -36,6 +36,7 @@
 #include "TH1F.h"
 #include "TF1.h"
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <utility>
@@ -44,6 +45,13 @@ class iostream;
 
 using namespace std;
 
+namespace {
+  const Float_t kGridEtaMax = 1.;   // eta range of the cluster grid, clusters outside are put into the outermost cells
+
+  Bool_t CompareFirst(const pair<Int_t,Int_t> &a, const pair<Int_t,Int_t> &b) { return a.first < b.first; }
+  Bool_t CompareKey(const pair<pair<Int_t,Int_t>,Int_t> &a, const pair<pair<Int_t,Int_t>,Int_t> &b) { return a.first < b.first; }
+}
+
 
 ClassImp(AliCaloTrackMatcher)
 
@@ -59,11 +67,23 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
   fRunNumber(-1),
   fGeomEMCAL(NULL),
   fGeomPHOS(NULL),
-  fMapTrackToCluster(),
-  fMapClusterToTrack(),
+  fGridMargin(0.15),
+  fVecTrackToCluster(),
+  fVecClusterToTrack(),
   fNEntries(1),
   fVectorDeltaEtaDeltaPhi(0),
-  fMap_TrID_ClID_ToIndex(),
+  fVec_TrID_ClID_ToIndex(),
+  fVecTrackIDToPosition(),
+  fProcessedEvent(NULL),
+  fGridNEta(0),
+  fGridNPhi(0),
+  fGridCellEta(0),
+  fGridCellPhi(0),
+  fGridCellStart(),
+  fGridClusters(),
+  fClusterCell(),
+  fClusterPos(),
+  fGridCandidates(),
   fSecMapTrackToCluster(),
   fSecMapClusterToTrack(),
   fSecNEntries(1),
@@ -84,10 +104,11 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
 //________________________________________________________________________
 AliCaloTrackMatcher::~AliCaloTrackMatcher(){
     // default deconstructor
-    fMapTrackToCluster.clear();
-    fMapClusterToTrack.clear();
+    fVecTrackToCluster.clear();
+    fVecClusterToTrack.clear();
     fVectorDeltaEtaDeltaPhi.clear();
-    fMap_TrID_ClID_ToIndex.clear();
+    fVec_TrID_ClID_ToIndex.clear();
+    fVecTrackIDToPosition.clear();
 
     fSecMapTrackToCluster.clear();
     fSecMapClusterToTrack.clear();
@@ -106,10 +127,11 @@ AliCaloTrackMatcher::~AliCaloTrackMatcher(){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::Terminate(Option_t *){
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
+  fVecTrackToCluster.clear();
+  fVecClusterToTrack.clear();
   fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
+  fVec_TrID_ClID_ToIndex.clear();
+  fVecTrackIDToPosition.clear();
 
   fSecMapTrackToCluster.clear();
   fSecMapClusterToTrack.clear();
@@ -162,11 +184,13 @@ void AliCaloTrackMatcher::UserCreateOutputObjects(){
 //________________________________________________________________________
 void AliCaloTrackMatcher::Initialize(Int_t runNumber){
   // Initialize function to be called once before analysis
-  fMapTrackToCluster.clear();
-  fMapClusterToTrack.clear();
+  fVecTrackToCluster.clear();
+  fVecClusterToTrack.clear();
   fNEntries = 1;
   fVectorDeltaEtaDeltaPhi.clear();
-  fMap_TrID_ClID_ToIndex.clear();
+  fVec_TrID_ClID_ToIndex.clear();
+  fVecTrackIDToPosition.clear();
+  fProcessedEvent = NULL;
 
   fSecMapTrackToCluster.clear();
   fSecMapClusterToTrack.clear();
@@ -233,6 +257,21 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       return;
     }
   }
+  fProcessedEvent = event;
+
+  // positions of the tracks in the AOD event for GetMatchedClusterIDsForTrack & co
+  if(aodev){
+    fVecTrackIDToPosition.reserve(event->GetNumberOfTracks());
+    for (Int_t itr=0;itr<event->GetNumberOfTracks();itr++){
+      AliVTrack *track = dynamic_cast<AliVTrack*>(aodev->GetTrack(itr));
+      if(track) fVecTrackIDToPosition.push_back(make_pair(track->GetID(),itr));
+    }
+    stable_sort(fVecTrackIDToPosition.begin(),fVecTrackIDToPosition.end(),CompareFirst);
+  }
+
+  // cluster positions and (eta,phi) grid, each track is only propagated to the clusters in the cells around it
+  FillClusterGrid(event,arrClusters,nClus);
+
   static AliESDtrackCuts *EsdTrackCuts = 0x0;
   static int prevRun = -1;
   // Using standard function for setting Cuts
@@ -418,7 +457,6 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
 
     Float_t dEta=-999, dPhi=-999;
-    Float_t clsPos[3] = {0.,0.,0.};
     Double_t exPos[3] = {0.,0.,0.};
     if (!emcParam.GetXYZ(exPos)){
       delete trackParam;
@@ -429,52 +467,35 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     // cout << inTrack->GetID() << " - " << trackParam << endl;
     // cout << "eta/phi: " << eta << ", " << phi << endl;
     // cout << "nClus: " << nClus << endl;
+    Int_t nCandidates = nClus;
+    if(fGridNEta > 0){
+      TVector3 exPosVec(exPos[0],exPos[1],exPos[2]);
+      GetClusterCandidates(exPosVec.Eta(),exPosVec.Phi());
+      nCandidates = fGridCandidates.size();
+    }
     Int_t nClusterMatchesToTrack = 0;
-    for(Int_t iclus=0;iclus < nClus;iclus++){
-      AliVCluster* cluster = NULL;
-      if(arrClusters){
-        if(esdev){
-          if(arrClusters)
-            cluster = new AliESDCaloCluster(*(AliESDCaloCluster*)arrClusters->At(iclus));
-        } else if(aodev){
-          if(arrClusters)
-            cluster = new AliAODCaloCluster(*(AliAODCaloCluster*)arrClusters->At(iclus));
-        }
-      }
-      else
-        cluster = event->GetCaloCluster(iclus);
-      if (!cluster){
-        if(arrClusters) delete cluster;
-        continue;
-      }
+    for(Int_t icand=0;icand < nCandidates;icand++){
+      Int_t iclus = (fGridNEta > 0) ? fGridCandidates[icand] : icand;
+      if(fClusterCell[iclus] < 0) continue;
+      AliVCluster* cluster = GetCluster(event,arrClusters,iclus);
+      if (!cluster) continue;
       // cout << "-------------------------LOOPING: " << iclus << ", " << cluster->GetID() << endl;
-      cluster->GetPosition(clsPos);
+      const Float_t *clsPos = &fClusterPos[3*iclus];
       Double_t dR = TMath::Sqrt(TMath::Power(exPos[0]-clsPos[0],2)+TMath::Power(exPos[1]-clsPos[1],2)+TMath::Power(exPos[2]-clsPos[2],2));
       //cout << "dR: " << dR << endl;
-      if (dR > fMatchingWindow){
-        if(arrClusters) delete cluster;
-        continue;
-      }
+      if (dR > fMatchingWindow) continue;
       Double_t clusterR = TMath::Sqrt( clsPos[0]*clsPos[0] + clsPos[1]*clsPos[1] );
       AliExternalTrackParam trackParamTmp(emcParam);//Retrieve the starting point every time before the extrapolation
       if(fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
-        if (!cluster->IsEMCAL()){
-          if(arrClusters) delete cluster;
-          continue;
-        }
+        if (!cluster->IsEMCAL()) continue;
         if(!AliEMCALRecoUtils::ExtrapolateTrackToCluster(&trackParamTmp, cluster, 0.139, 5., dEta, dPhi)){
           fHistControlMatches->Fill(4.,inTrack->Pt());
-          if(arrClusters) delete cluster;
           continue;
         }
       }else if(fClusterType == 2){
-        if (!cluster->IsPHOS()){
-          if(arrClusters) delete cluster;
-          continue;
-        }
+        if (!cluster->IsPHOS()) continue;
         if(!AliTrackerBase::PropagateTrackToBxByBz(&trackParamTmp, clusterR, 0.139, 5., kTRUE, 0.8, -1)){
           fHistControlMatches->Fill(4.,inTrack->Pt());
-          if(arrClusters) delete cluster;
           continue;
         }
         Double_t trkPos[3] = {0,0,0};
@@ -488,31 +509,131 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       Float_t dR2 = dPhi*dPhi + dEta*dEta;
 
       //cout << dEta << " - " << dPhi << " - " << dR2 << endl;
-      if(dR2 > fMatchingResidual){
-        if(arrClusters) delete cluster;
-        continue;
-      }
+      if(dR2 > fMatchingResidual) continue;
       nClusterMatchesToTrack++;
       if(aodev){
-        fMapTrackToCluster.insert(make_pair(itr,cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),itr));
+        fVecTrackToCluster.push_back(make_pair(itr,cluster->GetID()));
+        fVecClusterToTrack.push_back(make_pair(cluster->GetID(),itr));
       }else{
-        fMapTrackToCluster.insert(make_pair(inTrack->GetID(),cluster->GetID()));
-        fMapClusterToTrack.insert(make_pair(cluster->GetID(),inTrack->GetID()));
+        fVecTrackToCluster.push_back(make_pair(inTrack->GetID(),cluster->GetID()));
+        fVecClusterToTrack.push_back(make_pair(cluster->GetID(),inTrack->GetID()));
       }
       fVectorDeltaEtaDeltaPhi.push_back(make_pair(dEta,dPhi));
-      fMap_TrID_ClID_ToIndex[make_pair(inTrack->GetID(),cluster->GetID())] = fNEntries++;
+      fVec_TrID_ClID_ToIndex.push_back(make_pair(make_pair(inTrack->GetID(),cluster->GetID()),fNEntries++));
       if( (Int_t)fVectorDeltaEtaDeltaPhi.size() != (fNEntries-1)) AliFatal("Fatal error in AliCaloTrackMatcher, vector and map are not in sync!");
-      if(arrClusters) delete cluster;
     }
     if(nClusterMatchesToTrack == 0) fHistControlMatches->Fill(5.,inTrack->Pt());
     else fHistControlMatches->Fill(6.,inTrack->Pt());
     delete trackParam;
   }
 
+  // sort the matches once per event, lookups are binary searches afterwards
+  // (stable sorting keeps the order in which the matches of one track/cluster were found)
+  stable_sort(fVecTrackToCluster.begin(),fVecTrackToCluster.end(),CompareFirst);
+  stable_sort(fVecClusterToTrack.begin(),fVecClusterToTrack.end(),CompareFirst);
+  stable_sort(fVec_TrID_ClID_ToIndex.begin(),fVec_TrID_ClID_ToIndex.end(),CompareKey);
+
   return;
 }
 
+//________________________________________________________________________
+AliVCluster* AliCaloTrackMatcher::GetCluster(AliVEvent *event, TClonesArray *arrClusters, Int_t iclus){
+  // clusters of the correction framework are used directly from the branch, they are only read in the matching
+  if(arrClusters) return dynamic_cast<AliVCluster*>(arrClusters->At(iclus));
+  return event->GetCaloCluster(iclus);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetGridEtaBin(Float_t eta) const {
+  Int_t bin = (Int_t)TMath::Floor((TMath::Max(-kGridEtaMax,TMath::Min(kGridEtaMax,eta))+kGridEtaMax)/fGridCellEta);
+  return TMath::Max(0,TMath::Min(fGridNEta-1,bin));
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetGridPhiBin(Float_t phi) const {
+  if(phi < 0) phi += TMath::TwoPi();
+  Int_t bin = (Int_t)(phi/fGridCellPhi);
+  return TMath::Max(0,TMath::Min(fGridNPhi-1,bin));
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatcher::FillClusterGrid(AliVEvent *event, TClonesArray *arrClusters, Int_t nClus){
+  // caches the cluster positions and sorts the clusters into an (eta,phi) grid (counting sort)
+  // the cells are at least as large as the matching residual plus fGridMargin in eta and phi, all clusters
+  // which can be matched to a track are then found in the 3x3 cells around the track at the calorimeter surface
+  // (the margin accounts for the bending between the surface and the cluster)
+  fClusterPos.assign(3*nClus,0.);
+  fClusterCell.assign(nClus,-1);
+  fGridNEta = 0;
+  fGridNPhi = 0;
+  Float_t cellSize = TMath::Sqrt(fMatchingResidual) + fGridMargin;
+  if(fGridMargin >= 0 && cellSize > 0){
+    fGridNEta = TMath::Max(1,(Int_t)(2*kGridEtaMax/cellSize));
+    fGridNPhi = TMath::Max(1,(Int_t)(TMath::TwoPi()/cellSize));
+    fGridCellEta = 2*kGridEtaMax/fGridNEta;
+    fGridCellPhi = TMath::TwoPi()/fGridNPhi;
+  }
+  Int_t nCells = TMath::Max(1,fGridNEta*fGridNPhi);
+  fGridCellStart.assign(nCells+1,0);
+
+  for(Int_t iclus=0;iclus < nClus;iclus++){
+    AliVCluster* cluster = GetCluster(event,arrClusters,iclus);
+    if(!cluster) continue;
+    Float_t *clsPos = &fClusterPos[3*iclus];
+    cluster->GetPosition(clsPos);
+    Int_t cell = 0;
+    if(fGridNEta > 0){
+      TVector3 clsPosVec(clsPos);
+      cell = GetGridEtaBin(clsPosVec.Eta())*fGridNPhi + GetGridPhiBin(clsPosVec.Phi());
+    }
+    fClusterCell[iclus] = cell;
+    fGridCellStart[cell+1]++;
+  }
+  for(Int_t icell=0;icell < nCells;icell++) fGridCellStart[icell+1] += fGridCellStart[icell];
+
+  // fGridCandidates is used as fill counter per cell here, clusters stay in ascending order within a cell
+  fGridClusters.resize(fGridCellStart[nCells]);
+  fGridCandidates.assign(fGridCellStart.begin(),fGridCellStart.end()-1);
+  for(Int_t iclus=0;iclus < nClus;iclus++){
+    if(fClusterCell[iclus] < 0) continue;
+    fGridClusters[fGridCandidates[fClusterCell[iclus]]++] = iclus;
+  }
+  fGridCandidates.clear();
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatcher::GetClusterCandidates(Float_t eta, Float_t phi){
+  // collects the clusters in the 3x3 grid cells around (eta,phi), sorted by cluster index
+  // such that the matches are stored in the same order as when looping over all clusters
+  fGridCandidates.clear();
+  Int_t etaBin = GetGridEtaBin(eta);
+  Int_t phiBin = GetGridPhiBin(phi);
+  Int_t nPhiCells = TMath::Min(3,fGridNPhi);
+  for(Int_t ieta=TMath::Max(0,etaBin-1);ieta <= TMath::Min(fGridNEta-1,etaBin+1);ieta++){
+    for(Int_t i=0;i < nPhiCells;i++){
+      Int_t iphi = (nPhiCells < 3) ? i : (phiBin-1+i+fGridNPhi)%fGridNPhi;
+      Int_t cell = ieta*fGridNPhi + iphi;
+      for(Int_t j=fGridCellStart[cell];j < fGridCellStart[cell+1];j++) fGridCandidates.push_back(fGridClusters[j]);
+    }
+  }
+  sort(fGridCandidates.begin(),fGridCandidates.end());
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetTrackPosition(AliVEvent *event, Int_t trackID){
+  // for AOD, we have to look for position of track in the event, for ESD just take trackID
+  if(event->IsA()!=AliAODEvent::Class()) return trackID;
+  if(event == fProcessedEvent){
+    vecPairInt::iterator it = lower_bound(fVecTrackIDToPosition.begin(),fVecTrackIDToPosition.end(),make_pair(trackID,0),CompareFirst);
+    if(it != fVecTrackIDToPosition.end() && it->first == trackID) return it->second;
+  }
+  for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
+    AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
+    if(currTrack && currTrack->GetID() == trackID) return iTrack;
+  }
+  return -1;
+}
+
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliVTrack* inSecTrack, AliVCluster* cluster, AliVEvent* event, Float_t &dEta, Float_t &dPhi){
 
@@ -705,14 +826,7 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
 
     if(aodev){
       //need to search for position in case of AOD
-      Int_t TrackPos = -1;
-      for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-        AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-        if(currTrack->GetID() == inSecTrack->GetID()){
-          TrackPos = iTrack;
-          break;
-        }
-      }
+      Int_t TrackPos = GetTrackPosition(event,inSecTrack->GetID());
       if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: PropagateV0TrackToClusterAndGetMatchingResidual - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",inSecTrack->GetID()));
       fSecMapTrackToCluster.insert(make_pair(TrackPos,cluster->GetID()));
       fSecMapClusterToTrack.insert(make_pair(cluster->GetID(),TrackPos));
@@ -742,8 +856,13 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  // the last residual stored for the pair counts
+  pairIndex key = make_pair(make_pair(trackID,clusterID),0);
+  vector<pairIndex>::iterator it = upper_bound(fVec_TrID_ClID_ToIndex.begin(),fVec_TrID_ClID_ToIndex.end(),key,CompareKey);
+  if(it == fVec_TrID_ClID_ToIndex.begin()) return kFALSE;
+  --it;
+  if(it->first != key.first) return kFALSE;
+  Int_t position = it->second;
 
   pairFloat tempEtaPhi = fVectorDeltaEtaDeltaPhi.at(position-1);
   dEta = tempEtaPhi.first;
@@ -753,8 +872,8 @@ Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecClusterToTrack.begin(),fVecClusterToTrack.end(),make_pair(clusterID,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -777,8 +896,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecClusterToTrack.begin(),fVecClusterToTrack.end(),make_pair(clusterID,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -802,8 +921,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecClusterToTrack.begin(),fVecClusterToTrack.end(),make_pair(clusterID,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -819,23 +938,14 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
 
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecTrackToCluster.begin(),fVecTrackToCluster.end(),make_pair(TrackPos,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -854,23 +964,14 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecTrackToCluster.begin(),fVecTrackToCluster.end(),make_pair(TrackPos,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -892,23 +993,14 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecTrackToCluster.begin(),fVecTrackToCluster.end(),make_pair(TrackPos,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -922,8 +1014,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecClusterToTrack.begin(),fVecClusterToTrack.end(),make_pair(clusterID,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -945,8 +1037,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecClusterToTrack.begin(),fVecClusterToTrack.end(),make_pair(clusterID,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -971,8 +1063,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  Float_t dR){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecClusterToTrack.begin(),fVecClusterToTrack.end(),make_pair(clusterID,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == clusterID){
       Float_t tempDEta, tempDPhi;
       AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
@@ -987,23 +1079,14 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecTrackToCluster.begin(),fVecTrackToCluster.end(),make_pair(TrackPos,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1023,23 +1106,14 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecTrackToCluster.begin(),fVecTrackToCluster.end(),make_pair(TrackPos,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1060,23 +1134,14 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
   AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
   if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
+  pair<vecPairInt::iterator,vecPairInt::iterator> range = equal_range(fVecTrackToCluster.begin(),fVecTrackToCluster.end(),make_pair(TrackPos,0),CompareFirst);
+  for (vecPairInt::iterator it=range.first; it!=range.second; ++it){
     if(it->first == TrackPos){
       Float_t tempDEta, tempDPhi;
       if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
@@ -1177,17 +1242,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, In
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
@@ -1213,17 +1269,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
@@ -1252,17 +1299,8 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, In
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   Int_t matched = 0;
   multimap<Int_t,Int_t>::iterator it;
@@ -1350,17 +1388,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *ev
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   vector<Int_t> tempMatchedClusters;
   multimap<Int_t,Int_t>::iterator it;
@@ -1386,17 +1415,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   vector<Int_t> tempMatchedClusters;
   multimap<Int_t,Int_t>::iterator it;
@@ -1424,17 +1444,8 @@ vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *ev
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  Int_t TrackPos = GetTrackPosition(event,trackID); // for AOD position of the track in the event, for ESD the trackID
+  if(TrackPos == -1 && event->IsA()==AliAODEvent::Class()) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
 
   vector<Int_t> tempMatchedClusters;
   multimap<Int_t,Int_t>::iterator it;
@@ -1532,8 +1543,8 @@ void AliCaloTrackMatcher::DebugMatching(){
     cout << "vector etaphi:" << endl;
     cout << fVectorDeltaEtaDeltaPhi.size() << endl;
     cout << "multimap" << endl;
-    mapT::iterator iter = fMap_TrID_ClID_ToIndex.begin();
-    for (iter = fMap_TrID_ClID_ToIndex.begin(); iter != fMap_TrID_ClID_ToIndex.end(); ++iter){
+    vector<pairIndex>::iterator iter = fVec_TrID_ClID_ToIndex.begin();
+    for (iter = fVec_TrID_ClID_ToIndex.begin(); iter != fVec_TrID_ClID_ToIndex.end(); ++iter){
       Float_t dEta, dPhi = 0;
       if(!GetTrackClusterMatchingResidual(iter->first.first,iter->first.second,dEta,dPhi)) continue;
       cout << "  [" << iter->first.first << "/" << iter->first.second << ", " << iter->second << "] - (" << dEta << "/" << dPhi << ")" << endl;
@@ -1549,11 +1560,11 @@ void AliCaloTrackMatcher::DebugMatching(){
       cout << itr << " (" << tCharge << ") - " << GetNMatchedClusterIDsForTrack(fInputEvent,inTrack->GetID(),5,-5,0.2,-0.4) << "\t\t";
     }
     cout << endl;
-    multimap<Int_t,Int_t>::iterator it;
-    for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    vecPairInt::iterator it;
+    for (it=fVecTrackToCluster.begin(); it!=fVecTrackToCluster.end(); ++it) cout << it->first << " => " << it->second << '\n';
     cout << "mapClusterToTrack" << endl;
     Int_t tempClus = it->second;
-    for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it) cout << it->first << " => " << it->second << '\n';
+    for (it=fVecClusterToTrack.begin(); it!=fVecClusterToTrack.end(); ++it) cout << it->first << " => " << it->second << '\n';
     vector<Int_t> tempTracks = GetMatchedTrackIDsForCluster(fInputEvent,tempClus, 5, -5, 0.2, -0.4);
     for(UInt_t iJ=0; iJ<tempTracks.size();iJ++){
       cout << tempClus << " - " << tempTracks.at(iJ) << endl;
@@ -9,6 +9,7 @@
 #include <utility>
 
 class TF1;
+class TClonesArray;
 
 using namespace std;
 
@@ -31,6 +32,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     void SetAnalysisTrainMode(TString mode){fAnalysisTrainMode = mode; return;}
     void SetMatchingResidual(Float_t res) {fMatchingResidual = res; return;}
     void SetMatchingWindow(Float_t win) {fMatchingWindow = win; return;}
+    void SetClusterGridMargin(Float_t margin) {fGridMargin = margin; return;} // negative: propagate every track to all clusters
 
     // for cluster <-> primary matching
     Bool_t GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi);
@@ -80,6 +82,8 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     typedef pair<Int_t, Int_t> pairInt;
     typedef pair<Float_t, Float_t> pairFloat;
     typedef map<pairInt, Int_t> mapT;
+    typedef vector<pairInt> vecPairInt;
+    typedef pair<pairInt, Int_t> pairIndex;
 
     AliCaloTrackMatcher (const AliCaloTrackMatcher&); // not implemented
     AliCaloTrackMatcher & operator=(const AliCaloTrackMatcher&); // not implemented
@@ -87,6 +91,12 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     // private methods
     void Initialize(Int_t runNumber);
     void ProcessEvent(AliVEvent *event);
+    void FillClusterGrid(AliVEvent *event, TClonesArray *arrClusters, Int_t nClus);
+    void GetClusterCandidates(Float_t eta, Float_t phi);
+    Int_t GetGridEtaBin(Float_t eta) const;
+    Int_t GetGridPhiBin(Float_t phi) const;
+    AliVCluster* GetCluster(AliVEvent *event, TClonesArray *arrClusters, Int_t iclus);
+    Int_t GetTrackPosition(AliVEvent *event, Int_t trackID);
     void SetLogBinningYTH2(TH2* histoRebin);
 
     // debug methods
@@ -111,12 +121,27 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     AliEMCALGeometry*     fGeomEMCAL;              // pointer to EMCAL geometry
     AliPHOSGeometry*      fGeomPHOS;               // pointer to PHOS geometry
 
-    multimap<Int_t,Int_t> fMapTrackToCluster;      // connects a given track ID with all associated cluster IDs
-    multimap<Int_t,Int_t> fMapClusterToTrack;      // connects a given cluster ID with all associated track IDs
+    Float_t               fGridMargin;             // margin added to the matching residual for the size of the (eta,phi) cluster grid cells
+
+    vecPairInt            fVecTrackToCluster;      // (track ID, cluster ID) of all matches, sorted by track ID once the event is processed
+    vecPairInt            fVecClusterToTrack;      // (cluster ID, track ID) of all matches, sorted by cluster ID once the event is processed
 
     Int_t                 fNEntries;               // number of current TrackID/ClusterID -> Eta/Phi connections
     vector<pairFloat>     fVectorDeltaEtaDeltaPhi; // vector of all matching residuals for a specific TrackID/ClusterID
-    mapT                  fMap_TrID_ClID_ToIndex;  // map tuple of (trackID,clusterID) to index in vector fVectorDeltaEtaDeltaPhi
+    vector<pairIndex>     fVec_TrID_ClID_ToIndex;  // tuple of (trackID,clusterID) and index in vector fVectorDeltaEtaDeltaPhi, sorted once the event is processed
+    vecPairInt            fVecTrackIDToPosition;   // AOD: (track ID, position of the track in the event), sorted by track ID
+    AliVEvent*            fProcessedEvent;         //! event the matches and fVecTrackIDToPosition belong to
+
+    // (eta,phi) grid of the clusters, rebuilt every event
+    Int_t                 fGridNEta;               //! number of grid cells in eta
+    Int_t                 fGridNPhi;               //! number of grid cells in phi
+    Float_t               fGridCellEta;            //! cell size in eta
+    Float_t               fGridCellPhi;            //! cell size in phi
+    vector<Int_t>         fGridCellStart;          //! first entry of each cell in fGridClusters (one more entry than cells)
+    vector<Int_t>         fGridClusters;           //! cluster indices ordered by grid cell
+    vector<Int_t>         fClusterCell;            //! grid cell of each cluster (-1: no cluster)
+    vector<Float_t>       fClusterPos;             //! x,y,z of each cluster
+    vector<Int_t>         fGridCandidates;         //! clusters in the cells around the current track, in ascending order
 
     // for cluster <-> V0-track matching (running with different mass hypthesis)
     multimap<Int_t,Int_t> fSecMapTrackToCluster;      // connects a given secondary track ID with all associated cluster IDs
@@ -132,7 +157,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     TH2F*                 fHistControlMatches;     // bookkeeping for processed tracks/clusters and succesful matches
     TH2F*                 fSecHistControlMatches;  // bookkeeping for processed V0-tracks/clusters and succesful matches
 
-    ClassDef(AliCaloTrackMatcher,5)
+    ClassDef(AliCaloTrackMatcher,6)
 };
 
 #endif
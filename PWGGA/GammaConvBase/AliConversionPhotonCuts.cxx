@@ -67,6 +67,10 @@ using namespace std;
 ClassImp(AliConversionPhotonCuts)
 /// \endcond
 
+namespace {
+  const Double_t kRecordNotSet = -1.e30;    // quantity of the PhotonRecord not computed yet
+}
+
 const char* AliConversionPhotonCuts::fgkCutNames[AliConversionPhotonCuts::kNCuts] = {
   "V0FinderType",           // 0
   "EtaCut",                 // 1
@@ -251,7 +255,8 @@ AliConversionPhotonCuts::AliConversionPhotonCuts(const char *name,const char *ti
   fBadRegionCMax(0),
   fBadRegionAMax(0),
   fExcludeMinR(180.),
-  fExcludeMaxR(250.)
+  fExcludeMaxR(250.),
+  fPhotonRecord(NULL)
 {
   InitPIDResponse();
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=0;}
@@ -423,7 +428,8 @@ AliConversionPhotonCuts::AliConversionPhotonCuts(const AliConversionPhotonCuts &
   fBadRegionCMax(ref.fBadRegionCMax),
   fBadRegionAMax(ref.fBadRegionAMax),
   fExcludeMinR(ref.fExcludeMinR),
-  fExcludeMaxR(ref.fExcludeMaxR)
+  fExcludeMaxR(ref.fExcludeMaxR),
+  fPhotonRecord(NULL)
 {
   // Copy Constructor
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=ref.fCuts[jj];}
@@ -1211,7 +1217,10 @@ Bool_t AliConversionPhotonCuts::PhotonCuts(AliConversionPhotonBase *photon,AliVE
 
   AliAODConversionPhoton* photonAOD = dynamic_cast<AliAODConversionPhoton*>(photon);
   if (photonAOD){
-    photonAOD->CalculateDistanceOfClossetApproachToPrimVtx(event->GetPrimaryVertex());
+    if(!fPhotonRecord || fPhotonRecord->fPhoton != photon || fPhotonRecord->fEvent != event || !fPhotonRecord->fDCADone){
+      photonAOD->CalculateDistanceOfClossetApproachToPrimVtx(event->GetPrimaryVertex());
+      if(fPhotonRecord && fPhotonRecord->fPhoton == photon && fPhotonRecord->fEvent == event) fPhotonRecord->fDCADone = kTRUE;
+    }
 
     cutIndex++; //9
     if(photonAOD->GetDCArToPrimVtx() > fDCARPrimVtxCut) { //DCA R cut of photon to primary vertex
@@ -1316,21 +1325,7 @@ Bool_t AliConversionPhotonCuts::TrackIsSelected(AliConversionPhotonBase *photon,
 
   // check if V0 from AliAODGammaConversion.root is actually contained in AOD by checking if V0 exists with same tracks
   if(event->IsA()==AliAODEvent::Class() && fPreSelCut && ( fIsHeavyIon != 1 )) {
-    AliAODEvent* aodEvent = dynamic_cast<AliAODEvent*>(event);
-
-    Bool_t bFound = kFALSE;
-    Int_t v0PosID = posTrack->GetID();
-    Int_t v0NegID = negTrack->GetID();
-    AliAODv0* v0 = NULL;
-    for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
-      v0 = aodEvent->GetV0(iV);
-      if(!v0) continue;
-      if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
-        bFound = kTRUE;
-        break;
-      }
-    }
-    if(!bFound){
+    if(!IsV0InAOD(event, negTrack, posTrack)){
       return kFALSE;
     }
   }
@@ -1370,21 +1365,7 @@ Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon
 
   // check if V0 from AliAODGammaConversion.root is actually contained in AOD by checking if V0 exists with same tracks
   if(event->IsA()==AliAODEvent::Class() && fPreSelCut && ( fIsHeavyIon != 1 || (fIsHeavyIon == 1 && fProcessAODCheck) )) {
-    AliAODEvent* aodEvent = dynamic_cast<AliAODEvent*>(event);
-
-    Bool_t bFound = kFALSE;
-    Int_t v0PosID = posTrack->GetID();
-    Int_t v0NegID = negTrack->GetID();
-    AliAODv0* v0 = NULL;
-    for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
-      v0 = aodEvent->GetV0(iV);
-      if(!v0) continue;
-      if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
-        bFound = kTRUE;
-        break;
-      }
-    }
-    if(!bFound){
+    if(!IsV0InAOD(event, negTrack, posTrack)){
       FillPhotonCutIndex(kNoV0);
       return kFALSE;
     }
@@ -1417,6 +1398,56 @@ Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon
   return kTRUE;
 }
 
+///________________________________________________________________________
+ULong64_t AliConversionPhotonCuts::PhotonIsSelectedCutSets(AliConversionPhotonBase *photon, AliVEvent * event, TList *cutSets){
+  // Evaluates the photon for all cut sets (AliConversionPhotonCuts) in cutSets in one pass and returns
+  // a bitmask with bit i set if the photon passed the i-th cut set. Quantities which do not depend on
+  // the cut settings (daughter tracks, AOD V0 check, PID n sigma, pointing angle, DCA to the primary
+  // vertex) are computed by the first cut set needing them and shared with the others. The per cut set
+  // bookkeeping histograms are filled as with PhotonIsSelected. At most 64 cut sets are evaluated.
+
+  ULong64_t passed = 0;
+  if(!photon || !event || !cutSets) return passed;
+  if(cutSets->GetEntries() > 64)
+    AliWarningClass(Form("%d cut sets given, only the first 64 are evaluated", cutSets->GetEntries()));
+
+  PhotonRecord record(photon, event);
+  TIter next(cutSets);
+  AliConversionPhotonCuts *cuts = NULL;
+  for(Int_t iCut = 0; iCut < 64 && (cuts = static_cast<AliConversionPhotonCuts*>(next())); iCut++){
+    if(!cuts->fPIDResponse) cuts->InitPIDResponse();
+    if(iCut == 0){
+      // cached tracks and n sigma are only shared with cut sets using the same V0 reader and PID response
+      record.fPIDResponse   = cuts->fPIDResponse;
+      record.fV0ReaderName  = cuts->fV0ReaderName;
+    }
+    cuts->fPhotonRecord = &record;
+    if(cuts->PhotonIsSelected(photon, event)) passed |= (static_cast<ULong64_t>(1) << iCut);
+    cuts->fPhotonRecord = NULL;
+  }
+  return passed;
+}
+
+///________________________________________________________________________
+AliConversionPhotonCuts::PhotonRecord::PhotonRecord(AliConversionPhotonBase *photon, AliVEvent *event):
+  fPhoton(photon),
+  fEvent(event),
+  fPIDResponse(NULL),
+  fV0ReaderName(""),
+  fV0InAOD(-1),
+  fCosPA(kRecordNotSet),
+  fCosPADone(kFALSE),
+  fDCADone(kFALSE)
+{
+  for(Int_t leg = 0; leg < 2; leg++){
+    fTrackDone[leg] = kFALSE;
+    fTrack[leg]     = NULL;
+    fNSigmaTOF[leg] = kRecordNotSet;
+    fNSigmaITS[leg] = kRecordNotSet;
+    for(Int_t type = 0; type < AliPID::kSPECIES; type++) fNSigmaTPC[leg][type] = kRecordNotSet;
+  }
+}
+
 ///________________________________________________________________________
 Bool_t AliConversionPhotonCuts::ArmenterosQtCut(AliConversionPhotonBase *photon){   // Armenteros Qt Cut
   if(fDo2DQt){
@@ -1751,8 +1782,8 @@ Float_t AliConversionPhotonCuts::GetKappaTPC(AliConversionPhotonBase *gamma, Ali
 
   Float_t KappaPlus, KappaMinus, Kappa;
   if(fDoElecDeDxPostCalibration){
-    CentrnSig[0]=fPIDResponse->NumberOfSigmasTPC(negTrack,AliPID::kElectron);
-    CentrnSig[1]=fPIDResponse->NumberOfSigmasTPC(posTrack,AliPID::kElectron);
+    CentrnSig[0]=GetNSigmaTPC(negTrack,AliPID::kElectron);
+    CentrnSig[1]=GetNSigmaTPC(posTrack,AliPID::kElectron);
     P[0]        =negTrack->P();
     P[1]        =posTrack->P();
     Eta[0]      =negTrack->Eta();
@@ -1760,8 +1791,8 @@ Float_t AliConversionPhotonCuts::GetKappaTPC(AliConversionPhotonBase *gamma, Ali
     KappaMinus = GetCorrectedElectronTPCResponse(negTrack->Charge(),CentrnSig[0],P[0],Eta[0],negTrack->GetTPCNcls(),gamma->GetConversionRadius());
     KappaPlus =  GetCorrectedElectronTPCResponse(posTrack->Charge(),CentrnSig[1],P[1],Eta[1],posTrack->GetTPCNcls(),gamma->GetConversionRadius());
   }else{
-    KappaMinus = fPIDResponse->NumberOfSigmasTPC(negTrack, AliPID::kElectron);
-    KappaPlus =  fPIDResponse->NumberOfSigmasTPC(posTrack, AliPID::kElectron);
+    KappaMinus = GetNSigmaTPC(negTrack,AliPID::kElectron);
+    KappaPlus =  GetNSigmaTPC(posTrack,AliPID::kElectron);
   }
   Kappa = ( TMath::Abs(KappaMinus) + TMath::Abs(KappaPlus) ) / 2.0 + 2.0*(KappaMinus+KappaPlus);
 
@@ -1803,8 +1834,8 @@ Bool_t AliConversionPhotonCuts::GetBDTVariableValues(AliConversionPhotonBase *ga
   values[2]= (Float_t)negTrack->GetTPCClusterInfo(2,0,GetFirstTPCRow(gamma->GetConversionRadius())); //"fracClsTPCElectron"
   values[3]= nPosClusterITS; //"clsITSPositron"
   values[4]= nNegClusterITS; //"clsITSElectron"
-  values[5]=fPIDResponse->NumberOfSigmasTPC(negTrack,AliPID::kElectron); //"nSigmaTPCElectron"
-  values[6]=fPIDResponse->NumberOfSigmasTPC(posTrack,AliPID::kElectron); //"nSigmaTPCPositron"
+  values[5]=GetNSigmaTPC(negTrack,AliPID::kElectron); //"nSigmaTPCElectron"
+  values[6]=GetNSigmaTPC(posTrack,AliPID::kElectron); //"nSigmaTPCPositron"
 
   return kTRUE;
 }
@@ -1819,7 +1850,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
   if(!fPIDResponse){AliError("No PID Response"); return kTRUE;}// if still missing fatal error
 
   Short_t Charge    = fCurrentTrack->Charge();
-  Double_t electronNSigmaTPC = fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kElectron);
+  Double_t electronNSigmaTPC = GetNSigmaTPC(fCurrentTrack,AliPID::kElectron);
   Double_t electronNSigmaTPCCor=0.;
   Double_t P=0.;
   Double_t Eta=0.;
@@ -1852,12 +1883,12 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
     // TPC Pion Line
     if( fCurrentTrack->P()>fPIDMinPnSigmaAbovePionLine && fCurrentTrack->P()<fPIDMaxPnSigmaAbovePionLine ){
       if(fDoElecDeDxPostCalibration){
-        if( electronNSigmaTPCCor >fPIDnSigmaBelowElectronLine && electronNSigmaTPCCor < fPIDnSigmaAboveElectronLine && fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLine){
+        if( electronNSigmaTPCCor >fPIDnSigmaBelowElectronLine && electronNSigmaTPCCor < fPIDnSigmaAboveElectronLine && GetNSigmaTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLine){
           if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
       } else{
-        if( electronNSigmaTPC > fPIDnSigmaBelowElectronLine && electronNSigmaTPC < fPIDnSigmaAboveElectronLine && fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLine){
+        if( electronNSigmaTPC > fPIDnSigmaBelowElectronLine && electronNSigmaTPC < fPIDnSigmaAboveElectronLine && GetNSigmaTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLine){
           if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
@@ -1868,12 +1899,12 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
     // High Pt Pion rej
     if( fCurrentTrack->P()>fPIDMaxPnSigmaAbovePionLine ){
       if(fDoElecDeDxPostCalibration){
-        if( electronNSigmaTPCCor > fPIDnSigmaBelowElectronLine && electronNSigmaTPCCor < fPIDnSigmaAboveElectronLine && fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLineHighPt){
+        if( electronNSigmaTPCCor > fPIDnSigmaBelowElectronLine && electronNSigmaTPCCor < fPIDnSigmaAboveElectronLine && GetNSigmaTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLineHighPt){
           if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
       } else{
-        if( electronNSigmaTPC > fPIDnSigmaBelowElectronLine && electronNSigmaTPC < fPIDnSigmaAboveElectronLine && fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLineHighPt){
+        if( electronNSigmaTPC > fPIDnSigmaBelowElectronLine && electronNSigmaTPC < fPIDnSigmaAboveElectronLine && GetNSigmaTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLineHighPt){
           if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
@@ -1885,7 +1916,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
 
   if(fDoKaonRejectionLowP == kTRUE && !fSwitchToKappa){
     if(fCurrentTrack->P()<fPIDMinPKaonRejectionLowP ){
-      if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kKaon))<fPIDnSigmaAtLowPAroundKaonLine){
+      if( TMath::Abs(GetNSigmaTPC(fCurrentTrack,AliPID::kKaon))<fPIDnSigmaAtLowPAroundKaonLine){
         if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
@@ -1895,7 +1926,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
 
   if(fDoProtonRejectionLowP == kTRUE && !fSwitchToKappa){
     if( fCurrentTrack->P()<fPIDMinPProtonRejectionLowP ){
-      if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kProton))<fPIDnSigmaAtLowPAroundProtonLine){
+      if( TMath::Abs(GetNSigmaTPC(fCurrentTrack,AliPID::kProton))<fPIDnSigmaAtLowPAroundProtonLine){
         if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
@@ -1905,7 +1936,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
 
   if(fDoPionRejectionLowP == kTRUE && !fSwitchToKappa){
     if( fCurrentTrack->P()<fPIDMinPPionRejectionLowP ){
-      if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion))<fPIDnSigmaAtLowPAroundPionLine){
+      if( TMath::Abs(GetNSigmaTPC(fCurrentTrack,AliPID::kPion))<fPIDnSigmaAtLowPAroundPionLine){
         if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
@@ -1923,29 +1954,29 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
       Double_t dT = TOFsignal - t0 - times[0];
       fHistoTOFbefore->Fill(fCurrentTrack->P(),dT);
     }
-    if(fHistoTOFSigbefore) fHistoTOFSigbefore->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
+    if(fHistoTOFSigbefore) fHistoTOFSigbefore->Fill(fCurrentTrack->P(),GetNSigmaTOFElectron(fCurrentTrack));
     if(fUseTOFpid){
-      if(fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron)>fTofPIDnSigmaAboveElectronLine ||
-        fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron)<fTofPIDnSigmaBelowElectronLine ){
+      if(GetNSigmaTOFElectron(fCurrentTrack)>fTofPIDnSigmaAboveElectronLine ||
+        GetNSigmaTOFElectron(fCurrentTrack)<fTofPIDnSigmaBelowElectronLine ){
         if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
-    if(fHistoTOFSigafter)fHistoTOFSigafter->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
+    if(fHistoTOFSigafter)fHistoTOFSigafter->Fill(fCurrentTrack->P(),GetNSigmaTOFElectron(fCurrentTrack));
   }
   cutIndex++; //8
 
   if((fCurrentTrack->GetStatus() & AliESDtrack::kITSpid)){
-    if(fHistoITSSigbefore) fHistoITSSigbefore->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
+    if(fHistoITSSigbefore) fHistoITSSigbefore->Fill(fCurrentTrack->P(),GetNSigmaITSElectron(fCurrentTrack));
     if(fUseITSpid){
       if(fCurrentTrack->Pt()<=fMaxPtPIDITS){
-        if(fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron)>fITSPIDnSigmaAboveElectronLine || fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron)<fITSPIDnSigmaBelowElectronLine ){
+        if(GetNSigmaITSElectron(fCurrentTrack)>fITSPIDnSigmaAboveElectronLine || GetNSigmaITSElectron(fCurrentTrack)<fITSPIDnSigmaBelowElectronLine ){
           if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
       }
     }
-    if(fHistoITSSigafter)fHistoITSSigafter->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
+    if(fHistoITSSigafter)fHistoITSSigafter->Fill(fCurrentTrack->P(),GetNSigmaITSElectron(fCurrentTrack));
   }
 
   cutIndex++; //9
@@ -2018,6 +2049,26 @@ Bool_t AliConversionPhotonCuts::AsymmetryCut(AliConversionPhotonBase * photon,Al
 
 ///________________________________________________________________________
 AliVTrack *AliConversionPhotonCuts::GetTrack(AliVEvent * event, Int_t label){
+  //Returns pointer to the track with given ESD label, daughters of the photon
+  //evaluated in PhotonIsSelectedCutSets are looked up only once for all cut sets
+
+  if(fPhotonRecord && event == fPhotonRecord->fEvent && fV0ReaderName.CompareTo(fPhotonRecord->fV0ReaderName) == 0){
+    Int_t leg = -1;
+    if(label == fPhotonRecord->fPhoton->GetTrackLabelNegative()) leg = 0;
+    else if(label == fPhotonRecord->fPhoton->GetTrackLabelPositive()) leg = 1;
+    if(leg >= 0){
+      if(!fPhotonRecord->fTrackDone[leg]){
+        fPhotonRecord->fTrack[leg]      = FindTrack(event, label);
+        fPhotonRecord->fTrackDone[leg]  = kTRUE;
+      }
+      return fPhotonRecord->fTrack[leg];
+    }
+  }
+  return FindTrack(event, label);
+}
+
+///________________________________________________________________________
+AliVTrack *AliConversionPhotonCuts::FindTrack(AliVEvent * event, Int_t label){
   //Returns pointer to the track with given ESD label
   //(Important for AOD implementation, since Track array in AOD data is different
   //from ESD array, but ESD tracklabels are stored in AOD Tracks)
@@ -2050,6 +2101,76 @@ AliVTrack *AliConversionPhotonCuts::GetTrack(AliVEvent * event, Int_t label){
   return NULL;
 }
 
+///________________________________________________________________________
+Int_t AliConversionPhotonCuts::GetRecordLeg(const AliVTrack *track) const {
+  // Index of the track in the record of the photon evaluated in PhotonIsSelectedCutSets
+  // (0: negative, 1: positive daughter), -1 if the track is not a daughter or there is no record
+
+  if(!fPhotonRecord || !track || fPhotonRecord->fPIDResponse != fPIDResponse) return -1;
+  for(Int_t leg = 0; leg < 2; leg++){
+    if(fPhotonRecord->fTrackDone[leg] && fPhotonRecord->fTrack[leg] == track) return leg;
+  }
+  return -1;
+}
+
+///________________________________________________________________________
+Double_t AliConversionPhotonCuts::GetNSigmaTPC(AliVTrack *track, AliPID::EParticleType type){
+  // TPC n sigma of the track, cached for the daughters of the photon evaluated in PhotonIsSelectedCutSets
+
+  Int_t leg = GetRecordLeg(track);
+  if(leg < 0 || type < 0 || type >= AliPID::kSPECIES) return fPIDResponse->NumberOfSigmasTPC(track, type);
+  Double_t &nSigma = fPhotonRecord->fNSigmaTPC[leg][type];
+  if(nSigma == kRecordNotSet) nSigma = fPIDResponse->NumberOfSigmasTPC(track, type);
+  return nSigma;
+}
+
+///________________________________________________________________________
+Double_t AliConversionPhotonCuts::GetNSigmaTOFElectron(AliVTrack *track){
+  // TOF electron n sigma of the track, cached for the daughters of the photon evaluated in PhotonIsSelectedCutSets
+
+  Int_t leg = GetRecordLeg(track);
+  if(leg < 0) return fPIDResponse->NumberOfSigmasTOF(track, AliPID::kElectron);
+  Double_t &nSigma = fPhotonRecord->fNSigmaTOF[leg];
+  if(nSigma == kRecordNotSet) nSigma = fPIDResponse->NumberOfSigmasTOF(track, AliPID::kElectron);
+  return nSigma;
+}
+
+///________________________________________________________________________
+Double_t AliConversionPhotonCuts::GetNSigmaITSElectron(AliVTrack *track){
+  // ITS electron n sigma of the track, cached for the daughters of the photon evaluated in PhotonIsSelectedCutSets
+
+  Int_t leg = GetRecordLeg(track);
+  if(leg < 0) return fPIDResponse->NumberOfSigmasITS(track, AliPID::kElectron);
+  Double_t &nSigma = fPhotonRecord->fNSigmaITS[leg];
+  if(nSigma == kRecordNotSet) nSigma = fPIDResponse->NumberOfSigmasITS(track, AliPID::kElectron);
+  return nSigma;
+}
+
+///________________________________________________________________________
+Bool_t AliConversionPhotonCuts::IsV0InAOD(AliVEvent *event, AliVTrack *negTrack, AliVTrack *posTrack){
+  // check if V0 from AliAODGammaConversion.root is actually contained in AOD by checking if V0 exists with same tracks
+
+  Bool_t useRecord = fPhotonRecord && event == fPhotonRecord->fEvent &&
+                     fPhotonRecord->fTrack[0] == negTrack && fPhotonRecord->fTrack[1] == posTrack;
+  if(useRecord && fPhotonRecord->fV0InAOD >= 0) return fPhotonRecord->fV0InAOD == 1;
+
+  AliAODEvent* aodEvent = dynamic_cast<AliAODEvent*>(event);
+  Bool_t bFound = kFALSE;
+  Int_t v0PosID = posTrack->GetID();
+  Int_t v0NegID = negTrack->GetID();
+  AliAODv0* v0 = NULL;
+  for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
+    v0 = aodEvent->GetV0(iV);
+    if(!v0) continue;
+    if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
+      bFound = kTRUE;
+      break;
+    }
+  }
+  if(useRecord) fPhotonRecord->fV0InAOD = bFound ? 1 : 0;
+  return bFound;
+}
+
 ///________________________________________________________________________
 AliESDtrack *AliConversionPhotonCuts::GetESDTrack(AliESDEvent * event, Int_t label){
   //Returns pointer to the track with given ESD label
@@ -4318,6 +4439,9 @@ Bool_t AliConversionPhotonCuts::CosinePAngleCut(const AliConversionPhotonBase *
 Double_t AliConversionPhotonCuts::GetCosineOfPointingAngle( const AliConversionPhotonBase * photon, AliVEvent * event) const{
   // calculates the pointing angle of the recalculated V0
 
+  if(fPhotonRecord && fPhotonRecord->fPhoton == photon && fPhotonRecord->fEvent == event && fPhotonRecord->fCosPADone)
+    return fPhotonRecord->fCosPA;
+
   Double_t momV0[3] = {0,0,0};
   if(event->IsA()==AliESDEvent::Class()){
     AliESDEvent *esdEvent = dynamic_cast<AliESDEvent*>(event);
@@ -4345,6 +4469,11 @@ Double_t AliConversionPhotonCuts::GetCosineOfPointingAngle( const AliConversionP
   if(momV02*PosV02 > 0.0)
     cosinePointingAngle = (PosV0[0]*momV0[0] +  PosV0[1]*momV0[1] + PosV0[2]*momV0[2] ) / TMath::Sqrt(momV02 * PosV02);
 
+  if(fPhotonRecord && fPhotonRecord->fPhoton == photon && fPhotonRecord->fEvent == event){
+    fPhotonRecord->fCosPA     = cosinePointingAngle;
+    fPhotonRecord->fCosPADone = kTRUE;
+  }
+
   return cosinePointingAngle;
 }
 
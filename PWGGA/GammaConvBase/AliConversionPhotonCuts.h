@@ -8,6 +8,7 @@
 #include "AliESDtrack.h"
 #include "AliVTrack.h"
 #include "AliAODTrack.h"
+#include "AliPID.h"
 #include "AliMCEvent.h"
 #include "AliAnalysisCuts.h"
 #include "TH1F.h"
@@ -159,6 +160,7 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     // Cut Selection
     Bool_t TrackIsSelected(AliConversionPhotonBase * photon, AliVEvent  * event);
     Bool_t PhotonIsSelected(AliConversionPhotonBase * photon, AliVEvent  * event);
+    static ULong64_t PhotonIsSelectedCutSets(AliConversionPhotonBase * photon, AliVEvent * event, TList * cutSets);
     Bool_t PhotonIsSelectedMC(TParticle *particle,AliMCEvent *mcEvent,Bool_t checkForConvertedGamma=kTRUE);
     Bool_t PhotonIsSelectedAODMC(AliAODMCParticle *particle,TClonesArray *aodmcArray,Bool_t checkForConvertedGamma=kTRUE);
     Bool_t PhotonIsSelectedMCAODESD(AliDalitzAODESDMC *particle,AliDalitzEventMC *mcEvent,Bool_t checkForConvertedGamma) const;
@@ -182,6 +184,7 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     void SetProcessAODCheck(Bool_t flag){fProcessAODCheck = flag; return;}
 
     AliVTrack * GetTrack(AliVEvent * event, Int_t label);
+    AliVTrack * FindTrack(AliVEvent * event, Int_t label);
     AliESDtrack *GetESDTrack(AliESDEvent * event, Int_t label);
 
     ///Cut functions
@@ -267,6 +270,36 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     void ForceTPCRecalibrationAsFunctionOfConvR(){fIsRecalibDepTPCCl = kFALSE;}
 
   protected:
+    /**
+     * @struct PhotonRecord
+     * @brief Quantities of a photon candidate which do not depend on the cut settings
+     *
+     * Filled lazily while the cut sets passed to PhotonIsSelectedCutSets are evaluated,
+     * each quantity is computed by the first cut set asking for it and reused by the others.
+     */
+    struct PhotonRecord {
+      PhotonRecord(AliConversionPhotonBase *photon, AliVEvent *event);
+      AliConversionPhotonBase* fPhoton;                     ///< photon candidate
+      AliVEvent*        fEvent;                             ///< event the photon belongs to
+      AliPIDResponse*   fPIDResponse;                       ///< PID response the n sigma values were obtained with
+      TString           fV0ReaderName;                      ///< V0 reader the daughter tracks were looked up with
+      Bool_t            fTrackDone[2];                      ///< daughter track looked up (0: negative, 1: positive)
+      AliVTrack*        fTrack[2];                          ///< daughter tracks
+      Int_t             fV0InAOD;                           ///< V0 with the same daughters present in the AOD (-1: not checked)
+      Double_t          fNSigmaTPC[2][AliPID::kSPECIES];    ///< TPC n sigma of the daughters for e, mu, pi, K, p
+      Double_t          fNSigmaTOF[2];                      ///< TOF electron n sigma of the daughters
+      Double_t          fNSigmaITS[2];                      ///< ITS electron n sigma of the daughters
+      Double_t          fCosPA;                             ///< cosine of the pointing angle
+      Bool_t            fCosPADone;                         ///< cosine of the pointing angle computed
+      Bool_t            fDCADone;                           ///< DCA to the primary vertex computed (AOD photons)
+    };
+
+    Int_t             GetRecordLeg(const AliVTrack *track) const;
+    Double_t          GetNSigmaTPC(AliVTrack *track, AliPID::EParticleType type);
+    Double_t          GetNSigmaTOFElectron(AliVTrack *track);
+    Double_t          GetNSigmaITSElectron(AliVTrack *track);
+    Bool_t            IsV0InAOD(AliVEvent *event, AliVTrack *negTrack, AliVTrack *posTrack);
+
     TList*            fHistograms;                          ///< List of QA histograms
     AliPIDResponse*   fPIDResponse;                         ///< PID response
 
@@ -424,10 +457,11 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     Double_t          fBadRegionAMax;                       ///<
     Double_t          fExcludeMinR;                         ///< r cut exclude region
     Double_t          fExcludeMaxR;                         ///< r cut exclude region
+    PhotonRecord*     fPhotonRecord;                        //!<! record of the photon evaluated in PhotonIsSelectedCutSets
 
   private:
     /// \cond CLASSIMP
-    ClassDef(AliConversionPhotonCuts,30)
+    ClassDef(AliConversionPhotonCuts,31)
     /// \endcond
 };
 
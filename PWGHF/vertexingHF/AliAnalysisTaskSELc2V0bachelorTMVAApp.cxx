@@ -75,6 +75,7 @@
 #include <TMVA/MethodCuts.h>
 
 #include "IClassifierReader.h"
+#include "AliHFFlatBDTReader.h"
 
 using std::cout;
 using std::endl;
@@ -231,6 +232,7 @@ AliAnalysisTaskSELc2V0bachelorTMVAApp::AliAnalysisTaskSELc2V0bachelorTMVAApp():
   fNVarsSpectators(0),
   fVarsTMVASpectators(0),
   fXmlWeightsFile(""),
+  fUseFlatBDT(kFALSE),
   fBDTHistoTMVA(0),  
   fRefMult(9.26),
   fYearNumber(16),
@@ -397,6 +399,7 @@ AliAnalysisTaskSELc2V0bachelorTMVAApp::AliAnalysisTaskSELc2V0bachelorTMVAApp(con
   fVarsTMVASpectators(0),
   fNamesTMVAVarSpectators(""),
   fXmlWeightsFile(""),
+  fUseFlatBDT(kFALSE),
   fBDTHistoTMVA(0),  
   fRefMult(9.26),
   fYearNumber(16),
@@ -494,6 +497,7 @@ AliAnalysisTaskSELc2V0bachelorTMVAApp::~AliAnalysisTaskSELc2V0bachelorTMVAApp()
   
   if (fBDTReader) {
     //delete fBDTReader;
+    if (fUseFlatBDT) delete fBDTReader;
     fBDTReader = 0;
   }
 
@@ -1091,7 +1095,11 @@ void AliAnalysisTaskSELc2V0bachelorTMVAApp::UserCreateOutputObjects() {
       if (fUseXmlWeightsFile) fReader->AddSpectator(variable.Data(), &fVarsTMVASpectators[i]);
     }
     delete tokensSpectators;
-    if (fUseWeightsLibrary) {
+    if (fUseWeightsLibrary && fUseFlatBDT) {
+      fBDTReader = new AliHFFlatBDTReader(fXmlWeightsFile.Data(), inputNamesVec);
+      if (!fBDTReader->IsStatusClean()) AliFatal(Form("Could not read the BDT from %s", fXmlWeightsFile.Data()));
+    }
+    else if (fUseWeightsLibrary) {
       void* lib = dlopen(fTMVAlibName.Data(), RTLD_NOW);
       void* p = dlsym(lib, Form("%s", fTMVAlibPtBin.Data()));
       IClassifierReader* (*maker1)(std::vector<std::string>&) = (IClassifierReader* (*)(std::vector<std::string>&)) p;
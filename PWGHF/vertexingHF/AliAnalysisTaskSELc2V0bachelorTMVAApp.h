@@ -182,6 +182,11 @@ class AliAnalysisTaskSELc2V0bachelorTMVAApp : public AliAnalysisTaskSE
   void SetXmlWeightsFile(TString fileName) {fXmlWeightsFile = fileName;}
   TString GetXmlWeightsFile() const {return fXmlWeightsFile;}
 
+  /// with SetUseWeightsLibrary(kTRUE), read the BDT from the xml weights file
+  /// with AliHFFlatBDTReader instead of loading the generated BDT class library
+  void SetUseFlatBDT(Bool_t flag) {fUseFlatBDT = flag;}
+  Bool_t GetUseFlatBDT() const {return fUseFlatBDT;}
+
   void SetUseMultiplicityCorrection(Bool_t flag){fUseMultCorrection=flag;}
 
   void SetReferenceMultiplcity(Double_t rmu){fRefMult=rmu;}
@@ -595,6 +600,7 @@ class AliAnalysisTaskSELc2V0bachelorTMVAApp : public AliAnalysisTaskSE
   Float_t* fVarsTMVASpectators;         //[fNVarsSpectators] // variables to be used by TMVA
   TString fNamesTMVAVarSpectators;      // vector of the names of the spectators variables
   TString fXmlWeightsFile;              // file with TMVA weights
+  Bool_t fUseFlatBDT;                   // flag to use AliHFFlatBDTReader on the xml file as BDT reader
   TH2D *fBDTHistoTMVA;                  //!<! BDT histo file for the case in which the xml file is used
   
   // Multiplicity corrections
@@ -615,7 +621,7 @@ class AliAnalysisTaskSELc2V0bachelorTMVAApp : public AliAnalysisTaskSE
   TH2F* fHistoVzVsNtrCorr;           //!<! hist. Vz vs corrected tracklets
   
   /// \cond CLASSIMP    
-  ClassDef(AliAnalysisTaskSELc2V0bachelorTMVAApp, 10); /// class for Lc->p K0
+  ClassDef(AliAnalysisTaskSELc2V0bachelorTMVAApp, 11); /// class for Lc->p K0
   /// \endcond    
 };
 
@@ -267,4 +267,5 @@ void AliAnalysisTaskSEVertexingHF::Terminate(Option_t */*option*/)
   // Terminate analysis
   //
   if(fDebug > 1) printf("AnalysisTaskSEVertexingHF: Terminate() \n");
+  if(fDebug > 1 && fVHF) fVHF->PrintPreFilterStatistics();
 }
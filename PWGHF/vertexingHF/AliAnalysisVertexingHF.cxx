@@ -138,6 +138,7 @@ fFindVertexForDstar(kTRUE),
 fFindVertexForCascades(kTRUE),
 fV0TypeForCascadeVertex(0),
 fMassCutBeforeVertexing(kFALSE),
+fMassCutAtPrimVtx2Prong(kFALSE),
 fMassCalc2(0),
 fMassCalc3(0),
 fMassCalc4(0),
@@ -152,6 +153,10 @@ fOKInvMassD0to4p(kFALSE),
 fOKInvMassLctoV0(kFALSE),
 fnTrksTotal(0),
 fnSeleTrksTotal(0),
+fnPairsRejBeforeVtx(0),
+fnTripletsRejBeforeVtx(0),
+fnQuadrupletsRejBeforeVtx(0),
+fnDCAsAvoided(0),
 fMakeReducedRHF(kFALSE),
 fMassDzero(0.),
 fMassDplus(0.),
@@ -234,6 +239,7 @@ fFindVertexForDstar(source.fFindVertexForDstar),
 fFindVertexForCascades(source.fFindVertexForCascades),
 fV0TypeForCascadeVertex(source.fV0TypeForCascadeVertex),
 fMassCutBeforeVertexing(source.fMassCutBeforeVertexing),
+fMassCutAtPrimVtx2Prong(source.fMassCutAtPrimVtx2Prong),
 fMassCalc2(source.fMassCalc2),
 fMassCalc3(source.fMassCalc3),
 fMassCalc4(source.fMassCalc4),
@@ -248,6 +254,10 @@ fOKInvMassD0to4p(source.fOKInvMassD0to4p),
 fOKInvMassLctoV0(source.fOKInvMassLctoV0),
 fnTrksTotal(0),
 fnSeleTrksTotal(0),
+fnPairsRejBeforeVtx(0),
+fnTripletsRejBeforeVtx(0),
+fnQuadrupletsRejBeforeVtx(0),
+fnDCAsAvoided(0),
 fMakeReducedRHF(kFALSE),
 fMassDzero(source.fMassDzero),
 fMassDplus(source.fMassDplus),
@@ -329,6 +339,7 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fFindVertexForCascades = source.fFindVertexForCascades;
   fV0TypeForCascadeVertex = source.fV0TypeForCascadeVertex;
   fMassCutBeforeVertexing = source.fMassCutBeforeVertexing;
+  fMassCutAtPrimVtx2Prong = source.fMassCutAtPrimVtx2Prong;
   fMassCalc2 = source.fMassCalc2;
   fMassCalc3 = source.fMassCalc3;
   fMassCalc4 = source.fMassCalc4;
@@ -621,6 +632,23 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // charge and momentum at primary vertex of the selected tracks, stored once
+  // in flat arrays for the combinatorial loops (PID flags are in seleFlags)
+  Short_t  *seleCharge = new Short_t[nSeleTrks+1];
+  Double_t *seleMomAtPV = new Double_t[3*nSeleTrks+3];
+  for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++) {
+    const AliExternalTrackParam *trkAtVtx = (const AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrk);
+    seleCharge[iTrk] = trkAtVtx->Charge();
+    trkAtVtx->GetPxPyPz(&seleMomAtPV[3*iTrk]);
+  }
+  // track-to-track DCAs with the current positive track postrack1 (-1 if not
+  // yet calculated): dcaP1ToTrk[i]=postrack1->GetDCA(track i) and
+  // dcaTrkToP1[i]=track i->GetDCA(postrack1), reused in the loops on the
+  // negative tracks instead of recalculating them for each pair. Only the row
+  // of postrack1 is kept, the full pair matrix would be too large in Pb-Pb
+  Double_t *dcaP1ToTrk = new Double_t[nSeleTrks+1];
+  Double_t *dcaTrkToP1 = new Double_t[nSeleTrks+1];
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -652,6 +680,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
     // get track from tracks array
     postrack1 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkP1);
     postrack1->GetPxPyPz(mompos1);
+    for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++) {
+      dcaP1ToTrk[iTrk]=-1.;
+      dcaTrkToP1[iTrk]=-1.;
+    }
 
     // Make cascades with V0+track
     //
@@ -842,11 +874,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
       if(iTrkN1==iTrkP1) continue;
 
+      if(seleCharge[iTrkN1]>0 && !fLikeSign) continue;
+
       // get track from tracks array
       negtrack1 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkN1);
 
-      if(negtrack1->Charge()>0 && !fLikeSign) continue;
-
       if(!TESTBIT(seleFlags[iTrkN1],kBitDispl)) continue;
 
       if(fMixEvent) {
@@ -873,6 +905,23 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
       negtrack1->GetPxPyPz(momneg1);
 
+      // if the pair is used only for 2 prongs, check the invariant mass with
+      // the momenta at primary vertex before the DCA and the vertexing.
+      // Off by default: the mass at the primary vertex is not the one at the
+      // secondary vertex used in Make2Prong, so candidates can be lost
+      if(fMassCutAtPrimVtx2Prong &&
+	 ((!f3Prong && !f4Prong) || (isLikeSign2Prong && !f3Prong))) {
+	Double_t pxDau[2]={seleMomAtPV[3*iTrkP1],  seleMomAtPV[3*iTrkN1]};
+	Double_t pyDau[2]={seleMomAtPV[3*iTrkP1+1],seleMomAtPV[3*iTrkN1+1]};
+	Double_t pzDau[2]={seleMomAtPV[3*iTrkP1+2],seleMomAtPV[3*iTrkN1+2]};
+	if(!SelectInvMassAndPt2prong(pxDau,pyDau,pzDau)) {
+	  fnPairsRejBeforeVtx++;
+	  fnDCAsAvoided++;
+	  negtrack1=0;
+	  continue;
+	}
+      }
+
       // DCA between the two tracks
       dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
       if(dcap1n1>dcaMax) { negtrack1=0; continue; }
@@ -1063,11 +1112,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//if(iTrkP2%1==0) AliDebug(1,Form("    2nd loop on pos: track number %d of %d",iTrkP2,nSeleTrks));
 
+	if(seleCharge[iTrkP2]<0) continue;
+
 	// get track from tracks array
 	postrack2 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkP2);
 
-	if(postrack2->Charge()<0) continue;
-
 	if(!TESTBIT(seleFlags[iTrkP2],kBitDispl)) continue;
 
 	// Check single tracks cuts specific for 3 prongs
@@ -1138,9 +1187,28 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
+	// if the triplet is not needed for 4 prongs, check the invariant mass
+	// already before the track-to-track DCAs
+	if(f3Prong && fMassCutBeforeVertexing && !f4Prong) {
+	  Double_t pxDau[3]={mompos1[0],momneg1[0],seleMomAtPV[3*iTrkP2]};
+	  Double_t pyDau[3]={mompos1[1],momneg1[1],seleMomAtPV[3*iTrkP2+1]};
+	  Double_t pzDau[3]={mompos1[2],momneg1[2],seleMomAtPV[3*iTrkP2+2]};
+	  if(!SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus)) {
+	    fnTripletsRejBeforeVtx++;
+	    fnDCAsAvoided+=2;
+	    postrack2=0;
+	    continue;
+	  }
+	}
+
 	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
 	if(dcap2n1>dcaMax) { postrack2=0; continue; }
-	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+	if(dcaTrkToP1[iTrkP2]<0.) {
+	  dcaTrkToP1[iTrkP2] = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+	} else {
+	  fnDCAsAvoided++;
+	}
+	dcap1p2 = dcaTrkToP1[iTrkP2];
 	if(dcap1p2>dcaMax) { postrack2=0; continue; }
 
 	// check invariant mass cuts for D+,Ds,Lc
@@ -1166,6 +1234,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	}
 
 	if(f3Prong && !massCutOK) {
+	  fnTripletsRejBeforeVtx++;
 	  threeTrackArray->Clear();
 	  if(!f4Prong) {
 	    postrack2=0;
@@ -1178,9 +1247,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	twoTrackArray2->AddAt(negtrack1,1);
 
 	// 3 prong candidates
+	AliAODVertex* secVert3PrAOD = 0x0;
 	if(f3Prong && massCutOK) {
 	  
-	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
+	  secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
 	  io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,twoTrackArray2,dcap1n1,dcap2n1,dcap1p2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
 	  if(ok3Prong) {
             AliAODVertex *v3Prong=0x0;
@@ -1220,7 +1290,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	  }
 	  if(io3Prong) {delete io3Prong; io3Prong=NULL;}
-	  if(secVert3PrAOD) {delete secVert3PrAOD; secVert3PrAOD=NULL;}
 	}
 
 	// 4 prong candidates
@@ -1238,11 +1307,13 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  SetParametersAtVertex(negtrack1,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN1));
 	  SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 
-	  // Vertexing for these 3 (can be taken from above?)
+	  // Vertexing for these 3: the 3 prong vertex, if already fitted,
+	  // was obtained from the same tracks at primary vertex
           threeTrackArray->AddAt(postrack1,0);
           threeTrackArray->AddAt(negtrack1,1);
 	  threeTrackArray->AddAt(postrack2,2);
-          AliAODVertex* vertexp1n1p2 = ReconstructSecondaryVertex(threeTrackArray,dispersion);
+          AliAODVertex* vertexp1n1p2 = secVert3PrAOD;
+	  if(!vertexp1n1p2) vertexp1n1p2 = ReconstructSecondaryVertex(threeTrackArray,dispersion);
 
 	  // 3rd LOOP  ON  NEGATIVE  TRACKS (for 4 prong)
 	  for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
@@ -1251,11 +1322,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	    //if(iTrkN2%1==0) AliDebug(1,Form("    3rd loop on neg: track number %d of %d",iTrkN2,nSeleTrks));
 
+	    if(seleCharge[iTrkN2]>0) continue;
+
 	    // get track from tracks array
 	    negtrack2 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkN2);
 
-	    if(negtrack2->Charge()>0) continue;
-
 	    if(!TESTBIT(seleFlags[iTrkN2],kBitDispl)) continue;
 	    if(fMixEvent){
 	      if(evtNumber[iTrkP1]==evtNumber[iTrkN2] ||
@@ -1276,7 +1347,12 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
-	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	    if(dcaP1ToTrk[iTrkN2]<0.) {
+	      dcaP1ToTrk[iTrkN2] = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	    } else {
+	      fnDCAsAvoided++;
+	    }
+	    dcap1n2 = dcaP1ToTrk[iTrkN2];
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
             dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
             if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
@@ -1293,6 +1369,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	      massCutOK = SelectInvMassAndPt4prong(fourTrackArray);
 
 	    if(!massCutOK) {
+	      fnQuadrupletsRejBeforeVtx++;
 	      fourTrackArray->Clear();
 	      negtrack2=0;
 	      continue;
@@ -1322,9 +1399,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  } // end loop on negative tracks
 
           threeTrackArray->Clear();
-	  delete vertexp1n1p2;
+	  if(vertexp1n1p2!=secVert3PrAOD) delete vertexp1n1p2;
 
 	}
+	if(secVert3PrAOD) {delete secVert3PrAOD; secVert3PrAOD=NULL;}
 
 	postrack2 = 0;
 
@@ -1339,11 +1417,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//if(iTrkN2%1==0) AliDebug(1,Form("    2nd loop on neg: track number %d of %d",iTrkN2,nSeleTrks));
 
+	if(seleCharge[iTrkN2]>0) continue;
+
 	// get track from tracks array
 	negtrack2 = (AliESDtrack*)seleTrksArray.UncheckedAt(iTrkN2);
 
-	if(negtrack2->Charge()>0) continue;
-
 	if(!TESTBIT(seleFlags[iTrkN2],kBitDispl)) continue;
 
 	// Check single tracks cuts specific for 3 prongs
@@ -1409,16 +1487,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
-	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
-	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
-
-	threeTrackArray->AddAt(negtrack1,0);
-	threeTrackArray->AddAt(postrack1,1);
-	threeTrackArray->AddAt(negtrack2,2);
-
-	// check invariant mass cuts for D+,Ds,Lc
+	// check invariant mass cuts for D+,Ds,Lc (before the track-to-track DCAs)
         massCutOK=kTRUE;
 	if(fMassCutBeforeVertexing && f3Prong){
 	  negtrack2->GetPxPyPz(momneg2);
@@ -1429,11 +1498,26 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
 	}
 	if(!massCutOK) {
-	  threeTrackArray->Clear();
+	  fnTripletsRejBeforeVtx++;
+	  fnDCAsAvoided+=2;
 	  negtrack2=0;
 	  continue;
 	}
 
+	if(dcaP1ToTrk[iTrkN2]<0.) {
+	  dcaP1ToTrk[iTrkN2] = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	} else {
+	  fnDCAsAvoided++;
+	}
+	dcap1n2 = dcaP1ToTrk[iTrkN2];
+	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
+	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
+
+	threeTrackArray->AddAt(negtrack1,0);
+	threeTrackArray->AddAt(postrack1,1);
+	threeTrackArray->AddAt(negtrack2,2);
+
 	// Vertexing
 	twoTrackArray2->AddAt(postrack1,0);
 	twoTrackArray2->AddAt(negtrack2,1);
@@ -1537,6 +1621,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   threeTrackArray->Delete(); delete threeTrackArray;
   fourTrackArray->Delete();  delete fourTrackArray;
   delete [] seleFlags; seleFlags=NULL;
+  delete [] seleCharge; seleCharge=NULL;
+  delete [] seleMomAtPV; seleMomAtPV=NULL;
+  delete [] dcaP1ToTrk; dcaP1ToTrk=NULL;
+  delete [] dcaTrkToP1; dcaTrkToP1=NULL;
   if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
   tracksAtVertex.Delete();
 
@@ -2314,12 +2402,7 @@ AliAODRecoDecayHF2Prong *AliAnalysisVertexingHF::Make2Prong(
 
   if(!refill){//skip if it is called in refill step because already checked
     // invariant mass cut (try to improve coding here..)
-    Bool_t okMassCut=kFALSE;
-    if(!okMassCut && fD0toKpi)   if(SelectInvMassAndPtD0Kpi(px,py,pz))     okMassCut=kTRUE;
-    if(!okMassCut && fJPSItoEle) if(SelectInvMassAndPtJpsiee(px,py,pz))    okMassCut=kTRUE;
-    if(!okMassCut && fDstar)     if(SelectInvMassAndPtDstarD0pi(px,py,pz)) okMassCut=kTRUE;
-    if(!okMassCut && fCascades)  if(SelectInvMassAndPtCascade(px,py,pz))   okMassCut=kTRUE;
-    if(!okMassCut) {
+    if(!SelectInvMassAndPt2prong(px,py,pz)) {
       //AliDebug(2," candidate didn't pass mass cut");
       return 0x0;
     }
@@ -2946,6 +3029,22 @@ void AliAnalysisVertexingHF::PrintStatus() const {
   return;
 }
 //-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::PrintPreFilterStatistics() const {
+  /// Print the number of combinations rejected by the invariant mass
+  /// cut applied with the momenta at primary vertex before vertexing
+
+  printf("Tracks: total %d, selected %d\n",fnTrksTotal,fnSeleTrksTotal);
+  printf("Track-to-track DCA calculations avoided: %lld\n",fnDCAsAvoided);
+  if(!fMassCutBeforeVertexing && !fMassCutAtPrimVtx2Prong) {
+    printf("Mass cut before vertexing is off\n");
+    return;
+  }
+  printf("Rejected before vertexing: %d pairs, %d triplets, %d quadruplets\n",
+	 fnPairsRejBeforeVtx,fnTripletsRejBeforeVtx,fnQuadrupletsRejBeforeVtx);
+
+  return;
+}
+//-----------------------------------------------------------------------------
 AliAODVertex* AliAnalysisVertexingHF::ReconstructSecondaryVertex(TObjArray *trkArray,
 								 Double_t &dispersion,Bool_t useTRefArray) const
 {
@@ -3063,6 +3162,19 @@ Bool_t AliAnalysisVertexingHF::SelectInvMassAndPtDstarD0pi(TObjArray *trkArray){
   return retval;
 }
 //-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::SelectInvMassAndPt2prong(Double_t *px,
+							Double_t *py,
+							Double_t *pz){
+  /// Check invariant mass cuts and pt candidate cut for the 2 prong
+  /// decays that are switched on (D0->Kpi, J/psi->ee, D0 from D*, cascades)
+
+  if(fD0toKpi   && SelectInvMassAndPtD0Kpi(px,py,pz))     return kTRUE;
+  if(fJPSItoEle && SelectInvMassAndPtJpsiee(px,py,pz))    return kTRUE;
+  if(fDstar     && SelectInvMassAndPtDstarD0pi(px,py,pz)) return kTRUE;
+  if(fCascades  && SelectInvMassAndPtCascade(px,py,pz))   return kTRUE;
+  return kFALSE;
+}
+//-----------------------------------------------------------------------------
 Bool_t AliAnalysisVertexingHF::SelectInvMassAndPtD0Kpi(Double_t *px,
 						       Double_t *py,
 						       Double_t *pz){
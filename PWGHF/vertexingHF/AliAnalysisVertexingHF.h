@@ -73,6 +73,7 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t FillRecoCasc(AliVEvent *event,AliAODRecoCascadeHF *rc,Bool_t isDStar,Bool_t recoSecVtx=kFALSE);
   Bool_t RecoSecondaryVertexForCascades(AliVEvent *event, AliAODRecoCascadeHF *rc);
   void PrintStatus() const;
+  void PrintPreFilterStatistics() const;
   void SetSecVtxWithKF() { fSecVtxWithKF=kTRUE; }
   void SetD0toKpiOn() { fD0toKpi=kTRUE; }
   void SetD0toKpiOff() { fD0toKpi=kFALSE; }
@@ -179,6 +180,13 @@ class AliAnalysisVertexingHF : public TNamed {
   void SetCutsDStartoKpipi(AliRDHFCutsDStartoKpipi* cuts) { fCutsDStartoKpipi = cuts; }
   AliRDHFCutsDStartoKpipi* GetCutsDStartoKpipi() const { return fCutsDStartoKpipi; }
   void SetMassCutBeforeVertexing(Bool_t flag) { fMassCutBeforeVertexing=flag; }
+  Bool_t GetMassCutBeforeVertexing() const { return fMassCutBeforeVertexing; }
+  void SetMassCutAtPrimVtx2Prong(Bool_t flag) { fMassCutAtPrimVtx2Prong=flag; }
+  Bool_t GetMassCutAtPrimVtx2Prong() const { return fMassCutAtPrimVtx2Prong; }
+  Int_t GetNPairsRejBeforeVertexing() const { return fnPairsRejBeforeVtx; }
+  Int_t GetNTripletsRejBeforeVertexing() const { return fnTripletsRejBeforeVtx; }
+  Int_t GetNQuadrupletsRejBeforeVertexing() const { return fnQuadrupletsRejBeforeVtx; }
+  Long64_t GetNDCAsAvoided() const { return fnDCAsAvoided; }
 
   void SetMasses();
   Bool_t CheckCutsConsistency();
@@ -327,6 +335,7 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t fFindVertexForCascades;  /// reconstruct a secondary vertex or assume it's from the primary vertex
   Int_t  fV0TypeForCascadeVertex;  /// Select which V0 type we want to use for the cascas
   Bool_t fMassCutBeforeVertexing; /// to go faster in PbPb
+  Bool_t fMassCutAtPrimVtx2Prong; /// 2 prong mass cut with the momenta at primary vertex before the vertexing (can lose candidates)
   // dummies for invariant mass calculation
   AliAODRecoDecay *fMassCalc2; /// for 2 prong
   AliAODRecoDecay *fMassCalc3; /// for 3 prong
@@ -343,6 +352,10 @@ class AliAnalysisVertexingHF : public TNamed {
 
   Int_t  fnTrksTotal;
   Int_t  fnSeleTrksTotal;
+  Int_t  fnPairsRejBeforeVtx; /// pairs rejected by the mass cut before vertexing (2 prong fits avoided)
+  Int_t  fnTripletsRejBeforeVtx; /// triplets rejected by the mass cut before vertexing (3 prong fits avoided)
+  Int_t  fnQuadrupletsRejBeforeVtx; /// quadruplets rejected by the mass cut before vertexing (4 prong fits avoided)
+  Long64_t fnDCAsAvoided; /// track-to-track DCA calculations avoided by the mass cut before vertexing and by reusing the DCAs with the outer positive track
   Bool_t fMakeReducedRHF;// switch the reduction of dAOD size on/off
 
   Double_t fMassDzero;
@@ -404,6 +417,7 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t SelectInvMassAndPtJpsiee(Double_t *px,Double_t *py,Double_t *pz);
   Bool_t SelectInvMassAndPtDstarD0pi(Double_t *px,Double_t *py,Double_t *pz);
   Bool_t SelectInvMassAndPtCascade(Double_t *px,Double_t *py,Double_t *pz);
+  Bool_t SelectInvMassAndPt2prong(Double_t *px,Double_t *py,Double_t *pz);
 
   Bool_t SelectInvMassAndPt3prong(TObjArray *trkArray);
   Bool_t SelectInvMassAndPt4prong(TObjArray *trkArray);
@@ -424,7 +438,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,28);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,29);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
@@ -0,0 +1,314 @@
+/**************************************************************************
+ * Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/////////////////////////////////////////////////////////////
+// \class AliHFFlatBDTReader
+// \brief BDT inference from TMVA XML weight files
+//
+// The forest is stored in flat per-node arrays. Leaf nodes point
+// to themselves, so each tree is evaluated with a fixed number
+// of steps (its depth) and no data dependent branches.
+// The response follows TMVA::MethodBDT: weighted average of the
+// leaf values for AdaBoost (and the other non-gradient boostings),
+// 2/(1+exp(-2*sum))-1 of the leaf responses for Grad.
+/////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <TXMLEngine.h>
+
+#include "AliHFFlatBDTReader.h"
+
+//________________________________________________________________
+AliHFFlatBDTReader::AliHFFlatBDTReader() :
+  IClassifierReader(),
+  fFileName(""),
+  fNVars(0),
+  fBoostType(kAdaBoost),
+  fUseYesNoLeaf(true),
+  fSumBoostWeights(0.),
+  fCutVar(),
+  fCutValue(),
+  fCutType(),
+  fChildren(),
+  fLeafValue(),
+  fTreeRoot(),
+  fTreeDepth()
+{
+  /// Default constructor, no forest loaded
+  fStatusIsClean = false;
+}
+
+//________________________________________________________________
+AliHFFlatBDTReader::AliHFFlatBDTReader(const char* xmlFileName, const std::vector<std::string>& inputVars) :
+  IClassifierReader(),
+  fFileName(""),
+  fNVars(0),
+  fBoostType(kAdaBoost),
+  fUseYesNoLeaf(true),
+  fSumBoostWeights(0.),
+  fCutVar(),
+  fCutValue(),
+  fCutType(),
+  fChildren(),
+  fLeafValue(),
+  fTreeRoot(),
+  fTreeDepth()
+{
+  /// Constructor loading the forest from a TMVA weight file.
+  /// If inputVars is not empty, it is checked against the training variables
+  fStatusIsClean = LoadWeightsFile(xmlFileName,inputVars);
+}
+
+//________________________________________________________________
+bool AliHFFlatBDTReader::LoadWeightsFile(const char* xmlFileName, const std::vector<std::string>& inputVars)
+{
+  /// Read the BDT forest from a TMVA weight file (*.weights.xml)
+
+  fStatusIsClean = false;
+  fFileName = xmlFileName ? xmlFileName : "";
+  fNVars = 0;
+  fBoostType = kAdaBoost;
+  fUseYesNoLeaf = true;
+  fSumBoostWeights = 0.;
+  fCutVar.clear();
+  fCutValue.clear();
+  fCutType.clear();
+  fChildren.clear();
+  fLeafValue.clear();
+  fTreeRoot.clear();
+  fTreeDepth.clear();
+
+  TXMLEngine xml;
+  XMLDocPointer_t doc = xml.ParseFile(fFileName.c_str());
+  if (!doc) {
+    std::cerr << "AliHFFlatBDTReader: cannot parse weight file " << fFileName << std::endl;
+    return false;
+  }
+  XMLNodePointer_t mainNode = xml.DocGetRootElement(doc);
+  const char* method = xml.GetAttr(mainNode,"Method");
+  if (!method || strncmp(method,"BDT::",5)) {
+    std::cerr << "AliHFFlatBDTReader: " << fFileName << " is not a TMVA BDT weight file" << std::endl;
+    xml.FreeDoc(doc);
+    return false;
+  }
+
+  bool ok = true;
+  std::vector<std::string> varNames, varLabels;
+  for (XMLNodePointer_t section = xml.GetChild(mainNode); section && ok; section = xml.GetNext(section)) {
+    const char* sectionName = xml.GetNodeName(section);
+    if (!strcmp(sectionName,"Options")) {
+      for (XMLNodePointer_t opt = xml.GetChild(section); opt; opt = xml.GetNext(opt)) {
+        const char* optName = xml.GetAttr(opt,"name");
+        const char* optValue = xml.GetNodeContent(opt);
+        if (!optName || !optValue) continue;
+        if (!strcmp(optName,"BoostType")) fBoostType = strcmp(optValue,"Grad") ? kAdaBoost : kGrad;
+        else if (!strcmp(optName,"UseYesNoLeaf")) fUseYesNoLeaf = !strcmp(optValue,"True");
+        else if (!strcmp(optName,"VarTransform") && strcmp(optValue,"None")) {
+          std::cerr << "AliHFFlatBDTReader: variable transformation " << optValue << " not supported" << std::endl;
+          ok = false;
+        }
+      }
+    } else if (!strcmp(sectionName,"Variables")) {
+      for (XMLNodePointer_t var = xml.GetChild(section); var; var = xml.GetNext(var)) {
+        const char* expr = xml.GetAttr(var,"Expression");
+        const char* label = xml.GetAttr(var,"Label");
+        varNames.push_back(expr ? expr : "");
+        varLabels.push_back(label ? label : "");
+      }
+      fNVars = varNames.size();
+    } else if (!strcmp(sectionName,"Transformations")) {
+      const char* ntrans = xml.GetAttr(section,"NTransformations");
+      if (ntrans && atoi(ntrans) != 0) {
+        std::cerr << "AliHFFlatBDTReader: variable transformations not supported" << std::endl;
+        ok = false;
+      }
+    } else if (!strcmp(sectionName,"Weights")) {
+      for (XMLNodePointer_t tree = xml.GetChild(section); tree && ok; tree = xml.GetNext(tree)) {
+        const char* weight = xml.GetAttr(tree,"boostWeight");
+        XMLNodePointer_t root = xml.GetChild(tree);
+        if (!weight || !root) { ok = false; break; }
+        double boostWeight = atof(weight);
+        int depth = 0;
+        int rootIndex = AddNode(xml,root,boostWeight,0,depth);
+        if (rootIndex < 0) { ok = false; break; }
+        fTreeRoot.push_back(rootIndex);
+        fTreeDepth.push_back(depth);
+        fSumBoostWeights += boostWeight;
+      }
+    }
+  }
+  xml.FreeDoc(doc);
+
+  if (ok && (fNVars == 0 || fTreeRoot.empty())) {
+    std::cerr << "AliHFFlatBDTReader: no variables or no trees found in " << fFileName << std::endl;
+    ok = false;
+  }
+  if (ok && !inputVars.empty()) {
+    if ((int)inputVars.size() != fNVars) {
+      std::cerr << "AliHFFlatBDTReader: mismatch in number of input variables: "
+                << inputVars.size() << " != " << fNVars << std::endl;
+      ok = false;
+    }
+    for (int ivar = 0; ok && ivar < fNVars; ivar++) {
+      if (inputVars[ivar] != varNames[ivar] && inputVars[ivar] != varLabels[ivar]) {
+        std::cerr << "AliHFFlatBDTReader: mismatch in input variable names for variable ["
+                  << ivar << "]: " << inputVars[ivar] << " != " << varNames[ivar] << std::endl;
+        ok = false;
+      }
+    }
+  }
+  fStatusIsClean = ok;
+  return ok;
+}
+
+//________________________________________________________________
+int AliHFFlatBDTReader::AddNode(TXMLEngine& xml, void* node, double boostWeight, int depth, int& maxDepth)
+{
+  /// Append a node and (recursively) its daughters to the flat arrays.
+  /// Returns the index of the node, -1 for unsupported nodes
+
+  const char* ncoef = xml.GetAttr(node,"NCoef");
+  if (ncoef && atoi(ncoef) != 0) {
+    std::cerr << "AliHFFlatBDTReader: Fisher cuts in the nodes not supported" << std::endl;
+    return -1;
+  }
+  const char* nType = xml.GetAttr(node,"nType");
+  const char* ivar = xml.GetAttr(node,"IVar");
+  const char* cut = xml.GetAttr(node,"Cut");
+  const char* cType = xml.GetAttr(node,"cType");
+  if (!nType || !ivar || !cut || !cType) return -1;
+
+  int index = fCutVar.size();
+  fCutVar.push_back(0);
+  fCutValue.push_back(0.);
+  fCutType.push_back(0);
+  fChildren.push_back(index);
+  fChildren.push_back(index);
+  fLeafValue.push_back(0.);
+  if (depth > maxDepth) maxDepth = depth;
+
+  XMLNodePointer_t left = 0, right = 0;
+  for (XMLNodePointer_t daughter = xml.GetChild(node); daughter; daughter = xml.GetNext(daughter)) {
+    const char* pos = xml.GetAttr(daughter,"pos");
+    if (pos && pos[0] == 'l') left = daughter;
+    else if (pos && pos[0] == 'r') right = daughter;
+  }
+
+  int type = atoi(nType);
+  if (type != 0) { // leaf
+    if (fBoostType == kGrad) {
+      const char* res = xml.GetAttr(node,"res");
+      fLeafValue[index] = res ? atof(res) : 0.;
+    } else if (fUseYesNoLeaf) {
+      fLeafValue[index] = boostWeight * type;
+    } else {
+      const char* purity = xml.GetAttr(node,"purity");
+      fLeafValue[index] = boostWeight * (purity ? atof(purity) : 0.);
+    }
+    return index;
+  }
+  if (!left || !right) return -1;
+
+  fCutVar[index] = atoi(ivar);
+  if (fCutVar[index] < 0 || (fNVars > 0 && fCutVar[index] >= fNVars)) return -1;
+  fCutValue[index] = atof(cut);
+  fCutType[index] = atoi(cType) ? 1 : 0;
+  int leftIndex = AddNode(xml,left,boostWeight,depth+1,maxDepth);
+  if (leftIndex < 0) return -1;
+  int rightIndex = AddNode(xml,right,boostWeight,depth+1,maxDepth);
+  if (rightIndex < 0) return -1;
+  fChildren[2*index] = leftIndex;
+  fChildren[2*index+1] = rightIndex;
+  return index;
+}
+
+//________________________________________________________________
+double AliHFFlatBDTReader::Normalise(double sum) const
+{
+  /// Convert the sum of the leaf values into the BDT response
+  if (fBoostType == kGrad) return 2.0/(1.0+std::exp(-2.0*sum))-1.0;
+  return fSumBoostWeights > 0. ? sum/fSumBoostWeights : 0.;
+}
+
+//________________________________________________________________
+double AliHFFlatBDTReader::GetMvaValue(const std::vector<double>& inputValues) const
+{
+  /// Classifier response, input values in the order of the training variables
+  if ((int)inputValues.size() < fNVars) {
+    std::cerr << "AliHFFlatBDTReader: " << inputValues.size() << " input values, " << fNVars << " expected" << std::endl;
+    return 0.;
+  }
+  return GetMvaValue(inputValues.data());
+}
+
+//________________________________________________________________
+double AliHFFlatBDTReader::GetMvaValue(const double* inputValues) const
+{
+  /// Classifier response, input values in the order of the training variables
+  if (!IsStatusClean()) {
+    std::cerr << "AliHFFlatBDTReader: cannot return classifier response because status is dirty" << std::endl;
+    return 0.;
+  }
+  const int* cutVar = fCutVar.data();
+  const double* cutValue = fCutValue.data();
+  const int* cutType = fCutType.data();
+  const int* children = fChildren.data();
+  double sum = 0.;
+  for (size_t iTree = 0; iTree < fTreeRoot.size(); iTree++) {
+    int node = fTreeRoot[iTree];
+    for (int d = fTreeDepth[iTree]; d--;) {
+      const int goRight = (inputValues[cutVar[node]] > cutValue[node]) == cutType[node];
+      node = children[2*node+goRight];
+    }
+    sum += fLeafValue[node];
+  }
+  return Normalise(sum);
+}
+
+//________________________________________________________________
+void AliHFFlatBDTReader::GetMvaValues(int nCand, const double* features, double* scores) const
+{
+  /// Classifier response for nCand candidates. The features are stored
+  /// row-major, GetNVariables() values per candidate. The trees are looped
+  /// in the outer loop, so that each tree is read once for all candidates;
+  /// the scores are identical to the ones of GetMvaValue
+  if (!IsStatusClean()) {
+    std::cerr << "AliHFFlatBDTReader: cannot return classifier response because status is dirty" << std::endl;
+    for (int iCand = 0; iCand < nCand; iCand++) scores[iCand] = 0.;
+    return;
+  }
+  const int* cutVar = fCutVar.data();
+  const double* cutValue = fCutValue.data();
+  const int* cutType = fCutType.data();
+  const int* children = fChildren.data();
+  for (int iCand = 0; iCand < nCand; iCand++) scores[iCand] = 0.;
+  for (size_t iTree = 0; iTree < fTreeRoot.size(); iTree++) {
+    const int root = fTreeRoot[iTree];
+    const int depth = fTreeDepth[iTree];
+    for (int iCand = 0; iCand < nCand; iCand++) {
+      const double* x = features + iCand*fNVars;
+      int node = root;
+      for (int d = depth; d--;) {
+        const int goRight = (x[cutVar[node]] > cutValue[node]) == cutType[node];
+        node = children[2*node+goRight];
+      }
+      scores[iCand] += fLeafValue[node];
+    }
+  }
+  for (int iCand = 0; iCand < nCand; iCand++) scores[iCand] = Normalise(scores[iCand]);
+}
@@ -0,0 +1,65 @@
+#ifndef ALIHFFLATBDTREADER_H
+#define ALIHFFLATBDTREADER_H
+
+/* Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/// \class AliHFFlatBDTReader
+/// \brief BDT inference from TMVA XML weight files with a flat node array
+///
+/// Drop-in replacement for the generated *_TMVAClassification_BDT_*.class.cxx
+/// readers: the forest is read at runtime from the TMVA weight file and stored
+/// in contiguous arrays, trees are traversed without data dependent branches
+/// and several candidates can be scored in one call.
+/// Supports AdaBoost (yes/no or purity leaves) and Grad boosting without
+/// variable transformations.
+
+#include <string>
+#include <vector>
+#include "IClassifierReader.h"
+
+class TXMLEngine;
+
+class AliHFFlatBDTReader : public IClassifierReader {
+
+ public:
+
+  AliHFFlatBDTReader();
+  AliHFFlatBDTReader(const char* xmlFileName, const std::vector<std::string>& inputVars=std::vector<std::string>());
+  virtual ~AliHFFlatBDTReader() {}
+
+  bool LoadWeightsFile(const char* xmlFileName, const std::vector<std::string>& inputVars=std::vector<std::string>());
+
+  virtual double GetMvaValue(const std::vector<double>& inputValues) const;
+  double GetMvaValue(const double* inputValues) const;
+  /// scores of nCand candidates, features stored row-major (nCand x GetNVariables())
+  void GetMvaValues(int nCand, const double* features, double* scores) const;
+
+  int GetNVariables() const { return fNVars; }
+  int GetNTrees() const { return (int)fTreeRoot.size(); }
+  int GetNNodes() const { return (int)fCutVar.size(); }
+
+ private:
+
+  enum EBoostType {kAdaBoost=0, kGrad=1};
+
+  int AddNode(TXMLEngine& xml, void* node, double boostWeight, int depth, int& maxDepth);
+  double Normalise(double sum) const;
+
+  std::string fFileName;            /// TMVA weight file
+  int fNVars;                       /// number of input variables
+  int fBoostType;                   /// AdaBoost or Grad
+  bool fUseYesNoLeaf;               /// AdaBoost leaves return +-1 instead of the purity
+  double fSumBoostWeights;          /// normalisation of the AdaBoost response
+  // forest, one entry per node (leaves point to themselves)
+  std::vector<int> fCutVar;         /// index of the variable used in the node
+  std::vector<double> fCutValue;    /// cut value of the node
+  std::vector<int> fCutType;        /// 1: go right if value > cut, 0: go right otherwise
+  std::vector<int> fChildren;       /// indices of the left (2*i) and right (2*i+1) daughters
+  std::vector<double> fLeafValue;   /// weighted response of leaf nodes
+  // one entry per tree
+  std::vector<int> fTreeRoot;       /// index of the root node
+  std::vector<int> fTreeDepth;      /// depth of the tree
+};
+
+#endif
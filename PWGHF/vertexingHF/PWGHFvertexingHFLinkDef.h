@@ -123,6 +123,7 @@
 #pragma link C++ class AliAnalysisTaskSEHFSystPID+;
 #pragma link C++ class AliAnalysisTaskSEDmesonPIDSysProp+;
 #pragma link C++ class IClassifierReader+;
+#pragma link C++ class AliHFFlatBDTReader+;
 #pragma link C++ class AliAnalysisTaskSELbtoLcpi4+;
 #pragma link C++ class AliAnalysisTaskSEXicTopKpi+;
 #pragma link C++ class AliRDHFCutsXictopKpi+;
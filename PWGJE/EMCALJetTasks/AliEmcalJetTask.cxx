@@ -25,8 +25,11 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
  **************************************************************************************/
 #include <vector>
+#include <algorithm>
 
 #include <TClonesArray.h>
+#include <TH1F.h>
+#include <TStopwatch.h>
 #include <TMath.h>
 #include <TRandom3.h>
 #include <TGrid.h>
@@ -43,6 +46,7 @@
 
 #include "AliTLorentzVector.h"
 #include "AliEmcalJet.h"
+#include "AliEmcalList.h"
 #include "AliEmcalParticle.h"
 #include "AliFJWrapper.h"
 #include "AliEmcalJetUtility.h"
@@ -62,6 +66,7 @@ ClassImp(AliEmcalJetTask);
 /// \endcond
 
 const Int_t AliEmcalJetTask::fgkConstIndexShift = 100000;
+std::vector<AliEmcalJetTask*> AliEmcalJetTask::fgClusteringCache;
 
 /**
  * Default constructor. This constructor is only for ROOT I/O and
@@ -97,8 +102,14 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fEnableAliBasicParticleCompatibility(kFALSE),
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
+  fUseClusteringCache(kFALSE),
   fJets(0),
   fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
+  fClusteringSource(nullptr),
+  fHasClustering(kFALSE),
+  fClusteringTime(0.),
+  fHistClusteringCache(nullptr),
+  fHistClusteringTimeSaved(nullptr),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
 {
@@ -138,8 +149,14 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fEnableAliBasicParticleCompatibility(kFALSE),
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
+  fUseClusteringCache(kFALSE),
   fJets(0),
   fFastJetWrapper(name,name),
+  fClusteringSource(nullptr),
+  fHasClustering(kFALSE),
+  fClusteringTime(0.),
+  fHistClusteringCache(nullptr),
+  fHistClusteringTimeSaved(nullptr),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
 {
@@ -150,6 +167,54 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  std::vector<AliEmcalJetTask*>::iterator cached = std::find(fgClusteringCache.begin(), fgClusteringCache.end(), this);
+  if (cached != fgClusteringCache.end()) fgClusteringCache.erase(cached);
+}
+
+/**
+ * Create the QA histograms of the clustering cache, if the output
+ * was connected via ConnectClusteringCacheQA().
+ */
+void AliEmcalJetTask::UserCreateOutputObjects()
+{
+  AliAnalysisTaskEmcal::UserCreateOutputObjects();
+
+  if (!fOutput) return;
+
+  fHistClusteringCache = new TH1F("fHistClusteringCache", "fHistClusteringCache", 2, 0, 2);
+  fHistClusteringCache->GetXaxis()->SetBinLabel(1, "Clustered");
+  fHistClusteringCache->GetXaxis()->SetBinLabel(2, "Reused");
+  fHistClusteringCache->GetYaxis()->SetTitle("counts");
+  fOutput->Add(fHistClusteringCache);
+
+  fHistClusteringTimeSaved = new TH1F("fHistClusteringTimeSaved", "fHistClusteringTimeSaved", 200, 0, 200);
+  fHistClusteringTimeSaved->GetXaxis()->SetTitle("CPU time of the reused clustering (ms)");
+  fHistClusteringTimeSaved->GetYaxis()->SetTitle("counts");
+  fOutput->Add(fHistClusteringTimeSaved);
+
+  PostData(1, fOutput);
+}
+
+/**
+ * Define and connect an output slot for the QA histograms of the clustering cache.
+ * Must be called after the task was added to the analysis manager.
+ * @param outputfile Name of the output file (default: common output file)
+ */
+void AliEmcalJetTask::ConnectClusteringCacheQA(const char *outputfile)
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr) {
+    AliError("No analysis manager found.");
+    return;
+  }
+
+  fCreateHisto = kTRUE;
+  DefineOutput(1, AliEmcalList::Class());
+  TString filename(outputfile);
+  if (filename.IsNull()) filename = mgr->GetCommonFileName();
+  AliAnalysisDataContainer *coutput = mgr->CreateContainer(Form("%s_histos", GetName()), AliEmcalList::Class(),
+      AliAnalysisManager::kOutputContainer, filename.Data());
+  mgr->ConnectOutput(this, 1, coutput);
 }
 
 /**
@@ -257,6 +322,8 @@ Int_t AliEmcalJetTask::FindJets()
   }
 
   fFastJetWrapper.Clear();
+  fClusteringSource = nullptr;
+  fHasClustering = kFALSE;
 
   AliDebug(2,Form("Jet type = %d", fJetType));
 
@@ -320,12 +387,65 @@ Int_t AliEmcalJetTask::FindJets()
 
   if (fFastJetWrapper.GetInputVectors().size() == 0) return 0;
 
+  // reuse the clustering of another jet finder if possible
+  if (fUseClusteringCache) {
+    fClusteringSource = FindCachedClustering();
+    if (fClusteringSource) {
+      AliDebug(2,Form("Reusing clustering of jet finder %s", fClusteringSource->GetName()));
+      if (fHistClusteringCache) {
+        fHistClusteringCache->Fill("Reused", 1);
+        fHistClusteringTimeSaved->Fill(fClusteringSource->fClusteringTime);
+      }
+      return fClusteringSource->fFastJetWrapper.GetInclusiveJets().size();
+    }
+  }
+
   // run jet finder
-  fFastJetWrapper.Run();
+  TStopwatch timer;
+  fHasClustering = fFastJetWrapper.Run() >= 0;
+  timer.Stop();
+  fClusteringTime = timer.CpuTime() * 1000.;
+  if (fHistClusteringCache) fHistClusteringCache->Fill("Clustered", 1);
 
   return fFastJetWrapper.GetInclusiveJets().size();
 }
 
+/**
+ * Look for a jet finder which clustered the same input as this task with the
+ * same jet definition in the current event. The input vectors are compared
+ * one by one (momentum and user index), so that the clustering is only shared
+ * between jet finders using the same containers and the same cuts.
+ * @return Jet finder whose clustering can be reused (nullptr if none)
+ */
+AliEmcalJetTask* AliEmcalJetTask::FindCachedClustering() const
+{
+  // Utilities act on the wrapper, therefore only jet finders without utilities share their clustering
+  if (fUtilities && fUtilities->GetEntriesFast()) return nullptr;
+
+  const std::vector<fastjet::PseudoJet> &inputs = fFastJetWrapper.GetInputVectors();
+  for (std::vector<AliEmcalJetTask*>::const_iterator cached = fgClusteringCache.begin(); cached != fgClusteringCache.end(); ++cached) {
+    const AliEmcalJetTask *other = *cached;
+    if (other == this || !other->fHasClustering) continue;
+    if (other->fUtilities && other->fUtilities->GetEntriesFast()) continue;
+    if (other->fJetAlgo != fJetAlgo || other->fRecombScheme != fRecombScheme || other->fLegacyMode != fLegacyMode ||
+        TMath::Abs(other->fRadius - fRadius) > DBL_EPSILON || TMath::Abs(other->fGhostArea - fGhostArea) > DBL_EPSILON) continue;
+
+    const std::vector<fastjet::PseudoJet> &otherinputs = other->fFastJetWrapper.GetInputVectors();
+    if (otherinputs.size() != inputs.size()) continue;
+    Bool_t same = kTRUE;
+    for (UInt_t i = 0; i < inputs.size(); i++) {
+      if (inputs[i].user_index() != otherinputs[i].user_index() ||
+          inputs[i].px() != otherinputs[i].px() || inputs[i].py() != otherinputs[i].py() ||
+          inputs[i].pz() != otherinputs[i].pz() || inputs[i].E() != otherinputs[i].E()) {
+        same = kFALSE;
+        break;
+      }
+    }
+    if (same) return const_cast<AliEmcalJetTask*>(other);
+  }
+  return nullptr;
+}
+
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
@@ -335,8 +455,11 @@ void AliEmcalJetTask::FillJetBranch()
 {
   PrepareUtilities();
 
+  // the clustering can be owned by another jet finder (see SetUseClusteringCache)
+  AliFJWrapper &wrapper = fClusteringSource ? fClusteringSource->fFastJetWrapper : fFastJetWrapper;
+
   // loop over fastjet jets
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
+  std::vector<fastjet::PseudoJet> jets_incl = wrapper.GetInclusiveJets();
   // sort jets according to jet pt
   static Int_t indexes[9999] = {-1};
   GetSortedArray(indexes, jets_incl);
@@ -344,10 +467,10 @@ void AliEmcalJetTask::FillJetBranch()
   AliDebug(1,Form("%d jets found", (Int_t)jets_incl.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
     Int_t ij = indexes[ijet];
-    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fFastJetWrapper.GetJetArea(ij)));
+    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), wrapper.GetJetArea(ij)));
 
     if (jets_incl[ij].perp() < fMinJetPt) continue;
-    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
+    if (wrapper.GetJetArea(ij) < fMinJetArea) continue;
     if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
         (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
       continue;
@@ -356,7 +479,7 @@ void AliEmcalJetTask::FillJetBranch()
     		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
     jet->SetLabel(ij);
 
-    fastjet::PseudoJet area(fFastJetWrapper.GetJetAreaVector(ij));
+    fastjet::PseudoJet area(wrapper.GetJetAreaVector(ij));
     jet->SetArea(area.perp());
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
@@ -364,7 +487,7 @@ void AliEmcalJetTask::FillJetBranch()
     jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
 
     // Fill constituent info
-    std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
+    std::vector<fastjet::PseudoJet> constituents(wrapper.GetJetConstituents(ij));
     FillJetConstituents(jet, constituents, constituents);
 
     if (fGeom) {
@@ -474,6 +597,10 @@ void AliEmcalJetTask::ExecOnce()
 
   InitUtilities();
 
+  if (fUseClusteringCache && std::find(fgClusteringCache.begin(), fgClusteringCache.end(), this) == fgClusteringCache.end()) {
+    fgClusteringCache.push_back(this);
+  }
+
   AliAnalysisTaskEmcal::ExecOnce();
 
   // Setup container utils. Must be called after AliAnalysisTaskEmcal::ExecOnce() so that the
@@ -29,6 +29,7 @@
 
 class TClonesArray;
 class TObjArray;
+class TH1;
 class AliVEvent;
 class AliEmcalJetUtility;
 
@@ -158,6 +159,34 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
    */
   void                   SetFillJetConsituents(Bool_t doFill) { fFillConstituents = doFill; }
 
+  /**
+   * @brief Share the jet finding with other jet finder tasks
+   *
+   * Jet finders with the clustering cache enabled and without utilities share their clustering:
+   * if another jet finder already clustered exactly the same input vectors (momenta and constituent
+   * indices) with the same jet definition (algorithm, radius, recombination scheme, ghost area) in
+   * the current event, its clustering is reused instead of running FastJet again. This is typically
+   * the case for several kT jet finders providing jets for different rho estimators.
+   *
+   * Note that ghosts are not regenerated for a reused clustering, therefore jet areas are identical
+   * to the ones of the jet finder which performed the clustering.
+   *
+   * @param b Switch for the clustering cache
+   */
+  void                   SetUseClusteringCache(Bool_t b = kTRUE) { fUseClusteringCache = b; }
+
+  /**
+   * @brief Create an output container with QA histograms of the clustering cache
+   *
+   * The histograms contain the number of events with own and reused clustering,
+   * and the CPU time of the clusterings which were reused.
+   *
+   * @param outputfile Name of the output file (default: common output file of the analysis manager)
+   */
+  void                   ConnectClusteringCacheQA(const char *outputfile = "");
+
+  void                   UserCreateOutputObjects();
+
   static AliEmcalJetTask* AddTaskEmcalJet(
       const TString nTracks                      = "usedefault",
       const TString nClusters                    = "usedefault",
@@ -195,6 +224,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 IsJetInDcal(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInDcalOnly(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInPhos(Double_t eta, Double_t phi, Double_t r);
+  AliEmcalJetTask*       FindCachedClustering() const;
 
   TString                fJetsTag;                ///< tag of jet collection (usually = "Jets")
 
@@ -227,11 +257,18 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 fEnableAliBasicParticleCompatibility; ///< Flag to allow compatibility with AliBasicParticle constituents
   Bool_t                 fLegacyMode;             //!<!=true to enable FJ 2.x behavior
   Bool_t                 fFillGhost;              ///< =true ghost particles will be filled in AliEmcalJet obj
+  Bool_t                 fUseClusteringCache;     ///< =true to reuse the clustering of other jet finders with identical input and jet definition
 
   TClonesArray          *fJets;                   //!<!jet collection
   AliFJWrapper           fFastJetWrapper;         //!<!fastjet wrapper
+  AliEmcalJetTask       *fClusteringSource;       //!<!jet finder whose clustering is used in the current event (null if clustered by this task)
+  Bool_t                 fHasClustering;          //!<!=true if the fastjet wrapper holds the clustering of the current input
+  Double_t               fClusteringTime;         //!<!CPU time of the last clustering (ms)
+  TH1                   *fHistClusteringCache;    //!<!number of events with own and reused clustering
+  TH1                   *fHistClusteringTimeSaved; //!<!CPU time of the reused clusterings
 
   static const Int_t     fgkConstIndexShift;      //!<!contituent index shift
+  static std::vector<AliEmcalJetTask*> fgClusteringCache; //!<!jet finders sharing their clustering
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   // Handle mapping between index and containers
@@ -244,7 +281,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 30);
+  ClassDef(AliEmcalJetTask, 31);
   /// \endcond
 };
 #endif
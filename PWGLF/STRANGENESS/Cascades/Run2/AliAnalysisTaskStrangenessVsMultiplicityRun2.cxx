@@ -63,6 +63,7 @@ class AliESDv0;
 class AliAODv0;
 
 #include <Riostream.h>
+#include <algorithm>
 #include "TList.h"
 #include "TH1.h"
 #include "TH2.h"
@@ -122,6 +123,30 @@ using std::endl;
 
 ClassImp(AliAnalysisTaskStrangenessVsMultiplicityRun2)
 
+namespace {
+    //p[0]*exp(p[1]*pt) + p[2]*exp(p[3]*pt) + p[4]: parametrization of the pt-dependent cuts
+    Double_t ExpParametrization(const Float_t *p, Float_t pt){
+        return p[0]*TMath::Exp(p[1]*pt) + p[2]*TMath::Exp(p[3]*pt) + p[4];
+    }
+    //Superlight mode: order of the configurations, the cuts compared here are shared within a group
+    Bool_t V0GroupLess(const AliV0Result *a, const AliV0Result *b){
+        if( a->GetMassHypothesis() != b->GetMassHypothesis() ) return a->GetMassHypothesis() < b->GetMassHypothesis();
+        if( a->GetUseOnTheFly() != b->GetUseOnTheFly() ) return a->GetUseOnTheFly() < b->GetUseOnTheFly();
+        if( a->GetCutMinEtaTracks() != b->GetCutMinEtaTracks() ) return a->GetCutMinEtaTracks() < b->GetCutMinEtaTracks();
+        if( a->GetCutMaxEtaTracks() != b->GetCutMaxEtaTracks() ) return a->GetCutMaxEtaTracks() < b->GetCutMaxEtaTracks();
+        if( a->GetCutMinRapidity() != b->GetCutMinRapidity() ) return a->GetCutMinRapidity() < b->GetCutMinRapidity();
+        return a->GetCutMaxRapidity() < b->GetCutMaxRapidity();
+    }
+    Bool_t CascadeGroupLess(const AliCascadeResult *a, const AliCascadeResult *b){
+        if( a->GetMassHypothesis() != b->GetMassHypothesis() ) return a->GetMassHypothesis() < b->GetMassHypothesis();
+        if( a->GetSwapBachelorCharge() != b->GetSwapBachelorCharge() ) return a->GetSwapBachelorCharge() < b->GetSwapBachelorCharge();
+        if( a->GetCutMinEtaTracks() != b->GetCutMinEtaTracks() ) return a->GetCutMinEtaTracks() < b->GetCutMinEtaTracks();
+        if( a->GetCutMaxEtaTracks() != b->GetCutMaxEtaTracks() ) return a->GetCutMaxEtaTracks() < b->GetCutMaxEtaTracks();
+        if( a->GetCutMinRapidity() != b->GetCutMinRapidity() ) return a->GetCutMinRapidity() < b->GetCutMinRapidity();
+        return a->GetCutMaxRapidity() < b->GetCutMaxRapidity();
+    }
+}
+
 AliAnalysisTaskStrangenessVsMultiplicityRun2::AliAnalysisTaskStrangenessVsMultiplicityRun2()
 : AliAnalysisTaskSE(), fListHist(0), fListK0Short(0), fListLambda(0), fListAntiLambda(0),
 fListXiMinus(0), fListXiPlus(0), fListOmegaMinus(0), fListOmegaPlus(0),
@@ -173,6 +198,7 @@ fkSandboxMode ( kFALSE ),
 //---> Fill tree with specific config
 fkSaveSpecificConfig(kFALSE),
 fkConfigToSave(""),
+fkUseColumnarSelection(kTRUE),
 
 //---> Variables for fTreeEvent
 fCentrality(0),
@@ -471,7 +497,15 @@ fTreeCascVarMagneticField(0),
 
 //Histos
 fHistEventCounter(0),
-fHistCentrality(0)
+fHistCentrality(0),
+//Superlight mode: candidate buffers
+fV0Candidates(),
+fCascadeCandidates(),
+fV0Selections(),
+fV0SelectionGroups(),
+fCascadeSelections(),
+fCascadeSelectionGroups(),
+fGroupCandidates()
 //------------------------------------------------
 // Tree Variables
 {
@@ -529,6 +563,7 @@ fkSandboxMode ( kFALSE ),
 //---> Fill tree with specific config
 fkSaveSpecificConfig(kFALSE),
 fkConfigToSave(""),
+fkUseColumnarSelection(kTRUE),
 
 //---> Variables for fTreeEvent
 fCentrality(0),
@@ -826,7 +861,15 @@ fTreeCascVarMagneticField(0),
 //Histos
 fHistEventCounter(0),
 fHistEventCounterDifferential(0),
-fHistCentrality(0)
+fHistCentrality(0),
+//Superlight mode: candidate buffers
+fV0Candidates(),
+fCascadeCandidates(),
+fV0Selections(),
+fV0SelectionGroups(),
+fCascadeSelections(),
+fCascadeSelectionGroups(),
+fGroupCandidates()
 {
     
     //Re-vertex: Will only apply for cascade candidates
@@ -1442,6 +1485,9 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserCreateOutputObjects()
     
     AliWarning( Form("Initialized %i cascade output objects!", lTotalCfgs));
     
+    //Superlight mode: group configurations sharing cuts
+    BuildSelectionGroups();
+    
     //Regular Output: Slots 1-8
     PostData(1, fListHist    );
     PostData(2, fListK0Short    );
@@ -1803,6 +1849,7 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
     Int_t nv0s = 0;
     nv0s = lESDevent->GetNumberOfV0s();
     
+    fV0Candidates.Clear();
     for (Int_t iV0 = 0; iV0 < nv0s; iV0++) //extra-crazy test
     {   // This is the begining of the V0 loop
         AliESDv0 *v0 = ((AliESDEvent*)lESDevent)->GetV0(iV0);
@@ -2142,6 +2189,12 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Fill V0 tree over.
         //------------------------------------------------
         
+        if( fkUseColumnarSelection ){
+            //Superlight mode: buffer the candidate, configurations are evaluated after the V0 loop
+            AddV0Candidate( lOnFlyStatus, lThisPosInnerPt, lThisNegInnerPt, lLeastNcrOverLength, lITSorTOFsatisfied );
+            continue;
+        }
+        
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -2326,6 +2379,8 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         
     }// This is the end of the V0 loop
     
+    if( fkUseColumnarSelection ) SelectV0Candidates();
+    
     //------------------------------------------------
     // Rerun cascade vertexer!
     //------------------------------------------------
@@ -2361,6 +2416,7 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
     
     Bool_t lValidXiMinus, lValidXiPlus, lValidOmegaMinus, lValidOmegaPlus;
     
+    fCascadeCandidates.Clear();
     for (Int_t iXi = 0; iXi < ncascades; iXi++) {
         
         //------------------------------------------------
@@ -3196,6 +3252,18 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         // Fill tree over.
         //------------------------------------------------
         
+        if( fkUseColumnarSelection && !fkSaveSpecificConfig ){
+            //Superlight mode: buffer the candidate, configurations are evaluated after the cascade loop
+            //(saving a specific configuration to the TTree needs the per-candidate loop below)
+            UChar_t lValidHypotheses = 0;
+            if( lValidXiMinus    ) lValidHypotheses |= 1<<AliCascadeResult::kXiMinus;
+            if( lValidXiPlus     ) lValidHypotheses |= 1<<AliCascadeResult::kXiPlus;
+            if( lValidOmegaMinus ) lValidHypotheses |= 1<<AliCascadeResult::kOmegaMinus;
+            if( lValidOmegaPlus  ) lValidHypotheses |= 1<<AliCascadeResult::kOmegaPlus;
+            AddCascadeCandidate( lValidHypotheses, lV0Pt, lV0TotMomentum, lLeastNcrOverLength, lLeastNbrCrossedRows, lITSorTOFsatisfied );
+            continue;
+        }
+        
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
         // Superlight adaptive output mode
         //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -3583,6 +3651,8 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         
     }// end of the Cascade loop (ESD or AOD)
     
+    if( fkUseColumnarSelection && !fkSaveSpecificConfig ) SelectCascadeCandidates();
+    
     // Post output data.
     //Regular Output: Slots 1-8
     PostData(1, fListHist    );
@@ -3637,6 +3707,577 @@ Double_t AliAnalysisTaskStrangenessVsMultiplicityRun2::MyRapidity(Double_t rE, D
     return ReturnValue;
 }
 
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::V0Candidates::Clear()
+{
+    fPt.clear(); fNegEta.clear(); fPosEta.clear();
+    fInvMassK0s.clear(); fInvMassLambda.clear(); fInvMassAntiLambda.clear(); fRapK0Short.clear(); fRapLambda.clear();
+    fV0Radius.clear(); fDcaNegToPV.clear(); fDcaPosToPV.clear(); fDcaV0Daughters.clear(); fV0CosPA.clear(); fDistOverTotMom.clear();
+    fLeastNbrCrossedRows.clear(); fLeastRatioCrossedRowsOverFindable.clear(); fLeastNcrOverLength.clear();
+    fNegNSigmaPion.clear(); fNegNSigmaProton.clear(); fPosNSigmaPion.clear(); fPosNSigmaProton.clear();
+    fNegInnerP.clear(); fPosInnerP.clear(); fNegInnerPt.clear(); fPosInnerPt.clear();
+    fPtArmV0.clear(); fAlphaV0.clear(); fMaxChi2PerCluster.clear(); fMinTrackLength.clear();
+    fLengthPtTerm.clear(); fLengthRadiusTerm.clear();
+    fFlags.clear();
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::CascadeCandidates::Clear()
+{
+    fCharge.clear();
+    fPt.clear(); fNegEta.clear(); fPosEta.clear(); fBachEta.clear();
+    fMassAsXi.clear(); fMassAsOmega.clear(); fV0MassLambda.clear(); fV0MassAntiLambda.clear(); fRapXi.clear(); fRapOmega.clear();
+    fDCANegToPV.clear(); fDCAPosToPV.clear(); fDCAV0Daughters.clear(); fV0CosPA.clear(); fV0Radius.clear(); fDCAV0ToPV.clear();
+    fDCABachToPV.clear(); fDCACascDaughters.clear(); fCascCosPA.clear(); fCascRadius.clear(); fExpV0Mass.clear(); fExpV0Sigma.clear();
+    fDistOverTotMom.clear(); fLeastNbrClusters.clear(); fDCABachToBaryon.clear(); fWrongCosPA.clear(); fV0Lifetime.clear();
+    fMaxChi2PerCluster.clear(); fMinTrackLength.clear(); f276TeVV0CosPA.clear(); fLeastNcrOverLength.clear(); fLeastNbrCrossedRows.clear();
+    fNegNSigmaPion.clear(); fNegNSigmaProton.clear(); fPosNSigmaPion.clear(); fPosNSigmaProton.clear(); fBachNSigmaPion.clear(); fBachNSigmaKaon.clear();
+    fNegTOFNSigmaPion.clear(); fNegTOFNSigmaProton.clear(); fPosTOFNSigmaPion.clear(); fPosTOFNSigmaProton.clear(); fBachTOFNSigmaPion.clear(); fBachTOFNSigmaKaon.clear();
+    fLengthPtTerm.clear(); fLengthRadiusTerm.clear(); fDCACascadeToPV.clear();
+    fFlags.clear();
+    fValidHypotheses.clear();
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::BuildSelectionGroups()
+{
+    //Superlight mode: sort the configurations such that the ones sharing hypothesis and
+    //acceptance cuts are consecutive and store where each group starts
+    fV0Selections.clear();
+    TList *lV0Lists[3] = {fListK0Short, fListLambda, fListAntiLambda};
+    for(Int_t ilist=0; ilist<3; ilist++){
+        for(Int_t icfg=0; icfg<lV0Lists[ilist]->GetEntries(); icfg++)
+            fV0Selections.push_back( (AliV0Result*) lV0Lists[ilist]->At(icfg) );
+    }
+    std::stable_sort(fV0Selections.begin(), fV0Selections.end(), V0GroupLess);
+    fV0SelectionGroups.clear();
+    for(UInt_t icfg=0; icfg<fV0Selections.size(); icfg++){
+        if( icfg==0 || V0GroupLess(fV0Selections[icfg-1], fV0Selections[icfg]) ) fV0SelectionGroups.push_back(icfg);
+    }
+    fV0SelectionGroups.push_back(fV0Selections.size());
+    
+    fCascadeSelections.clear();
+    TList *lCascadeLists[4] = {fListXiMinus, fListXiPlus, fListOmegaMinus, fListOmegaPlus};
+    for(Int_t ilist=0; ilist<4; ilist++){
+        for(Int_t icfg=0; icfg<lCascadeLists[ilist]->GetEntries(); icfg++)
+            fCascadeSelections.push_back( (AliCascadeResult*) lCascadeLists[ilist]->At(icfg) );
+    }
+    std::stable_sort(fCascadeSelections.begin(), fCascadeSelections.end(), CascadeGroupLess);
+    fCascadeSelectionGroups.clear();
+    for(UInt_t icfg=0; icfg<fCascadeSelections.size(); icfg++){
+        if( icfg==0 || CascadeGroupLess(fCascadeSelections[icfg-1], fCascadeSelections[icfg]) ) fCascadeSelectionGroups.push_back(icfg);
+    }
+    fCascadeSelectionGroups.push_back(fCascadeSelections.size());
+    
+    AliInfo( Form("Superlight mode: %i V0 configurations in %i groups, %i cascade configurations in %i groups",
+                  (Int_t)fV0Selections.size(), (Int_t)fV0SelectionGroups.size()-1,
+                  (Int_t)fCascadeSelections.size(), (Int_t)fCascadeSelectionGroups.size()-1) );
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::AddV0Candidate( Int_t lOnFlyStatus, Float_t lPosInnerPt, Float_t lNegInnerPt, Float_t lLeastNcrOverLength, Bool_t lITSorTOFsatisfied )
+{
+    //Superlight mode: append the current V0 (fTreeVariable*) to the candidate buffer
+    V0Candidates &c = fV0Candidates;
+    c.fPt.push_back( fTreeVariablePt );
+    c.fNegEta.push_back( fTreeVariableNegEta );
+    c.fPosEta.push_back( fTreeVariablePosEta );
+    c.fInvMassK0s.push_back( fTreeVariableInvMassK0s );
+    c.fInvMassLambda.push_back( fTreeVariableInvMassLambda );
+    c.fInvMassAntiLambda.push_back( fTreeVariableInvMassAntiLambda );
+    c.fRapK0Short.push_back( fTreeVariableRapK0Short );
+    c.fRapLambda.push_back( fTreeVariableRapLambda );
+    c.fV0Radius.push_back( fTreeVariableV0Radius );
+    c.fDcaNegToPV.push_back( fTreeVariableDcaNegToPrimVertex );
+    c.fDcaPosToPV.push_back( fTreeVariableDcaPosToPrimVertex );
+    c.fDcaV0Daughters.push_back( fTreeVariableDcaV0Daughters );
+    c.fV0CosPA.push_back( fTreeVariableV0CosineOfPointingAngle );
+    c.fDistOverTotMom.push_back( fTreeVariableDistOverTotMom );
+    c.fLeastNbrCrossedRows.push_back( fTreeVariableLeastNbrCrossedRows );
+    c.fLeastRatioCrossedRowsOverFindable.push_back( fTreeVariableLeastRatioCrossedRowsOverFindable );
+    c.fLeastNcrOverLength.push_back( lLeastNcrOverLength );
+    c.fNegNSigmaPion.push_back( fTreeVariableNSigmasNegPion );
+    c.fNegNSigmaProton.push_back( fTreeVariableNSigmasNegProton );
+    c.fPosNSigmaPion.push_back( fTreeVariableNSigmasPosPion );
+    c.fPosNSigmaProton.push_back( fTreeVariableNSigmasPosProton );
+    c.fNegInnerP.push_back( fTreeVariableNegInnerP );
+    c.fPosInnerP.push_back( fTreeVariablePosInnerP );
+    c.fNegInnerPt.push_back( lNegInnerPt );
+    c.fPosInnerPt.push_back( lPosInnerPt );
+    c.fPtArmV0.push_back( fTreeVariablePtArmV0 );
+    c.fAlphaV0.push_back( fTreeVariableAlphaV0 );
+    c.fMaxChi2PerCluster.push_back( fTreeVariableMaxChi2PerCluster );
+    c.fMinTrackLength.push_back( fTreeVariableMinTrackLength );
+    c.fLengthPtTerm.push_back( TMath::Power(1/(fTreeVariablePt+1e-6),1.5) ); //rough parametrization, tune me!
+    c.fLengthRadiusTerm.push_back( TMath::Max(fTreeVariableV0Radius-85., 0.) ); //rough parametrization, tune me!
+    
+    UChar_t lFlags = 0;
+    if( lOnFlyStatus ) lFlags |= V0Candidates::kOnFly;
+    if( (fTreeVariableNegTrackStatus & AliESDtrack::kITSrefit) &&
+        (fTreeVariablePosTrackStatus & AliESDtrack::kITSrefit) ) lFlags |= V0Candidates::kITSRefit;
+    if( TMath::Abs(fTreeVariableNegTOFSignal) < 100 ||
+        TMath::Abs(fTreeVariablePosTOFSignal) < 100 ) lFlags |= V0Candidates::kAtLeastOneTOF;
+    if( fTreeVariableIsCowboy ) lFlags |= V0Candidates::kCowboy;
+    if( lITSorTOFsatisfied ) lFlags |= V0Candidates::kITSorTOF;
+    c.fFlags.push_back( lFlags );
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::SelectV0Candidates()
+{
+    //Superlight mode: evaluate all V0 configurations over the buffered candidates
+    //Same selections as the per-candidate loop in UserExec, checks are numbered alike
+    const V0Candidates &c = fV0Candidates;
+    const Long_t lNCandidates = c.fPt.size();
+    if( lNCandidates == 0 ) return;
+    
+    for(UInt_t igr=0; igr+1<fV0SelectionGroups.size(); igr++){
+        const AliV0Result *lFirst = fV0Selections[fV0SelectionGroups[igr]];
+        const Int_t lHypo = lFirst->GetMassHypothesis();
+        const Bool_t lIsK0Short = ( lHypo == AliV0Result::kK0Short );
+        const Bool_t lIsAntiLambda = ( lHypo == AliV0Result::kAntiLambda );
+        
+        //hypothesis dependent columns
+        const std::vector<Float_t> &lMass = lIsK0Short ? c.fInvMassK0s : (lIsAntiLambda ? c.fInvMassAntiLambda : c.fInvMassLambda);
+        const std::vector<Float_t> &lRap = lIsK0Short ? c.fRapK0Short : c.fRapLambda;
+        const std::vector<Float_t> &lNegdEdx = lIsAntiLambda ? c.fNegNSigmaProton : c.fNegNSigmaPion;
+        const std::vector<Float_t> &lPosdEdx = (lIsK0Short || lIsAntiLambda) ? c.fPosNSigmaPion : c.fPosNSigmaProton;
+        const std::vector<Float_t> &lBaryonMomentum = lIsAntiLambda ? c.fNegInnerP : c.fPosInnerP;
+        const std::vector<Float_t> &lBaryonPt = lIsAntiLambda ? c.fNegInnerPt : c.fPosInnerPt;
+        const std::vector<Float_t> &lBaryondEdxFromProton = lIsAntiLambda ? c.fNegNSigmaProton : c.fPosNSigmaProton;
+        const Float_t lPDGMass = lIsK0Short ? 0.497 : 1.115683;
+        
+        //Check 1 and 2: shared by all configurations of the group
+        const Bool_t lOnFly = lFirst->GetUseOnTheFly();
+        const Double_t lMinEta = lFirst->GetCutMinEtaTracks(), lMaxEta = lFirst->GetCutMaxEtaTracks();
+        const Double_t lMinRap = lFirst->GetCutMinRapidity(), lMaxRap = lFirst->GetCutMaxRapidity();
+        fGroupCandidates.clear();
+        for(Long_t i=0; i<lNCandidates; i++){
+            if( ((c.fFlags[i] & V0Candidates::kOnFly) != 0) != lOnFly ) continue;
+            if( !(lMinEta < c.fNegEta[i] && c.fNegEta[i] < lMaxEta) ) continue;
+            if( !(lMinEta < c.fPosEta[i] && c.fPosEta[i] < lMaxEta) ) continue;
+            if( !(lRap[i] > lMinRap && lRap[i] < lMaxRap) ) continue;
+            fGroupCandidates.push_back(i);
+        }
+        if( fGroupCandidates.empty() ) continue;
+        
+        for(Int_t lcfg=fV0SelectionGroups[igr]; lcfg<fV0SelectionGroups[igr+1]; lcfg++){
+            AliV0Result *lV0Result = fV0Selections[lcfg];
+            TH3F *histoout = lV0Result->GetHistogram();
+            
+            //Cut values, read once per configuration
+            const Double_t lV0RadiusCut = lV0Result->GetCutV0Radius();
+            const Double_t lMaxV0RadiusCut = lV0Result->GetCutMaxV0Radius();
+            const Double_t lDCANegToPVCut = lV0Result->GetCutDCANegToPV();
+            const Double_t lDCAPosToPVCut = lV0Result->GetCutDCAPosToPV();
+            const Double_t lDCAV0DaughtersCut = lV0Result->GetCutDCAV0Daughters();
+            const Float_t lV0CosPACutConst = lV0Result->GetCutV0CosPA();
+            const Bool_t lUseVarV0CosPA = lV0Result->GetCutUseVarV0CosPA();
+            Float_t lVarV0CosPApar[5];
+            lVarV0CosPApar[0] = lV0Result->GetCutVarV0CosPAExp0Const();
+            lVarV0CosPApar[1] = lV0Result->GetCutVarV0CosPAExp0Slope();
+            lVarV0CosPApar[2] = lV0Result->GetCutVarV0CosPAExp1Const();
+            lVarV0CosPApar[3] = lV0Result->GetCutVarV0CosPAExp1Slope();
+            lVarV0CosPApar[4] = lV0Result->GetCutVarV0CosPAConst();
+            const Double_t lProperLifetimeCut = lV0Result->GetCutProperLifetime();
+            const Double_t lLeastNbrCrossedRowsCut = lV0Result->GetCutLeastNumberOfCrossedRows();
+            const Double_t lLeastRatioCrossedRowsCut = lV0Result->GetCutLeastNumberOfCrossedRowsOverFindable();
+            const Double_t lMinBaryonMomentumCut = lV0Result->GetCutMinBaryonMomentum();
+            const Double_t lTPCdEdxCut = lV0Result->GetCutTPCdEdx();
+            const Bool_t lUseArmenteros = lV0Result->GetCutArmenteros() && lIsK0Short;
+            const Double_t lArmenterosParameter = lV0Result->GetCutArmenterosParameter();
+            const Bool_t lUseITSRefitTracks = lV0Result->GetCutUseITSRefitTracks();
+            const Double_t lMaxChi2PerClusterCut = lV0Result->GetCutMaxChi2PerCluster();
+            const Double_t lMinTrackLengthCut = lV0Result->GetCutMinTrackLength();
+            const Bool_t lUseParametricLength = lV0Result->GetCutUseParametricLength();
+            const Bool_t lUse276TeVLikedEdx = lV0Result->GetCut276TeVLikedEdx() && !lIsK0Short;
+            const Bool_t lAtLeastOneTOF = lV0Result->GetCutAtLeastOneTOF();
+            const Int_t lIsCowboy = lV0Result->GetCutIsCowboy();
+            const Double_t lMinCrossedRowsOverLengthCut = lV0Result->GetCutMinCrossedRowsOverLength();
+            const Bool_t lITSorTOF = lV0Result->GetCutITSorTOF();
+            
+            for(UInt_t icand=0; icand<fGroupCandidates.size(); icand++){
+                const Int_t i = fGroupCandidates[icand];
+                const UChar_t lFlags = c.fFlags[i];
+                
+                //Check 3: Topological Variables
+                if( !(c.fV0Radius[i] > lV0RadiusCut && c.fV0Radius[i] < lMaxV0RadiusCut) ) continue;
+                if( !(c.fDcaNegToPV[i] > lDCANegToPVCut && c.fDcaPosToPV[i] > lDCAPosToPVCut) ) continue;
+                if( !(c.fDcaV0Daughters[i] < lDCAV0DaughtersCut) ) continue;
+                Float_t lV0CosPACut = lV0CosPACutConst;
+                if( lUseVarV0CosPA ){
+                    //Only use if tighter than the non-variable cut
+                    Float_t lVarV0CosPA = TMath::Cos( ExpParametrization(lVarV0CosPApar, c.fPt[i]) );
+                    if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
+                }
+                if( !(c.fV0CosPA[i] > lV0CosPACut) ) continue;
+                if( !(c.fDistOverTotMom[i]*lPDGMass < lProperLifetimeCut) ) continue;
+                if( !(c.fLeastNbrCrossedRows[i] > lLeastNbrCrossedRowsCut) ) continue;
+                if( !(c.fLeastRatioCrossedRowsOverFindable[i] > lLeastRatioCrossedRowsCut) ) continue;
+                
+                //Check 4: Minimum momentum of baryon daughter
+                if( !lIsK0Short && !(lBaryonMomentum[i] > lMinBaryonMomentumCut) ) continue;
+                
+                //Check 5: TPC dEdx selections
+                if( !(TMath::Abs(lNegdEdx[i])<lTPCdEdxCut && TMath::Abs(lPosdEdx[i])<lTPCdEdxCut) ) continue;
+                
+                //Check 6: Armenteros-Podolanski space cut (for K0Short analysis)
+                if( lUseArmenteros && !(c.fPtArmV0[i]>lArmenterosParameter*TMath::Abs(c.fAlphaV0[i])) ) continue;
+                
+                //Check 7: kITSrefit track selection if requested
+                if( lUseITSRefitTracks && !(lFlags & V0Candidates::kITSRefit) ) continue;
+                
+                //Check 8: Max Chi2/Clusters if not absurd
+                if( !(lMaxChi2PerClusterCut>1e+3 || c.fMaxChi2PerCluster[i] < lMaxChi2PerClusterCut) ) continue;
+                
+                //Check 9: Min Track Length if positive
+                if( !( lMinTrackLengthCut<0 ||
+                      (c.fMinTrackLength[i] > lMinTrackLengthCut && !lUseParametricLength) ||
+                      (c.fMinTrackLength[i] > lMinTrackLengthCut - c.fLengthPtTerm[i] - c.fLengthRadiusTerm[i] && lUseParametricLength) ) ) continue;
+                
+                //Check 10: Special 2.76TeV-like dedx
+                if( lUse276TeVLikedEdx && !(lBaryonPt[i] > 1.0 || TMath::Abs(lBaryondEdxFromProton[i])<3.0) ) continue;
+                
+                //Check 14: has at least one track with some TOF info
+                if( lAtLeastOneTOF && !(lFlags & V0Candidates::kAtLeastOneTOF) ) continue;
+                
+                //Check 15: cowboy/sailor for V0
+                const Bool_t lCowboy = (lFlags & V0Candidates::kCowboy) != 0;
+                if( lIsCowboy != 0 && !( (lIsCowboy==1 && lCowboy) || (lIsCowboy==-1 && !lCowboy) ) ) continue;
+                
+                //Check 16: modern track quality selections
+                if( !(lMinCrossedRowsOverLengthCut<0 || c.fLeastNcrOverLength[i]>lMinCrossedRowsOverLengthCut) ) continue;
+                
+                //Check 17: ITS or TOF required
+                if( lITSorTOF && !(lFlags & V0Candidates::kITSorTOF) ) continue;
+                
+                //This satisfies all my conditionals! Fill histogram
+                histoout -> Fill ( fCentrality, c.fPt[i], lMass[i] );
+            }
+        }
+    }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::AddCascadeCandidate( UChar_t lValidHypotheses, Float_t lV0Pt, Float_t lV0TotMomentum, Float_t lLeastNcrOverLength, Int_t lLeastNbrCrossedRows, Bool_t lITSorTOFsatisfied )
+{
+    //Superlight mode: append the current cascade (fTreeCascVar*) to the candidate buffer
+    CascadeCandidates &c = fCascadeCandidates;
+    c.fCharge.push_back( fTreeCascVarCharge );
+    c.fPt.push_back( fTreeCascVarPt );
+    c.fNegEta.push_back( fTreeCascVarNegEta );
+    c.fPosEta.push_back( fTreeCascVarPosEta );
+    c.fBachEta.push_back( fTreeCascVarBachEta );
+    c.fMassAsXi.push_back( fTreeCascVarMassAsXi );
+    c.fMassAsOmega.push_back( fTreeCascVarMassAsOmega );
+    c.fV0MassLambda.push_back( fTreeCascVarV0MassLambda );
+    c.fV0MassAntiLambda.push_back( fTreeCascVarV0MassAntiLambda );
+    c.fRapXi.push_back( fTreeCascVarRapXi );
+    c.fRapOmega.push_back( fTreeCascVarRapOmega );
+    c.fDCANegToPV.push_back( fTreeCascVarDCANegToPrimVtx );
+    c.fDCAPosToPV.push_back( fTreeCascVarDCAPosToPrimVtx );
+    c.fDCAV0Daughters.push_back( fTreeCascVarDCAV0Daughters );
+    c.fV0CosPA.push_back( fTreeCascVarV0CosPointingAngle );
+    c.fV0Radius.push_back( fTreeCascVarV0Radius );
+    c.fDCAV0ToPV.push_back( fTreeCascVarDCAV0ToPrimVtx );
+    c.fDCABachToPV.push_back( fTreeCascVarDCABachToPrimVtx );
+    c.fDCACascDaughters.push_back( fTreeCascVarDCACascDaughters );
+    c.fCascCosPA.push_back( fTreeCascVarCascCosPointingAngle );
+    c.fCascRadius.push_back( fTreeCascVarCascRadius );
+    
+    //For parametric V0 Mass selection
+    Float_t lExpV0Mass =
+    fLambdaMassMean[0]+
+    fLambdaMassMean[1]*TMath::Exp(fLambdaMassMean[2]*lV0Pt)+
+    fLambdaMassMean[3]*TMath::Exp(fLambdaMassMean[4]*lV0Pt);
+    Float_t lExpV0Sigma =
+    fLambdaMassSigma[0]+fLambdaMassSigma[1]*lV0Pt+
+    fLambdaMassSigma[2]*TMath::Exp(fLambdaMassSigma[3]*lV0Pt);
+    c.fExpV0Mass.push_back( lExpV0Mass );
+    c.fExpV0Sigma.push_back( lExpV0Sigma );
+    
+    //For 2.76TeV-like parametric V0 CosPA
+    Float_t l276TeVV0CosPA = 0.998;
+    Float_t pThr=1.5;
+    if (lV0TotMomentum<pThr) {
+        //Below the threshold "pThr", try a momentum dependent cos(PA) cut
+        const Double_t bend=0.03; // approximate Xi bending angle
+        const Double_t qt=0.211;  // max Lambda pT in Omega decay
+        const Double_t cpaThr=TMath::Cos(TMath::ATan(qt/pThr) + bend);
+        l276TeVV0CosPA = (0.998/cpaThr)*TMath::Cos(TMath::ATan(qt/lV0TotMomentum) + bend);
+    }
+    c.f276TeVV0CosPA.push_back( l276TeVV0CosPA );
+    
+    c.fDistOverTotMom.push_back( fTreeCascVarDistOverTotMom );
+    c.fLeastNbrClusters.push_back( fTreeCascVarLeastNbrClusters );
+    c.fDCABachToBaryon.push_back( fTreeCascVarDCABachToBaryon );
+    c.fWrongCosPA.push_back( fTreeCascVarWrongCosPA );
+    c.fV0Lifetime.push_back( fTreeCascVarV0Lifetime );
+    c.fMaxChi2PerCluster.push_back( fTreeCascVarMaxChi2PerCluster );
+    c.fMinTrackLength.push_back( fTreeCascVarMinTrackLength );
+    c.fLeastNcrOverLength.push_back( lLeastNcrOverLength );
+    c.fLeastNbrCrossedRows.push_back( lLeastNbrCrossedRows );
+    c.fNegNSigmaPion.push_back( fTreeCascVarNegNSigmaPion );
+    c.fNegNSigmaProton.push_back( fTreeCascVarNegNSigmaProton );
+    c.fPosNSigmaPion.push_back( fTreeCascVarPosNSigmaPion );
+    c.fPosNSigmaProton.push_back( fTreeCascVarPosNSigmaProton );
+    c.fBachNSigmaPion.push_back( fTreeCascVarBachNSigmaPion );
+    c.fBachNSigmaKaon.push_back( fTreeCascVarBachNSigmaKaon );
+    c.fNegTOFNSigmaPion.push_back( fTreeCascVarNegTOFNSigmaPion );
+    c.fNegTOFNSigmaProton.push_back( fTreeCascVarNegTOFNSigmaProton );
+    c.fPosTOFNSigmaPion.push_back( fTreeCascVarPosTOFNSigmaPion );
+    c.fPosTOFNSigmaProton.push_back( fTreeCascVarPosTOFNSigmaProton );
+    c.fBachTOFNSigmaPion.push_back( fTreeCascVarBachTOFNSigmaPion );
+    c.fBachTOFNSigmaKaon.push_back( fTreeCascVarBachTOFNSigmaKaon );
+    c.fLengthPtTerm.push_back( TMath::Power(1/(fTreeCascVarPt+1e-6),1.5) ); //rough parametrization, tune me!
+    c.fLengthRadiusTerm.push_back( TMath::Max(fTreeCascVarV0Radius-85., 0.) ); //rough parametrization, tune me!
+    c.fDCACascadeToPV.push_back( TMath::Sqrt(fTreeCascVarCascDCAtoPVz*fTreeCascVarCascDCAtoPVz + fTreeCascVarCascDCAtoPVxy*fTreeCascVarCascDCAtoPVxy) );
+    
+    UChar_t lFlags = 0;
+    if( fTreeCascVarNegTrackStatus & AliESDtrack::kITSrefit ) lFlags |= CascadeCandidates::kNegITSRefit;
+    if( fTreeCascVarPosTrackStatus & AliESDtrack::kITSrefit ) lFlags |= CascadeCandidates::kPosITSRefit;
+    if( fTreeCascVarBachTrackStatus & AliESDtrack::kITSrefit ) lFlags |= CascadeCandidates::kBachITSRefit;
+    if( TMath::Abs(fTreeCascVarNegTOFSignal) < 100 ||
+        TMath::Abs(fTreeCascVarPosTOFSignal) < 100 ||
+        TMath::Abs(fTreeCascVarBachTOFSignal) < 100 ) lFlags |= CascadeCandidates::kAtLeastOneTOF;
+    if( fTreeCascVarIsCowboy ) lFlags |= CascadeCandidates::kCowboy;
+    if( fTreeCascVarIsCascadeCowboy ) lFlags |= CascadeCandidates::kCascadeCowboy;
+    if( lITSorTOFsatisfied ) lFlags |= CascadeCandidates::kITSorTOF;
+    c.fFlags.push_back( lFlags );
+    c.fValidHypotheses.push_back( lValidHypotheses );
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskStrangenessVsMultiplicityRun2::SelectCascadeCandidates()
+{
+    //Superlight mode: evaluate all cascade configurations over the buffered candidates
+    //Same selections as the per-candidate loop in UserExec, checks are numbered alike
+    const CascadeCandidates &c = fCascadeCandidates;
+    const Long_t lNCandidates = c.fPt.size();
+    if( lNCandidates == 0 ) return;
+    
+    const UChar_t lAllITSRefit = CascadeCandidates::kNegITSRefit | CascadeCandidates::kPosITSRefit | CascadeCandidates::kBachITSRefit;
+    
+    for(UInt_t igr=0; igr+1<fCascadeSelectionGroups.size(); igr++){
+        const AliCascadeResult *lFirst = fCascadeSelections[fCascadeSelectionGroups[igr]];
+        const Int_t lHypo = lFirst->GetMassHypothesis();
+        const Bool_t lIsOmega = ( lHypo == AliCascadeResult::kOmegaMinus || lHypo == AliCascadeResult::kOmegaPlus );
+        const Bool_t lIsPlus  = ( lHypo == AliCascadeResult::kXiPlus || lHypo == AliCascadeResult::kOmegaPlus );
+        
+        //hypothesis dependent columns
+        const std::vector<Float_t> &lMass = lIsOmega ? c.fMassAsOmega : c.fMassAsXi;
+        const std::vector<Float_t> &lV0Mass = lIsPlus ? c.fV0MassAntiLambda : c.fV0MassLambda;
+        const std::vector<Float_t> &lRap = lIsOmega ? c.fRapOmega : c.fRapXi;
+        const std::vector<Float_t> &lNegdEdx = lIsPlus ? c.fNegNSigmaProton : c.fNegNSigmaPion;
+        const std::vector<Float_t> &lPosdEdx = lIsPlus ? c.fPosNSigmaPion : c.fPosNSigmaProton;
+        const std::vector<Float_t> &lBachdEdx = lIsOmega ? c.fBachNSigmaKaon : c.fBachNSigmaPion;
+        const std::vector<Float_t> &lNegTOFsigma = lIsPlus ? c.fNegTOFNSigmaProton : c.fNegTOFNSigmaPion;
+        const std::vector<Float_t> &lPosTOFsigma = lIsPlus ? c.fPosTOFNSigmaPion : c.fPosTOFNSigmaProton;
+        const std::vector<Float_t> &lBachTOFsigma = lIsOmega ? c.fBachTOFNSigmaKaon : c.fBachTOFNSigmaPion;
+        const Float_t lPDGMass = lIsOmega ? 1.67245 : 1.32171;
+        
+        //Check 1 and 2: shared by all configurations of the group
+        Int_t lCharge = lIsPlus ? +1 : -1;
+        if ( lFirst->GetSwapBachelorCharge() ) lCharge *= -1;
+        const Double_t lMinEta = lFirst->GetCutMinEtaTracks(), lMaxEta = lFirst->GetCutMaxEtaTracks();
+        const Double_t lMinRap = lFirst->GetCutMinRapidity(), lMaxRap = lFirst->GetCutMaxRapidity();
+        fGroupCandidates.clear();
+        for(Long_t i=0; i<lNCandidates; i++){
+            if( !(c.fValidHypotheses[i] & (1<<lHypo)) ) continue;
+            if( c.fCharge[i] != lCharge ) continue;
+            if( !(lMinEta < c.fPosEta[i] && c.fPosEta[i] < lMaxEta) ) continue;
+            if( !(lMinEta < c.fNegEta[i] && c.fNegEta[i] < lMaxEta) ) continue;
+            if( !(lMinEta < c.fBachEta[i] && c.fBachEta[i] < lMaxEta) ) continue;
+            if( !(lRap[i] > lMinRap && lRap[i] < lMaxRap) ) continue;
+            fGroupCandidates.push_back(i);
+        }
+        if( fGroupCandidates.empty() ) continue;
+        
+        for(Int_t lcfg=fCascadeSelectionGroups[igr]; lcfg<fCascadeSelectionGroups[igr+1]; lcfg++){
+            AliCascadeResult *lCascadeResult = fCascadeSelections[lcfg];
+            TH3F *histoout = lCascadeResult->GetHistogram();
+            
+            //Cut values, read once per configuration
+            const Float_t lCascCosPACutConst = lCascadeResult->GetCutCascCosPA();
+            const Bool_t lUseVarCascCosPA = lCascadeResult->GetCutUseVarCascCosPA();
+            Float_t lVarCascCosPApar[5];
+            lVarCascCosPApar[0] = lCascadeResult->GetCutVarCascCosPAExp0Const();
+            lVarCascCosPApar[1] = lCascadeResult->GetCutVarCascCosPAExp0Slope();
+            lVarCascCosPApar[2] = lCascadeResult->GetCutVarCascCosPAExp1Const();
+            lVarCascCosPApar[3] = lCascadeResult->GetCutVarCascCosPAExp1Slope();
+            lVarCascCosPApar[4] = lCascadeResult->GetCutVarCascCosPAConst();
+            const Float_t lV0CosPACutConst = lCascadeResult->GetCutV0CosPA();
+            const Bool_t lUseVarV0CosPA = lCascadeResult->GetCutUseVarV0CosPA();
+            Float_t lVarV0CosPApar[5];
+            lVarV0CosPApar[0] = lCascadeResult->GetCutVarV0CosPAExp0Const();
+            lVarV0CosPApar[1] = lCascadeResult->GetCutVarV0CosPAExp0Slope();
+            lVarV0CosPApar[2] = lCascadeResult->GetCutVarV0CosPAExp1Const();
+            lVarV0CosPApar[3] = lCascadeResult->GetCutVarV0CosPAExp1Slope();
+            lVarV0CosPApar[4] = lCascadeResult->GetCutVarV0CosPAConst();
+            const Float_t lBBCosPACutConst = lCascadeResult->GetCutBachBaryonCosPA();
+            const Bool_t lUseVarBBCosPA = lCascadeResult->GetCutUseVarBBCosPA();
+            Float_t lVarBBCosPApar[5];
+            lVarBBCosPApar[0] = lCascadeResult->GetCutVarBBCosPAExp0Const();
+            lVarBBCosPApar[1] = lCascadeResult->GetCutVarBBCosPAExp0Slope();
+            lVarBBCosPApar[2] = lCascadeResult->GetCutVarBBCosPAExp1Const();
+            lVarBBCosPApar[3] = lCascadeResult->GetCutVarBBCosPAExp1Slope();
+            lVarBBCosPApar[4] = lCascadeResult->GetCutVarBBCosPAConst();
+            const Float_t lDCACascDauCutConst = lCascadeResult->GetCutDCACascDaughters();
+            const Bool_t lUseVarDCACascDau = lCascadeResult->GetCutUseVarDCACascDau();
+            Float_t lVarDCACascDaupar[5];
+            lVarDCACascDaupar[0] = lCascadeResult->GetCutVarDCACascDauExp0Const();
+            lVarDCACascDaupar[1] = lCascadeResult->GetCutVarDCACascDauExp0Slope();
+            lVarDCACascDaupar[2] = lCascadeResult->GetCutVarDCACascDauExp1Const();
+            lVarDCACascDaupar[3] = lCascadeResult->GetCutVarDCACascDauExp1Slope();
+            lVarDCACascDaupar[4] = lCascadeResult->GetCutVarDCACascDauConst();
+            
+            const Double_t lDCANegToPVCut = lCascadeResult->GetCutDCANegToPV();
+            const Double_t lDCAPosToPVCut = lCascadeResult->GetCutDCAPosToPV();
+            const Double_t lDCAV0DaughtersCut = lCascadeResult->GetCutDCAV0Daughters();
+            const Double_t lV0RadiusCut = lCascadeResult->GetCutV0Radius();
+            const Double_t lDCAV0ToPVCut = lCascadeResult->GetCutDCAV0ToPV();
+            const Double_t lV0MassCut = lCascadeResult->GetCutV0Mass();
+            const Double_t lDCABachToPVCut = lCascadeResult->GetCutDCABachToPV();
+            const Double_t lCascRadiusCut = lCascadeResult->GetCutCascRadius();
+            const Double_t lV0MassSigmaCut = lCascadeResult->GetCutV0MassSigma();
+            const Double_t lProperLifetimeCut = lCascadeResult->GetCutProperLifetime();
+            const Double_t lLeastNumberOfClustersCut = lCascadeResult->GetCutLeastNumberOfClusters();
+            const Double_t lTPCdEdxCut = lCascadeResult->GetCutTPCdEdx();
+            const Bool_t lUseTOFUnchecked = lCascadeResult->GetCutUseTOFUnchecked();
+            const Double_t lXiRejectionCut = lCascadeResult->GetCutXiRejection();
+            const Double_t lDCABachToBaryonCut = lCascadeResult->GetCutDCABachToBaryon();
+            const Double_t lMinV0LifetimeCut = lCascadeResult->GetCutMinV0Lifetime();
+            const Double_t lMaxV0LifetimeCut = lCascadeResult->GetCutMaxV0Lifetime();
+            const Bool_t lUseITSRefitTracks = lCascadeResult->GetCutUseITSRefitTracks();
+            const Double_t lMaxChi2PerClusterCut = lCascadeResult->GetCutMaxChi2PerCluster();
+            const Double_t lMinTrackLengthCut = lCascadeResult->GetCutMinTrackLength();
+            const Bool_t lUseParametricLength = lCascadeResult->GetCutUseParametricLength();
+            const Bool_t lUse276TeVV0CosPA = lCascadeResult->GetCutUse276TeVV0CosPA();
+            const Double_t lDCACascadeToPVCut = lCascadeResult->GetCutDCACascadeToPV();
+            const Bool_t lAtLeastOneTOF = lCascadeResult->GetCutAtLeastOneTOF();
+            UChar_t lRequiredITSRefit = 0;
+            if( lCascadeResult->GetCutUseITSRefitNegative() ) lRequiredITSRefit |= CascadeCandidates::kNegITSRefit;
+            if( lCascadeResult->GetCutUseITSRefitPositive() ) lRequiredITSRefit |= CascadeCandidates::kPosITSRefit;
+            if( lCascadeResult->GetCutUseITSRefitBachelor() ) lRequiredITSRefit |= CascadeCandidates::kBachITSRefit;
+            const Int_t lIsCowboy = lCascadeResult->GetCutIsCowboy();
+            const Int_t lIsCascadeCowboy = lCascadeResult->GetCutIsCascadeCowboy();
+            const Double_t lMinCrossedRowsOverLengthCut = lCascadeResult->GetCutMinCrossedRowsOverLength();
+            const Double_t lLeastNbrCrossedRowsCut = lCascadeResult->GetCutLeastNumberOfCrossedRows();
+            const Bool_t lITSorTOF = lCascadeResult->GetCutITSorTOF();
+            
+            for(UInt_t icand=0; icand<fGroupCandidates.size(); icand++){
+                const Int_t i = fGroupCandidates[icand];
+                const UChar_t lFlags = c.fFlags[i];
+                const Float_t lPt = c.fPt[i];
+                
+                //Check 3: Topological Variables
+                // - V0 Selections
+                if( !(c.fDCANegToPV[i] > lDCANegToPVCut && c.fDCAPosToPV[i] > lDCAPosToPVCut) ) continue;
+                if( !(c.fDCAV0Daughters[i] < lDCAV0DaughtersCut) ) continue;
+                Float_t lV0CosPACut = lV0CosPACutConst;
+                if( lUseVarV0CosPA ){
+                    //Only use if tighter than the non-variable cut
+                    Float_t lVarV0CosPA = TMath::Cos( ExpParametrization(lVarV0CosPApar, lPt) );
+                    if( lVarV0CosPA > lV0CosPACut ) lV0CosPACut = lVarV0CosPA;
+                }
+                if( !(c.fV0CosPA[i] > lV0CosPACut) ) continue;
+                if( !(c.fV0Radius[i] > lV0RadiusCut) ) continue;
+                // - Cascade Selections
+                if( !(c.fDCAV0ToPV[i] > lDCAV0ToPVCut) ) continue;
+                if( !(TMath::Abs(lV0Mass[i]-1.116) < lV0MassCut) ) continue;
+                if( !(c.fDCABachToPV[i] > lDCABachToPVCut) ) continue;
+                Float_t lDCACascDauCut = lDCACascDauCutConst;
+                if( lUseVarDCACascDau ){
+                    //Loosest: default cut, parametric can go tighter
+                    Float_t lVarDCACascDau = ExpParametrization(lVarDCACascDaupar, lPt);
+                    if( lVarDCACascDau < lDCACascDauCut ) lDCACascDauCut = lVarDCACascDau;
+                }
+                if( !(c.fDCACascDaughters[i] < lDCACascDauCut) ) continue;
+                Float_t lCascCosPACut = lCascCosPACutConst;
+                if( lUseVarCascCosPA ){
+                    //Only use if tighter than the non-variable cut
+                    Float_t lVarCascCosPA = TMath::Cos( ExpParametrization(lVarCascCosPApar, lPt) );
+                    if( lVarCascCosPA > lCascCosPACut ) lCascCosPACut = lVarCascCosPA;
+                }
+                if( !(c.fCascCosPA[i] > lCascCosPACut) ) continue;
+                if( !(c.fCascRadius[i] > lCascRadiusCut) ) continue;
+                
+                // - Implementation of a parametric V0 Mass cut if requested
+                if( !(lV0MassSigmaCut > 50 || TMath::Abs( (lV0Mass[i]-c.fExpV0Mass[i]) / c.fExpV0Sigma[i] ) < lV0MassSigmaCut) ) continue;
+                
+                // - Miscellaneous
+                if( !(c.fDistOverTotMom[i]*lPDGMass < lProperLifetimeCut) ) continue;
+                if( !(c.fLeastNbrClusters[i] > lLeastNumberOfClustersCut) ) continue;
+                
+                //Check 4: TPC dEdx selections
+                if( !(TMath::Abs(lNegdEdx[i])<lTPCdEdxCut && TMath::Abs(lPosdEdx[i])<lTPCdEdxCut && TMath::Abs(lBachdEdx[i])<lTPCdEdxCut) ) continue;
+                
+                //Check 4bis: TOF selections (experimental)
+                if( lUseTOFUnchecked && !(TMath::Abs(lNegTOFsigma[i])<4 && TMath::Abs(lPosTOFsigma[i])<4 && TMath::Abs(lBachTOFsigma[i])<4) ) continue;
+                
+                //Check 5: Xi rejection for Omega analysis
+                if( lIsOmega && !(TMath::Abs( c.fMassAsXi[i] - 1.32171 ) > lXiRejectionCut) ) continue;
+                
+                //Check 6: Experimental DCA Bachelor to Baryon cut
+                if( !(c.fDCABachToBaryon[i] > lDCABachToBaryonCut) ) continue;
+                
+                //Check 7: Experimental Bach Baryon CosPA
+                Float_t lBBCosPACut = lBBCosPACutConst;
+                if( lUseVarBBCosPA ){
+                    //Only use if looser than the non-variable cut (WARNING: BEWARE INVERSE LOGIC)
+                    Float_t lVarBBCosPA = TMath::Cos( ExpParametrization(lVarBBCosPApar, lPt) );
+                    if( lVarBBCosPA > lBBCosPACut ) lBBCosPACut = lVarBBCosPA;
+                }
+                if( !(c.fWrongCosPA[i] < lBBCosPACut) ) continue;
+                
+                //Check 8: Min/Max V0 Lifetime cut
+                if( !(c.fV0Lifetime[i] > lMinV0LifetimeCut && (c.fV0Lifetime[i] < lMaxV0LifetimeCut || lMaxV0LifetimeCut > 1e+3)) ) continue;
+                
+                //Check 9: kITSrefit track selection if requested
+                if( lUseITSRefitTracks && (lFlags & lAllITSRefit) != lAllITSRefit ) continue;
+                
+                //Check 10: Max Chi2/Clusters if not absurd
+                if( !(lMaxChi2PerClusterCut>1e+3 || c.fMaxChi2PerCluster[i] < lMaxChi2PerClusterCut) ) continue;
+                
+                //Check 11: Min Track Length if positive, [min - (1/pt)^1.5] if parametric requested
+                if( !( lMinTrackLengthCut<0 ||
+                      (c.fMinTrackLength[i] > lMinTrackLengthCut && !lUseParametricLength) ||
+                      (c.fMinTrackLength[i] > lMinTrackLengthCut - c.fLengthPtTerm[i] - c.fLengthRadiusTerm[i] && lUseParametricLength) ) ) continue;
+                
+                //Check 12: Check if special V0 CosPA cut used
+                if( lUse276TeVV0CosPA && !(c.fV0CosPA[i] > c.f276TeVV0CosPA[i]) ) continue;
+                
+                //Check 13: 3D Cascade DCA to PV
+                if( !(lDCACascadeToPVCut > 999 || c.fDCACascadeToPV[i] < lDCACascadeToPVCut) ) continue;
+                
+                //Check 14: has at least one track with some TOF info
+                if( lAtLeastOneTOF && !(lFlags & CascadeCandidates::kAtLeastOneTOF) ) continue;
+                
+                //Check 15: check each prong for ITS refit
+                if( (lFlags & lRequiredITSRefit) != lRequiredITSRefit ) continue;
+                
+                //Check 16: cowboy/sailor for V0
+                const Bool_t lCowboy = (lFlags & CascadeCandidates::kCowboy) != 0;
+                if( lIsCowboy != 0 && !( (lIsCowboy==1 && lCowboy) || (lIsCowboy==-1 && !lCowboy) ) ) continue;
+                
+                //Check 17: cowboy/sailor for cascade
+                const Bool_t lCascadeCowboy = (lFlags & CascadeCandidates::kCascadeCowboy) != 0;
+                if( lIsCascadeCowboy != 0 && !( (lIsCascadeCowboy==1 && lCascadeCowboy) || (lIsCascadeCowboy==-1 && !lCascadeCowboy) ) ) continue;
+                
+                //Check 18 and 19: modern track quality selections
+                if( !(lMinCrossedRowsOverLengthCut<0 || c.fLeastNcrOverLength[i]>lMinCrossedRowsOverLengthCut) ) continue;
+                if( !(lLeastNbrCrossedRowsCut<0 || c.fLeastNbrCrossedRows[i]>lLeastNbrCrossedRowsCut) ) continue;
+                
+                //Check 20: ITS or TOF required
+                if( lITSorTOF && !(lFlags & CascadeCandidates::kITSorTOF) ) continue;
+                
+                //This satisfies all my conditionals! Fill histogram
+                histoout -> Fill ( fCentrality, lPt, lMass[i] );
+            }
+        }
+    }
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskStrangenessVsMultiplicityRun2::AddConfiguration( AliV0Result *lV0Result )
 {
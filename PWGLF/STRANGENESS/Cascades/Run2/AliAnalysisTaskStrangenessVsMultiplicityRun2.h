@@ -48,6 +48,7 @@ class AliExternalTrackParam;
 
 //#include "TString.h"
 //#include "AliESDtrackCuts.h"
+#include <vector>
 #include "AliAnalysisTaskSE.h"
 #include "AliEventCuts.h"
 
@@ -228,9 +229,22 @@ public:
         fkConfigToSave = lConfig;
         fkSaveSpecificConfig = kTRUE; 
     }
+    void SetUseColumnarSelection ( Bool_t lOpt = kTRUE ) {
+        //Superlight mode: buffer the candidates of an event and evaluate all configurations
+        //in one pass after the candidate loop (default). If false, every candidate goes
+        //through the configuration lists inside the candidate loop
+        fkUseColumnarSelection = lOpt;
+    }
 //---------------------------------------------------------------------------------------
     
 private:
+    //Superlight mode: columnar candidate buffers
+    void AddV0Candidate( Int_t lOnFlyStatus, Float_t lPosInnerPt, Float_t lNegInnerPt, Float_t lLeastNcrOverLength, Bool_t lITSorTOFsatisfied );
+    void AddCascadeCandidate( UChar_t lValidHypotheses, Float_t lV0Pt, Float_t lV0TotMomentum, Float_t lLeastNcrOverLength, Int_t lLeastNbrCrossedRows, Bool_t lITSorTOFsatisfied );
+    void BuildSelectionGroups();
+    void SelectV0Candidates();
+    void SelectCascadeCandidates();
+    
     // Note : In ROOT, "//!" means "do not stream the data from Master node to Worker node" ...
     // your data member object is created on the worker nodes and streaming is not needed.
     // http://root.cern.ch/download/doc/11InputOutput.pdf, page 14
@@ -305,6 +319,9 @@ private:
     Bool_t fkSaveSpecificConfig;
     TString fkConfigToSave; 
     
+    //if true, select buffered candidates for all configurations after the candidate loops
+    Bool_t fkUseColumnarSelection;
+    
 //===========================================================================================
 //   Variables for Event Tree
 //===========================================================================================
@@ -655,10 +672,56 @@ private:
     TH1D *fHistEventCounterDifferential; //!
     TH1D *fHistCentrality; //!
 
+//===========================================================================================
+//   Superlight mode: candidate buffers and configurations grouped by shared cuts
+//===========================================================================================
+    //V0 candidates of the current event, one column per variable
+    struct V0Candidates {
+        enum EFlags { kOnFly = 1<<0, kITSRefit = 1<<1, kAtLeastOneTOF = 1<<2, kCowboy = 1<<3, kITSorTOF = 1<<4 };
+        std::vector<Float_t> fPt, fNegEta, fPosEta;
+        std::vector<Float_t> fInvMassK0s, fInvMassLambda, fInvMassAntiLambda, fRapK0Short, fRapLambda;
+        std::vector<Float_t> fV0Radius, fDcaNegToPV, fDcaPosToPV, fDcaV0Daughters, fV0CosPA, fDistOverTotMom;
+        std::vector<Float_t> fLeastNbrCrossedRows, fLeastRatioCrossedRowsOverFindable, fLeastNcrOverLength;
+        std::vector<Float_t> fNegNSigmaPion, fNegNSigmaProton, fPosNSigmaPion, fPosNSigmaProton;
+        std::vector<Float_t> fNegInnerP, fPosInnerP, fNegInnerPt, fPosInnerPt;
+        std::vector<Float_t> fPtArmV0, fAlphaV0, fMaxChi2PerCluster, fMinTrackLength;
+        std::vector<Double_t> fLengthPtTerm, fLengthRadiusTerm; //parametric track length cut
+        std::vector<UChar_t> fFlags;
+        void Clear();
+    };
+    //cascade candidates of the current event, one column per variable
+    struct CascadeCandidates {
+        enum EFlags { kNegITSRefit = 1<<0, kPosITSRefit = 1<<1, kBachITSRefit = 1<<2, kAtLeastOneTOF = 1<<3,
+            kCowboy = 1<<4, kCascadeCowboy = 1<<5, kITSorTOF = 1<<6 };
+        std::vector<Int_t> fCharge;
+        std::vector<Float_t> fPt, fNegEta, fPosEta, fBachEta;
+        std::vector<Float_t> fMassAsXi, fMassAsOmega, fV0MassLambda, fV0MassAntiLambda, fRapXi, fRapOmega;
+        std::vector<Float_t> fDCANegToPV, fDCAPosToPV, fDCAV0Daughters, fV0CosPA, fV0Radius, fDCAV0ToPV;
+        std::vector<Float_t> fDCABachToPV, fDCACascDaughters, fCascCosPA, fCascRadius, fExpV0Mass, fExpV0Sigma;
+        std::vector<Float_t> fDistOverTotMom, fLeastNbrClusters, fDCABachToBaryon, fWrongCosPA, fV0Lifetime;
+        std::vector<Float_t> fMaxChi2PerCluster, fMinTrackLength, f276TeVV0CosPA, fLeastNcrOverLength, fLeastNbrCrossedRows;
+        std::vector<Float_t> fNegNSigmaPion, fNegNSigmaProton, fPosNSigmaPion, fPosNSigmaProton, fBachNSigmaPion, fBachNSigmaKaon;
+        std::vector<Float_t> fNegTOFNSigmaPion, fNegTOFNSigmaProton, fPosTOFNSigmaPion, fPosTOFNSigmaProton, fBachTOFNSigmaPion, fBachTOFNSigmaKaon;
+        std::vector<Double_t> fLengthPtTerm, fLengthRadiusTerm, fDCACascadeToPV;
+        std::vector<UChar_t> fFlags;
+        std::vector<UChar_t> fValidHypotheses; //bit i set: valid as AliCascadeResult::EMassHypo i
+        void Clear();
+    };
+    V0Candidates fV0Candidates; //!
+    CascadeCandidates fCascadeCandidates; //!
+    
+    //configurations sorted such that configurations sharing hypothesis and acceptance cuts
+    //are consecutive; the shared cuts are evaluated once per group and candidate
+    std::vector<AliV0Result*> fV0Selections; //!
+    std::vector<Int_t> fV0SelectionGroups; //! first configuration of each group, last entry: number of configurations
+    std::vector<AliCascadeResult*> fCascadeSelections; //!
+    std::vector<Int_t> fCascadeSelectionGroups; //! first configuration of each group, last entry: number of configurations
+    std::vector<Int_t> fGroupCandidates; //! candidates passing the shared cuts of the current group
+
     AliAnalysisTaskStrangenessVsMultiplicityRun2(const AliAnalysisTaskStrangenessVsMultiplicityRun2&);            // not implemented
     AliAnalysisTaskStrangenessVsMultiplicityRun2& operator=(const AliAnalysisTaskStrangenessVsMultiplicityRun2&); // not implemented
 
-    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 4);
+    ClassDef(AliAnalysisTaskStrangenessVsMultiplicityRun2, 5);
     //1: first implementation
 };
 
@@ -94,6 +94,7 @@ class AliAODv0;
 #include <TChain.h>
 #include <TGeoGlobalMagField.h>
 #include "TGeoManager.h"
+#include <TROOT.h>
 #include <TRegexp.h>
 
 #include "AliGeomManager.h"
@@ -102,6 +103,9 @@ class AliAODv0;
 #include "AliESDInputHandler.h"
 #include "AliLog.h"
 #include "AliTrackerBase.h"
+#include "TDatabasePDG.h"
+
+#include <thread>
 
 using std::cout;
 using std::endl;
@@ -146,6 +150,8 @@ fkDoCascadeRefit( kFALSE ) ,
 fMaxIterationsWhenMinimizing(27),
 fkPreselectX(kTRUE),
 fkSkipLargeXYDCA(kTRUE),
+fkUseFlatV0Finding(kFALSE),
+fNThreadsV0Finding(1),
 fkMonteCarlo(kFALSE),
 fkUseOptimalTrackParams(kFALSE),
 fkUseOptimalTrackParamsBachelor(kFALSE),
@@ -207,6 +213,8 @@ fkDoCascadeRefit( kFALSE ) ,
 fMaxIterationsWhenMinimizing(27),
 fkPreselectX(kTRUE),
 fkSkipLargeXYDCA(kTRUE),
+fkUseFlatV0Finding(kFALSE),
+fNThreadsV0Finding(1),
 fkMonteCarlo(kFALSE), 
 fkUseOptimalTrackParams(kFALSE),
 fkUseOptimalTrackParamsBachelor(kFALSE),
@@ -274,6 +282,9 @@ void AliAnalysisTaskWeakDecayVertexer::UserCreateOutputObjects()
     AliAnalysisManager *man=AliAnalysisManager::GetAnalysisManager();
     AliInputEventHandler* inputHandler = (AliInputEventHandler*) (man->GetInputEventHandler());
     fPIDResponse = inputHandler->GetPIDResponse();
+    
+    //Threaded pair fits of the flat V0 finding: switch on the thread safety of ROOT once here
+    if( fkUseFlatV0Finding && fNThreadsV0Finding > 1 ) ROOT::EnableThreadSafety();
     inputHandler->SetNeedField();
     
     //------------------------------------------------
@@ -633,6 +644,8 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
             }
         }//finished preparing map
     }
+    
+    if (fkUseFlatV0Finding) return Tracks2V0verticesFlat(event);
      
     const AliESDVertex *vtxT3D=event->GetPrimaryVertex();
     
@@ -813,6 +826,278 @@ Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0vertices(AliESDEvent *event) {
     return nvtx;
 }
 
+//________________________________________________________________________
+Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0verticesFlat(AliESDEvent *event) {
+    //--------------------------------------------------------------------
+    //Same V0 finding as Tracks2V0vertices (same candidates, same order),
+    //organised for large events:
+    // - daughter candidates passing the DCA to PV selection are copied
+    //   once into flat arrays, together with their helix circle in XY
+    // - the far-away / inside circle test of GetDCAV0Dau is done for all
+    //   pairs on these arrays, before any track object is touched
+    // - the surviving pairs are fitted on fNThreadsV0Finding threads; the
+    //   histograms are filled and the V0s are added in pair order here,
+    //   so that the output does not depend on the number of threads
+    //Called from Tracks2V0vertices once the OTF map is populated
+    //--------------------------------------------------------------------
+    
+    const AliESDVertex *vtxT3D=event->GetPrimaryVertex();
+    
+    Double_t xPrimaryVertex=vtxT3D->GetX();
+    Double_t yPrimaryVertex=vtxT3D->GetY();
+    
+    Long_t nentr=event->GetNumberOfTracks();
+    Double_t b=event->GetMagneticField();
+    
+    if (nentr<2) return 0;
+    
+    V0Daughters neg, pos;
+    for (Long_t i=0; i<nentr; i++) {
+        AliESDtrack *esdTrack=event->GetTrack(i);
+        ULong_t status=esdTrack->GetStatus();
+        
+        if ((status&AliESDtrack::kTPCrefit)==0) continue;
+        
+        //Track pre-selection: clusters
+        Float_t lThisTrackLength = -1;
+        if (esdTrack->GetInnerParam()) lThisTrackLength = esdTrack->GetLengthInActiveZone(1, 2.0, 220.0, b);
+        if (esdTrack->GetTPCNcls() < 70 && lThisTrackLength<80 &&fkExtraCleanup ) continue;
+        
+        Double_t d=esdTrack->GetD(xPrimaryVertex,yPrimaryVertex,b);
+        
+        if (esdTrack->GetSign() < 0. && TMath::Abs(d)>fV0VertexerSels[1]) AddV0Daughter(neg, esdTrack, i, vtxT3D, b);
+        if (esdTrack->GetSign() > 0. && TMath::Abs(d)>fV0VertexerSels[2]) AddV0Daughter(pos, esdTrack, i, vtxT3D, b);
+    }
+    
+    //Pair preselection: identical to the fast skipper in GetDCAV0Dau,
+    //which would return a DCA of 2000 for the rejected pairs. Pairs which
+    //get on-the-fly parameters are always fitted (different circles)
+    const Long_t nneg = neg.fIndex.size(), npos = pos.fIndex.size();
+    const Bool_t lPreselectXY = fkDoImprovedDCAV0DauPropagation && fkSkipLargeXYDCA;
+    const Double_t lMargin = 2*fV0VertexerSels[3];
+    const Double_t *xPosCenter = pos.fCenterX.data();
+    const Double_t *yPosCenter = pos.fCenterY.data();
+    const Double_t *PosRadius = pos.fRadius.data();
+    std::vector<Char_t> lClose(npos, 1);
+    std::vector<Int_t> lFitNeg, lFitPos;
+    Long_t nOTFNotAvailable = 0;
+    for (Long_t i=0; i<nneg; i++) {
+        if( lPreselectXY ){
+            const Double_t xNegCenter = neg.fCenterX[i];
+            const Double_t yNegCenter = neg.fCenterY[i];
+            const Double_t NegRadius = neg.fRadius[i];
+            for (Long_t k=0; k<npos; k++) {
+                Double_t lDist = TMath::Sqrt(
+                                             TMath::Power( xNegCenter - xPosCenter[k] , 2) +
+                                             TMath::Power( yNegCenter - yPosCenter[k] , 2)
+                                             );
+                lClose[k] = !( lDist > NegRadius + PosRadius[k] + lMargin ) &
+                            !( lDist < TMath::Abs(NegRadius - PosRadius[k]) - lMargin );
+            }
+        }
+        for (Long_t k=0; k<npos; k++) {
+            if( !lClose[k] ){
+                if( !fkUseOptimalTrackParams ) continue;
+                if( fOTFMap.find(make_pair(neg.fIndex[i],pos.fIndex[k])) == fOTFMap.end() ){
+                    nOTFNotAvailable++;
+                    continue;
+                }
+            }
+            lFitNeg.push_back(i);
+            lFitPos.push_back(k);
+        }
+    }
+    
+    const Long_t nPairs = nneg*npos;
+    if( nPairs > 0 ){
+        fHistV0Statistics->Fill(0.5, nPairs); //number of considered pairs
+        fHistV0Statistics->Fill(1.5, nPairs); //pass distance to PV
+    }
+    if( nOTFNotAvailable > 0 ) fHistV0OptimalTrackParamUse->Fill(0.5, nOTFNotAvailable);
+    
+    //Pair fits: contiguous ranges of pairs per thread
+    const Long_t nFits = lFitNeg.size();
+    Int_t nThreads = fNThreadsV0Finding;
+    //AliTrackerBase::PropagateTrackTo navigates the geometry: not thread safe
+    if( fkDoMaterialCorrection || nThreads < 1 ) nThreads = 1;
+    if( nThreads > nFits ) nThreads = nFits;
+    std::vector<Char_t> lStage(nFits), lOTFUse(nFits);
+    std::vector< std::vector<AliESDv0> > lAccepted(nThreads);
+    if( nThreads > 1 ){
+        //Load the particle table before the workers need it
+        TDatabasePDG::Instance()->GetParticle(kK0Short);
+        std::vector<std::thread> workers;
+        for (Int_t it=1; it<nThreads; it++)
+            workers.push_back(std::thread(&AliAnalysisTaskWeakDecayVertexer::FitV0Pairs, this, event, &neg, &pos, &lFitNeg, &lFitPos,
+                                          nFits*it/nThreads, nFits*(it+1)/nThreads, &lStage, &lOTFUse, &lAccepted[it]));
+        FitV0Pairs(event, &neg, &pos, &lFitNeg, &lFitPos, 0, nFits/nThreads, &lStage, &lOTFUse, &lAccepted[0]);
+        for (size_t it=0; it<workers.size(); it++) workers[it].join();
+    }else if( nThreads == 1 ){
+        FitV0Pairs(event, &neg, &pos, &lFitNeg, &lFitPos, 0, nFits, &lStage, &lOTFUse, &lAccepted[0]);
+    }
+    
+    for (Long_t ip=0; ip<nFits; ip++) {
+        if( lOTFUse[ip] == 2 ) AliWarning(Form("Invalid on-the-fly V0 for tracks %i, %i!", neg.fIndex[lFitNeg[ip]], pos.fIndex[lFitPos[ip]]));
+        if( lOTFUse[ip] >= 0 ) fHistV0OptimalTrackParamUse->Fill(lOTFUse[ip]+0.5);
+        for (Int_t is=2; is<=lStage[ip]; is++) fHistV0Statistics->Fill(is+0.5);
+    }
+    
+    Long_t nvtx=0;
+    for (Int_t it=0; it<nThreads; it++) {
+        for (size_t iv=0; iv<lAccepted[it].size(); iv++) {
+            event->AddV0(&lAccepted[it][iv]);
+            nvtx++;
+        }
+    }
+    AliWarning(Form("Number of reconstructed V0 vertices: %ld",nvtx));
+    return nvtx;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::AddV0Daughter(V0Daughters &lDaughters, AliESDtrack *lTrack, Int_t lIndex, const AliESDVertex *lVertex, Double_t b) {
+    //Append a V0 daughter candidate to the flat arrays of Tracks2V0verticesFlat
+    AliExternalTrackParam lParam(*lTrack);
+    
+    //Re-propagate to closest position to the primary vertex if asked to do so
+    if (fkResetInitialPositions){
+        Double_t dztemp[2], covartemp[3];
+        lParam.PropagateToDCA( lVertex , b , 250, dztemp, covartemp );
+    }
+    
+    Double_t lHelix[6], lCenter[2];
+    lParam.GetHelixParameters(lHelix,b);
+    GetHelixCenter( &lParam, lCenter, b );
+    
+    lDaughters.fIndex.push_back(lIndex);
+    lDaughters.fParam.push_back(lParam);
+    lDaughters.fMass.push_back(lTrack->GetMassForTracking());
+    lDaughters.fCenterX.push_back(lCenter[0]);
+    lDaughters.fCenterY.push_back(lCenter[1]);
+    lDaughters.fRadius.push_back(TMath::Abs(1./lHelix[4]));
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskWeakDecayVertexer::FitV0Pairs(AliESDEvent *event, const V0Daughters *lNeg, const V0Daughters *lPos,
+                                                  const std::vector<Int_t> *lFitNeg, const std::vector<Int_t> *lFitPos, Long_t lFirst, Long_t lLast,
+                                                  std::vector<Char_t> *lStage, std::vector<Char_t> *lOTFUse, std::vector<AliESDv0> *lAccepted) {
+    //--------------------------------------------------------------------
+    //Fits pairs [lFirst, lLast) of Tracks2V0verticesFlat with the same steps
+    //as the pair loop of Tracks2V0vertices. Instead of filling histograms,
+    //the last fHistV0Statistics stage reached and the fHistV0OptimalTrackParamUse
+    //bin are stored per pair, accepted V0s are appended to lAccepted:
+    //nothing shared is written, this can run on several threads
+    //--------------------------------------------------------------------
+    const AliESDVertex *vtxT3D=event->GetPrimaryVertex();
+    
+    Double_t xPrimaryVertex=vtxT3D->GetX();
+    Double_t yPrimaryVertex=vtxT3D->GetY();
+    Double_t zPrimaryVertex=vtxT3D->GetZ();
+    
+    Double_t b=event->GetMagneticField();
+    
+    for (Long_t ip=lFirst; ip<lLast; ip++) {
+        Int_t i = (*lFitNeg)[ip], k = (*lFitPos)[ip];
+        Int_t nidx = lNeg->fIndex[i], pidx = lPos->fIndex[k];
+        
+        (*lStage)[ip] = 1;
+        (*lOTFUse)[ip] = -1;
+        
+        Double_t lNegMassForTracking = lNeg->fMass[i];
+        Double_t lPosMassForTracking = lPos->fMass[k];
+        
+        //Already re-propagated to the primary vertex if requested
+        AliExternalTrackParam nt(lNeg->fParam[i]), pt(lPos->fParam[k]);
+        Bool_t lUsedOptimalParams = kFALSE;
+        
+        if( fkUseOptimalTrackParams ){
+            map<pair<int,int>, int>::const_iterator iter = fOTFMap.find(make_pair(nidx,pidx));
+            if(iter != fOTFMap.end())
+            {
+                AliESDv0 *v0_otf = event->GetV0((*iter).second);
+                if(!v0_otf){
+                    (*lOTFUse)[ip] = 2; //warning issued by the caller
+                }else{
+                    AliExternalTrackParam ptimproved(*(v0_otf->GetParamP()));
+                    AliExternalTrackParam ntimproved(*(v0_otf->GetParamN()));
+                    if( v0_otf->GetParamP()->Charge() > 0 && v0_otf->GetParamN()->Charge() < 0 ) {
+                        pt = ptimproved;
+                        nt = ntimproved;
+                    }else{
+                        //swap charges if charges are swapped
+                        pt = ntimproved;
+                        nt = ptimproved;
+                    }
+                    if (fkResetInitialPositions){
+                        Double_t dztemp[2], covartemp[3];
+                        nt.PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
+                        pt.PropagateToDCA( vtxT3D , b , 250, dztemp, covartemp );
+                    }
+                    (*lOTFUse)[ip] = 1;
+                    lUsedOptimalParams=kTRUE;
+                }
+            }else{
+                //OTF not available for this pair
+                (*lOTFUse)[ip] = 0;
+            }
+        }
+        AliExternalTrackParam *ntp=&nt, *ptp=&pt;
+        Double_t xn, xp, dca;
+        
+        if( fkDoImprovedDCAV0DauPropagation ){
+            dca=GetDCAV0Dau(ptp, ntp, xp, xn, b, lNegMassForTracking, lPosMassForTracking);
+        }else{
+            dca=nt.GetDCA(&pt,b,xn,xp);
+        }
+        
+        if (dca > fV0VertexerSels[3]) continue;
+        (*lStage)[ip] = 2; //pass dca
+        
+        if ((xn+xp) > 2*fV0VertexerSels[6] && fkPreselectX) continue;
+        if ((xn+xp) < 2*fV0VertexerSels[5] && fkPreselectX) continue;
+        (*lStage)[ip] = 3; //pass X within R2D cut
+        
+        if(!fkDoMaterialCorrection){
+            nt.PropagateTo(xn,b);
+            pt.PropagateTo(xp,b);
+        }else{
+            AliTrackerBase::PropagateTrackTo(ntp, xn, lNegMassForTracking, 3, kFALSE, 0.75, kFALSE, kTRUE );
+            AliTrackerBase::PropagateTrackTo(ptp, xp, lPosMassForTracking, 3, kFALSE, 0.75, kFALSE, kTRUE );
+        }
+        
+        //select maximum eta range (after propagation)
+        if (TMath::Abs(nt.Eta())>0.8&&fkExtraCleanup) continue;
+        if (TMath::Abs(pt.Eta())>0.8&&fkExtraCleanup) continue;
+        (*lStage)[ip] = 4; //pass eta cut
+        
+        AliESDv0 vertex(nt,nidx,pt,pidx);
+        if( fkDoV0Refit ) vertex.Refit();
+        
+        Double_t x=vertex.Xv(), y=vertex.Yv();
+        Double_t r2=x*x + y*y;
+        if (r2 < fV0VertexerSels[5]*fV0VertexerSels[5]) continue;
+        if (r2 > fV0VertexerSels[6]*fV0VertexerSels[6]) continue;
+        (*lStage)[ip] = 5; //pass radius cut
+        
+        Float_t cpa=vertex.GetV0CosineOfPointingAngle(xPrimaryVertex,yPrimaryVertex,zPrimaryVertex);
+        if (cpa < fV0VertexerSels[4]) continue;
+        (*lStage)[ip] = 6; //pass cosPA
+        
+        vertex.SetDcaV0Daughters(dca);
+        vertex.SetV0CosineOfPointingAngle(cpa);
+        vertex.ChangeMassHypothesis(kK0Short);
+        
+        //pre-select on pT
+        Double_t lMomX       = 0. , lMomY = 0., lMomZ = 0.;
+        vertex.GetPxPyPz( lMomX, lMomY, lMomZ );
+        Double_t lTransvMom = TMath::Sqrt( lMomX*lMomX   + lMomY*lMomY );
+        if(lTransvMom<fMinPtV0) continue;
+        if(lTransvMom>fMaxPtV0) continue;
+        (*lStage)[ip] = lUsedOptimalParams ? 8 : 7; //within pT range (, used OTF params)
+        
+        lAccepted->push_back(vertex);
+    }
+}
+
 
 //________________________________________________________________________
 Long_t AliAnalysisTaskWeakDecayVertexer::Tracks2V0verticesMC(AliESDEvent *event) {
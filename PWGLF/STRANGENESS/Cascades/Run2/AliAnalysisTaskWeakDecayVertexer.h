@@ -33,11 +33,16 @@ class TH1F;
 
 class AliESDpid;
 class AliESDEvent;
+class AliESDtrack;
+class AliESDv0;
+class AliESDVertex;
 class AliPhysicsSelection;
 
 #include "AliEventCuts.h"
+#include "AliExternalTrackParam.h"
 //For mapping functionality
 #include <map>
+#include <vector>
 
 using namespace std;
 
@@ -227,6 +232,14 @@ public:
     void SetSkipLargeXYDCA( Bool_t lOpt = kTRUE) {
         fkSkipLargeXYDCA=lOpt;
     }
+    void SetUseFlatV0Finding( Bool_t lOpt = kTRUE) {
+        //Same V0s as the default finding, see Tracks2V0verticesFlat
+        fkUseFlatV0Finding=lOpt;
+    }
+    void SetNThreadsV0Finding( Int_t lNThreads ) {
+        //Threads for the pair fits of the flat V0 finding
+        fNThreadsV0Finding=lNThreads;
+    }
     void SetUseMonteCarloAssociation( Bool_t lOpt = kTRUE) {
         fkMonteCarlo=lOpt;
     }
@@ -262,6 +275,8 @@ public:
 //---------------------------------------------------------------------------------------
     //Re-vertex V0s
     Long_t Tracks2V0vertices(AliESDEvent *event);
+    //Re-vertex V0s from flat daughter arrays, pair fits on several threads
+    Long_t Tracks2V0verticesFlat(AliESDEvent *event);
 
     //======================================================================
     //Re-vertex V0s based solely on perfect MC V0s
@@ -309,6 +324,20 @@ public:
     
 
 private:
+    //V0 daughter candidates of Tracks2V0verticesFlat, one entry per track
+    struct V0Daughters {
+        std::vector<Int_t> fIndex;                   //ESD track index
+        std::vector<AliExternalTrackParam> fParam;   //parameters the pair fits start from
+        std::vector<Double_t> fMass;                 //mass for tracking
+        std::vector<Double_t> fCenterX;              //helix center in XY
+        std::vector<Double_t> fCenterY;              //helix center in XY
+        std::vector<Double_t> fRadius;               //helix radius in XY
+    };
+    void AddV0Daughter(V0Daughters &lDaughters, AliESDtrack *lTrack, Int_t lIndex, const AliESDVertex *lVertex, Double_t b);
+    void FitV0Pairs(AliESDEvent *event, const V0Daughters *lNeg, const V0Daughters *lPos,
+                    const std::vector<Int_t> *lFitNeg, const std::vector<Int_t> *lFitPos, Long_t lFirst, Long_t lLast,
+                    std::vector<Char_t> *lStage, std::vector<Char_t> *lOTFUse, std::vector<AliESDv0> *lAccepted);
+
     // Note : In ROOT, "//!" means "do not stream the data from Master node to Worker node" ...
     // your data member object is created on the worker nodes and streaming is not needed.
     // http://root.cern.ch/download/doc/11InputOutput.pdf, page 14
@@ -353,6 +382,8 @@ private:
     Long_t fMaxIterationsWhenMinimizing;
     Bool_t fkPreselectX;
     Bool_t fkSkipLargeXYDCA;
+    Bool_t fkUseFlatV0Finding; //if true, re-vertex V0s with Tracks2V0verticesFlat
+    Int_t fNThreadsV0Finding; //number of threads for the pair fits in Tracks2V0verticesFlat
     
     //Master MC switch
     Bool_t fkMonteCarlo; //do MC association in vertexing
@@ -397,8 +428,9 @@ private:
     AliAnalysisTaskWeakDecayVertexer(const AliAnalysisTaskWeakDecayVertexer&);            // not implemented
     AliAnalysisTaskWeakDecayVertexer& operator=(const AliAnalysisTaskWeakDecayVertexer&); // not implemented
 
-    ClassDef(AliAnalysisTaskWeakDecayVertexer, 1);
+    ClassDef(AliAnalysisTaskWeakDecayVertexer, 2);
     //1: first implementation
+    //2: flat V0 finding with threaded pair fits
 };
 
 #endif